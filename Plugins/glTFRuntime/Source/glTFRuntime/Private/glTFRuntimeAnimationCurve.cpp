@@ -2,107 +2,238 @@
 
 
 #include "glTFRuntimeAnimationCurve.h"
+#include "Algo/BinarySearch.h"
+
+namespace glTFRuntime
+{
+	// returns the last key with a time <= InTime (INDEX_NONE if InTime is before the first key)
+	int32 FindAnimationCurveKey(const TArray<float>& Times, const float InTime, int32& Cursor)
+	{
+		const int32 NumKeys = Times.Num();
+		int32 Key = FMath::Clamp(Cursor, 0, NumKeys - 1);
+
+		// coherent sampling generally stays on the same key or moves to the next one
+		if (Times[Key] <= InTime)
+		{
+			if (Key + 1 < NumKeys && Times[Key + 1] <= InTime)
+			{
+				Key++;
+				if (Key + 1 < NumKeys && Times[Key + 1] <= InTime)
+				{
+					Key = Algo::UpperBound(Times, InTime) - 1;
+				}
+			}
+		}
+		else
+		{
+			Key = Algo::UpperBound(Times, InTime) - 1;
+		}
+
+		Cursor = FMath::Max(Key, 0);
+		return Key;
+	}
+
+	template<typename T, typename InterpolatorType>
+	T EvaluateAnimationCurveKeys(const TArray<float>& Times, const TArray<T>& Values, const bool bStepped, const float InTime, int32& Cursor, InterpolatorType Interpolator)
+	{
+		const int32 Key = FindAnimationCurveKey(Times, InTime, Cursor);
+		if (Key < 0)
+		{
+			return Values[0];
+		}
+
+		if (bStepped || Key >= Times.Num() - 1)
+		{
+			return Values[Key];
+		}
+
+		const float Alpha = (InTime - Times[Key]) / (Times[Key + 1] - Times[Key]);
+		return Interpolator(Values[Key], Values[Key + 1], Alpha);
+	}
+}
 
 UglTFRuntimeAnimationCurve::UglTFRuntimeAnimationCurve()
 {
 	glTFCurveAnimationIndex = INDEX_NONE;
 	glTFCurveAnimationDuration = 0;
+	bIsStepped = false;
+	bIsLocationStepped = false;
+	bIsScaleStepped = false;
+	DefaultLocation = FVector::ZeroVector;
+	DefaultScale = FVector::OneVector;
+	bPackedCurvesDirty = false;
+	BasisMatrix = FMatrix::Identity;
+	InverseBasisMatrix = FMatrix::Identity;
 }
 
-FTransform UglTFRuntimeAnimationCurve::GetTransformValue(float InTime) const
+void UglTFRuntimeAnimationCurve::SetBasisMatrix(const FMatrix& InBasisMatrix)
 {
-	FVector Location;
-	Location.X = LocationCurves[0].Eval(InTime);
-	Location.Y = LocationCurves[1].Eval(InTime);
-	Location.Z = LocationCurves[2].Eval(InTime);
+	BasisMatrix = InBasisMatrix;
+	InverseBasisMatrix = InBasisMatrix.Inverse();
+}
 
-	FVector Scale;
-	Scale.X = ScaleCurves[0].Eval(InTime);
-	Scale.Y = ScaleCurves[1].Eval(InTime);
-	Scale.Z = ScaleCurves[2].Eval(InTime);
+void UglTFRuntimeAnimationCurve::PostLoad()
+{
+	Super::PostLoad();
 
-	FMatrix Matrix = FScaleMatrix(Scale) * FTranslationMatrix(Location);
-	FTransform Transform = FTransform(BasisMatrix.Inverse() * Matrix * BasisMatrix);
+	InverseBasisMatrix = BasisMatrix.Inverse();
+	RebuildPackedCurves();
+}
+
+void UglTFRuntimeAnimationCurve::PostDuplicate(bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+
+	InverseBasisMatrix = BasisMatrix.Inverse();
+	RebuildPackedCurves();
+}
 
-	if (ConvertedQuaternions.Num() > 0)
+void UglTFRuntimeAnimationCurve::RebuildPackedCurves()
+{
+	if (LocationTimes.Num() > 0 || ScaleTimes.Num() > 0 || RotationTimes.Num() > 0)
 	{
-		if (bIsStepped)
+		return;
+	}
+
+	auto PackCurves = [](const FRichCurve* Curves, const int32 NumCurves, TArray<float>& Times, TArray<TArray<float>>& Values, bool& bStepped) -> bool
 		{
-			for (int32 Index = 0; Index < ConvertedQuaternions.Num(); Index++)
+			const int32 NumKeys = Curves[0].Keys.Num();
+			for (int32 CurveIndex = 1; CurveIndex < NumCurves; CurveIndex++)
 			{
-				if (ConvertedQuaternions[Index].Key >= InTime)
+				if (Curves[CurveIndex].Keys.Num() != NumKeys)
 				{
-					Transform.SetRotation(ConvertedQuaternions[Index].Value);
-					break;
+					return false;
 				}
 			}
-			if (InTime <= ConvertedQuaternions[0].Key)
-			{
-				Transform.SetRotation(ConvertedQuaternions[0].Value);
-			}
-			else
+
+			Values.SetNum(NumKeys);
+			for (int32 KeyIndex = 0; KeyIndex < NumKeys; KeyIndex++)
 			{
-				Transform.SetRotation(ConvertedQuaternions.Last().Value);
-			}
-		}
-		else
-		{
-			// TODO refactor it to reuse the skeletal animations one
-			auto FindBestFrames = [&](const float WantedTime, int32& FirstIndex, int32& SecondIndex) -> float
+				const float Time = Curves[0].Keys[KeyIndex].Time;
+				for (int32 CurveIndex = 0; CurveIndex < NumCurves; CurveIndex++)
 				{
-					SecondIndex = INDEX_NONE;
-					// first search for second (higher value)
-					for (int32 Index = 0; Index < ConvertedQuaternions.Num(); Index++)
+					if (!FMath::IsNearlyEqual(Curves[CurveIndex].Keys[KeyIndex].Time, Time))
 					{
-						float TimeValue = ConvertedQuaternions[Index].Key - ConvertedQuaternions[0].Key;
-						if (FMath::IsNearlyEqual(TimeValue, WantedTime))
-						{
-							FirstIndex = Index;
-							SecondIndex = Index;
-							return 0;
-						}
-						else if (TimeValue > WantedTime)
-						{
-							SecondIndex = Index;
-							break;
-						}
+						return false;
 					}
+					Values[KeyIndex].Add(Curves[CurveIndex].Keys[KeyIndex].Value);
+				}
+				Times.Add(Time);
+			}
 
-					// not found ? use the last value
-					if (SecondIndex == INDEX_NONE)
-					{
-						SecondIndex = ConvertedQuaternions.Num() - 1;
-					}
+			bStepped = NumKeys > 0 && Curves[0].Keys[0].InterpMode == ERichCurveInterpMode::RCIM_Constant;
+			return true;
+		};
 
-					if (SecondIndex == 0)
-					{
-						FirstIndex = 0;
-						return 1.f;
-					}
+	TArray<TArray<float>> Values;
+	if (PackCurves(LocationCurves, 3, LocationTimes, Values, bIsLocationStepped))
+	{
+		for (const TArray<float>& Value : Values)
+		{
+			LocationValues.Add(FVector(Value[0], Value[1], Value[2]));
+		}
+	}
+	else
+	{
+		LocationTimes.Empty();
+		bPackedCurvesDirty = true;
+	}
 
-					FirstIndex = SecondIndex - 1;
+	Values.Empty();
+	if (PackCurves(ScaleCurves, 3, ScaleTimes, Values, bIsScaleStepped))
+	{
+		for (const TArray<float>& Value : Values)
+		{
+			ScaleValues.Add(FVector(Value[0], Value[1], Value[2]));
+		}
+	}
+	else
+	{
+		ScaleTimes.Empty();
+		bPackedCurvesDirty = true;
+	}
 
-					return ((WantedTime + ConvertedQuaternions[0].Key) - ConvertedQuaternions[FirstIndex].Key) / (ConvertedQuaternions[SecondIndex].Key - ConvertedQuaternions[FirstIndex].Key);
-				};
+	Values.Empty();
+	if (PackCurves(QuatCurves, 4, RotationTimes, Values, bIsStepped))
+	{
+		// the curves are in glTF space, while the packed rotations are basis converted (like AddConvertedQuaternion() expects)
+		for (const TArray<float>& Value : Values)
+		{
+			RotationValues.Add(GetConvertedQuaternion(FQuat(Value[0], Value[1], Value[2], Value[3])));
+		}
+	}
+	else
+	{
+		RotationTimes.Empty();
+		bPackedCurvesDirty = true;
+	}
 
-			if (InTime <= ConvertedQuaternions[0].Key)
-			{
-				Transform.SetRotation(ConvertedQuaternions[0].Value);
-			}
-			else if (InTime >= ConvertedQuaternions.Last().Key)
-			{
-				Transform.SetRotation(ConvertedQuaternions.Last().Value);
-			}
-			else
-			{
-				int32 FirstIndex;
-				int32 SecondIndex;
-				const float Alpha = FindBestFrames(InTime, FirstIndex, SecondIndex);
+	// unset defaults are left to the constructor values
+	if (LocationCurves[0].DefaultValue != MAX_flt)
+	{
+		DefaultLocation = FVector(LocationCurves[0].DefaultValue, LocationCurves[1].DefaultValue, LocationCurves[2].DefaultValue);
+	}
 
-				Transform.SetRotation(FQuat::Slerp(ConvertedQuaternions[FirstIndex].Value, ConvertedQuaternions[SecondIndex].Value, Alpha));
-			}
+	if (ScaleCurves[0].DefaultValue != MAX_flt)
+	{
+		DefaultScale = FVector(ScaleCurves[0].DefaultValue, ScaleCurves[1].DefaultValue, ScaleCurves[2].DefaultValue);
+	}
+}
+
+FQuat UglTFRuntimeAnimationCurve::GetConvertedQuaternion(const FQuat& InQuat) const
+{
+	const FMatrix RotationMatrix = InverseBasisMatrix * FQuatRotationMatrix(InQuat) * BasisMatrix;
+	return RotationMatrix.ToQuat().GetNormalized();
+}
+
+FTransform UglTFRuntimeAnimationCurve::GetTransformValue(float InTime) const
+{
+	// random access, the keys are found with a binary search
+	FglTFRuntimeAnimationCurveCursor Cursor;
+	return EvaluateTransform(InTime, Cursor);
+}
+
+FTransform UglTFRuntimeAnimationCurve::GetTransformValueWithCursor(float InTime, FglTFRuntimeAnimationCurveCursor& Cursor) const
+{
+	return EvaluateTransform(InTime, Cursor);
+}
+
+FTransform UglTFRuntimeAnimationCurve::EvaluateTransform(const float InTime, FglTFRuntimeAnimationCurveCursor& Cursor) const
+{
+	auto LerpVector = [](const FVector& A, const FVector& B, const float Alpha) { return FMath::Lerp(A, B, Alpha); };
+
+	FVector Location = DefaultLocation;
+	FVector Scale = DefaultScale;
+
+	if (bPackedCurvesDirty)
+	{
+		Location = FVector(LocationCurves[0].Eval(InTime), LocationCurves[1].Eval(InTime), LocationCurves[2].Eval(InTime));
+		Scale = FVector(ScaleCurves[0].Eval(InTime), ScaleCurves[1].Eval(InTime), ScaleCurves[2].Eval(InTime));
+	}
+	else
+	{
+		if (LocationTimes.Num() > 0)
+		{
+			Location = glTFRuntime::EvaluateAnimationCurveKeys(LocationTimes, LocationValues, bIsLocationStepped, InTime, Cursor.LocationKey, LerpVector);
 		}
 
+		if (ScaleTimes.Num() > 0)
+		{
+			Scale = glTFRuntime::EvaluateAnimationCurveKeys(ScaleTimes, ScaleValues, bIsScaleStepped, InTime, Cursor.ScaleKey, LerpVector);
+		}
+	}
+
+	FMatrix Matrix = FScaleMatrix(Scale) * FTranslationMatrix(Location);
+	FTransform Transform = FTransform(InverseBasisMatrix * Matrix * BasisMatrix);
+
+	// curves built with AddQuatValue() only (or that cannot be packed)
+	if (RotationTimes.Num() == 0 && QuatCurves[0].GetNumKeys() > 0)
+	{
+		Transform.SetRotation(GetConvertedQuaternion(FQuat(QuatCurves[0].Eval(InTime), QuatCurves[1].Eval(InTime), QuatCurves[2].Eval(InTime), QuatCurves[3].Eval(InTime)).GetNormalized()));
+	}
+	else if (RotationTimes.Num() > 0)
+	{
+		Transform.SetRotation(glTFRuntime::EvaluateAnimationCurveKeys(RotationTimes, RotationValues, bIsStepped, InTime, Cursor.RotationKey, [](const FQuat& A, const FQuat& B, const float Alpha) { return FQuat::Slerp(A, B, Alpha); }));
 	}
 
 	return Transform;
@@ -126,6 +257,9 @@ void UglTFRuntimeAnimationCurve::SetDefaultValues(const FVector Location, const
 	ScaleCurves[0].DefaultValue = Scale.X;
 	ScaleCurves[1].DefaultValue = Scale.Y;
 	ScaleCurves[2].DefaultValue = Scale.Z;
+
+	DefaultLocation = Location;
+	DefaultScale = Scale;
 }
 
 static const FName LocationXCurveName(TEXT("Location X"));
@@ -197,6 +331,14 @@ bool UglTFRuntimeAnimationCurve::operator==(const UglTFRuntimeAnimationCurve& Cu
 		(ScaleCurves[2] == Curve.ScaleCurves[2]);
 }
 
+void UglTFRuntimeAnimationCurve::OnCurveChanged(const TArray<FRichCurveEditInfo>& ChangedCurveEditInfos)
+{
+	// the edited components could not share the same times anymore
+	bPackedCurvesDirty = true;
+
+	Super::OnCurveChanged(ChangedCurveEditInfos);
+}
+
 bool UglTFRuntimeAnimationCurve::IsValidCurve(FRichCurveEditInfo CurveInfo)
 {
 	return CurveInfo.CurveToEdit == &LocationCurves[0] ||
@@ -222,6 +364,11 @@ void UglTFRuntimeAnimationCurve::AddLocationValue(const float InTime, const FVec
 	LocationCurves[1].SetKeyInterpMode(LocationKey1, InterpolationMode);
 	FKeyHandle LocationKey2 = LocationCurves[2].AddKey(InTime, InLocation.Z);
 	LocationCurves[2].SetKeyInterpMode(LocationKey2, InterpolationMode);
+
+	const int32 Index = Algo::UpperBound(LocationTimes, InTime);
+	LocationTimes.Insert(InTime, Index);
+	LocationValues.Insert(InLocation, Index);
+	bIsLocationStepped = InterpolationMode == ERichCurveInterpMode::RCIM_Constant;
 }
 
 void UglTFRuntimeAnimationCurve::AddQuatValue(const float InTime, const FQuat InQuat, const ERichCurveInterpMode InterpolationMode)
@@ -238,17 +385,9 @@ void UglTFRuntimeAnimationCurve::AddQuatValue(const float InTime, const FQuat In
 
 void UglTFRuntimeAnimationCurve::AddConvertedQuaternion(const float InTime, const FQuat InQuat, const bool bStep)
 {
-	int32 Index = 0;
-	if (ConvertedQuaternions.Num() == 0 || ConvertedQuaternions.Last().Key < InTime)
-	{
-		Index = ConvertedQuaternions.Num();
-	}
-	else
-	{
-		for (; Index < ConvertedQuaternions.Num() && ConvertedQuaternions[Index].Key < InTime; ++Index);
-	}
-
-	ConvertedQuaternions.Insert(TPair<float, FQuat>{ InTime, InQuat }, Index);
+	const int32 Index = Algo::LowerBound(RotationTimes, InTime);
+	RotationTimes.Insert(InTime, Index);
+	RotationValues.Insert(InQuat, Index);
 
 	bIsStepped = bStep;
 }
@@ -271,4 +410,9 @@ void UglTFRuntimeAnimationCurve::AddScaleValue(const float InTime, const FVector
 	ScaleCurves[1].SetKeyInterpMode(ScaleKey1, InterpolationMode);
 	FKeyHandle ScaleKey2 = ScaleCurves[2].AddKey(InTime, InScale.Z);
 	ScaleCurves[2].SetKeyInterpMode(ScaleKey2, InterpolationMode);
+
+	const int32 Index = Algo::UpperBound(ScaleTimes, InTime);
+	ScaleTimes.Insert(InTime, Index);
+	ScaleValues.Insert(InScale, Index);
+	bIsScaleStepped = InterpolationMode == ERichCurveInterpMode::RCIM_Constant;
 }
@@ -21,204 +21,465 @@
 
 namespace glTFRuntime
 {
-	bool LoadCubeMapMipsFromBlob(TSharedRef<FglTFRuntimeParser> Parser, const FglTFRuntimeImagesConfig& ImagesConfig, const bool bSpherical, TArray<FglTFRuntimeMipMap>& MipsXP, TArray<FglTFRuntimeMipMap>& MipsXN, TArray<FglTFRuntimeMipMap>& MipsYP, TArray<FglTFRuntimeMipMap>& MipsYN, TArray<FglTFRuntimeMipMap>& MipsZP, TArray<FglTFRuntimeMipMap>& MipsZN)
+#if ENGINE_MAJOR_VERSION >= 5
+	using FCubeMapVectorRegister = VectorRegister4Float;
+#else
+	using FCubeMapVectorRegister = VectorRegister;
+#endif
+
+	struct FCubeMapFaceBasis
 	{
-		TArray64<uint8> UncompressedBytes;
-		int32 Width = 0;
-		int32 Height = 0;
-		EPixelFormat PixelFormat;
+		float Start[3];
+		float Right[3];
+		float Up[3];
+		bool bCap;
+		bool bMirrorCap;
+		float AzimuthOffset;
+		float ElevationSign;
+	};
 
-		if (!Parser->LoadImageFromBlob(Parser->GetBlob(), MakeShared<FJsonObject>(), UncompressedBytes, Width, Height, PixelFormat, ImagesConfig))
+	// XP, XN, YP, YN, ZP, ZN
+	static const FCubeMapFaceBasis CubeMapFacesBasis[6] =
+	{
+		{ { 1, -1, -1 }, { 0, 0, 1 }, { 0, 1, 0 }, false, false, 0.75f, 1 },
+		{ { -1, -1, 1 }, { 0, 0, -1 }, { 0, 1, 0 }, false, false, 0.25f, 1 },
+		{ { -1, -1, 1 }, { 1, 0, 0 }, { 0, 0, -1 }, true, false, 0.5f, -1 },
+		{ { -1, 1, -1 }, { 1, 0, 0 }, { 0, 0, 1 }, true, true, 0.5f, 1 },
+		{ { -1, -1, -1 }, { 1, 0, 0 }, { 0, 1, 0 }, false, false, 0.5f, 1 },
+		{ { 1, -1, 1 }, { -1, 0, 0 }, { 0, 1, 0 }, false, false, 0.0f, 1 },
+	};
+
+	// Equirectangular coordinates (normalized to 0-1) of each cubemap texel.
+	// The four side faces share the same values up to a quarter turn of azimuth,
+	// while the two caps share them up to a mirroring, so only three tables are needed.
+	struct FCubeMapDirectionLUT
+	{
+		int32 Resolution = 0;
+		TArray<float> SideU;
+		TArray<float> SideV;
+		TArray<float> CapU;
+		TArray<float> CapV;
+	};
+
+	TSharedRef<const FCubeMapDirectionLUT> GetCubeMapDirectionLUT(const int32 Resolution)
+	{
+		static FCriticalSection LUTLock;
+		static TSharedPtr<const FCubeMapDirectionLUT> LastLUT;
+
+		FScopeLock Lock(&LUTLock);
+
+		if (LastLUT.IsValid() && LastLUT->Resolution == Resolution)
 		{
-			return false;
+			return LastLUT.ToSharedRef();
 		}
 
-		if (Width <= 0 || Height <= 0)
+		SCOPED_NAMED_EVENT(glTFRuntime_GetCubeMapDirectionLUT, FColor::Magenta);
+
+		TSharedRef<FCubeMapDirectionLUT> LUT = MakeShared<FCubeMapDirectionLUT>();
+		LUT->Resolution = Resolution;
+		LUT->SideU.AddUninitialized(Resolution);
+		LUT->SideV.AddUninitialized(Resolution * Resolution);
+		LUT->CapU.AddUninitialized(Resolution * Resolution);
+		LUT->CapV.AddUninitialized(Resolution * Resolution);
+
+		auto GetGridCoordinate = [Resolution](const int32 Pixel)
+			{
+				return -1.0f + (Pixel * 2 + 1) / static_cast<float>(Resolution);
+			};
+
+		for (int32 PixelX = 0; PixelX < Resolution; PixelX++)
 		{
-			return false;
+			LUT->SideU[PixelX] = FMath::Atan(GetGridCoordinate(PixelX)) / (2 * PI);
 		}
 
-		if (bSpherical)
+		ParallelFor(Resolution, [&](const int32 PixelY)
+			{
+				const float GY = GetGridCoordinate(PixelY);
+				for (int32 PixelX = 0; PixelX < Resolution; PixelX++)
+				{
+					const float GX = GetGridCoordinate(PixelX);
+					const int32 Index = PixelY * Resolution + PixelX;
+					LUT->SideV[Index] = FMath::Atan2(GY, FMath::Sqrt(GX * GX + 1)) / PI + 0.5f;
+					LUT->CapU[Index] = FMath::Atan2(GX, GY) / (2 * PI);
+					LUT->CapV[Index] = FMath::Atan2(1.0f, FMath::Sqrt(GX * GX + GY * GY)) / PI;
+				}
+			});
+
+		LastLUT = LUT;
+		return LUT;
+	}
+
+	bool IsCubeMapPixelFormatSupported(const EPixelFormat PixelFormat)
+	{
+		return PixelFormat == EPixelFormat::PF_FloatRGBA || PixelFormat == EPixelFormat::PF_A32B32G32R32F || PixelFormat == EPixelFormat::PF_B8G8R8A8 || PixelFormat == EPixelFormat::PF_R8G8B8A8;
+	}
+
+	void DecodeCubeMapPixels(const uint8* Pixels, const EPixelFormat PixelFormat, const int64 NumPixels, TArray64<FLinearColor>& OutColors)
+	{
+		OutColors.AddUninitialized(NumPixels);
+		ParallelFor(static_cast<int32>(FMath::DivideAndRoundUp<int64>(NumPixels, 4096)), [&](const int32 BlockIndex)
+			{
+				const int64 First = BlockIndex * 4096LL;
+				const int64 Last = FMath::Min<int64>(First + 4096, NumPixels);
+				for (int64 PixelIndex = First; PixelIndex < Last; PixelIndex++)
+				{
+					if (PixelFormat == EPixelFormat::PF_FloatRGBA)
+					{
+						OutColors[PixelIndex] = FLinearColor(reinterpret_cast<const FFloat16Color*>(Pixels)[PixelIndex]);
+					}
+					else if (PixelFormat == EPixelFormat::PF_A32B32G32R32F)
+					{
+						OutColors[PixelIndex] = reinterpret_cast<const FLinearColor*>(Pixels)[PixelIndex];
+					}
+					else if (PixelFormat == EPixelFormat::PF_B8G8R8A8)
+					{
+						OutColors[PixelIndex] = reinterpret_cast<const FColor*>(Pixels)[PixelIndex].ReinterpretAsLinear();
+					}
+					else
+					{
+						const uint8* Color = Pixels + PixelIndex * 4;
+						OutColors[PixelIndex] = FColor(Color[0], Color[1], Color[2], Color[3]).ReinterpretAsLinear();
+					}
+				}
+			});
+	}
+
+	void EncodeCubeMapPixels(const TArray64<FLinearColor>& Colors, const EPixelFormat PixelFormat, TArray64<uint8>& OutPixels)
+	{
+		OutPixels.AddUninitialized(Colors.Num() * GPixelFormats[PixelFormat].BlockBytes);
+		for (int64 PixelIndex = 0; PixelIndex < Colors.Num(); PixelIndex++)
 		{
-			const int32 Resolution = Height;
-#if ENGINE_MAJOR_VERSION >= 5
-			auto GetCubemapFace = [Resolution, Width, Height, PixelFormat](const TArray64<uint8>& Pixels, const FVector3f Start, const FVector3f Right, const FVector3f Up, TArray64<uint8>& OutPixels)
-#else
-			auto GetCubemapFace = [Resolution, Width, Height, PixelFormat](const TArray64<uint8>& Pixels, const FVector Start, const FVector Right, const FVector Up, TArray64<uint8>& OutPixels)
-#endif
+			if (PixelFormat == EPixelFormat::PF_FloatRGBA)
+			{
+				reinterpret_cast<FFloat16Color*>(OutPixels.GetData())[PixelIndex] = FFloat16Color(Colors[PixelIndex]);
+			}
+			else if (PixelFormat == EPixelFormat::PF_A32B32G32R32F)
+			{
+				reinterpret_cast<FLinearColor*>(OutPixels.GetData())[PixelIndex] = Colors[PixelIndex];
+			}
+			else if (PixelFormat == EPixelFormat::PF_B8G8R8A8)
+			{
+				reinterpret_cast<FColor*>(OutPixels.GetData())[PixelIndex] = Colors[PixelIndex].QuantizeRound();
+			}
+			else
+			{
+				const FColor Color = Colors[PixelIndex].QuantizeRound();
+				uint8* Pixel = OutPixels.GetData() + PixelIndex * 4;
+				Pixel[0] = Color.R;
+				Pixel[1] = Color.G;
+				Pixel[2] = Color.B;
+				Pixel[3] = Color.A;
+			}
+		}
+	}
+
+	FORCEINLINE FCubeMapVectorRegister BilinearSampleCubeMapPixels(const FLinearColor* Pixels, const int64 Pitch, const int32 X0, const int32 X1, const int32 Y0, const int32 Y1, const float FX, const float FY)
+	{
+		const FCubeMapVectorRegister Color00 = VectorLoad(&Pixels[Y0 * Pitch + X0].R);
+		const FCubeMapVectorRegister Color10 = VectorLoad(&Pixels[Y0 * Pitch + X1].R);
+		const FCubeMapVectorRegister Color01 = VectorLoad(&Pixels[Y1 * Pitch + X0].R);
+		const FCubeMapVectorRegister Color11 = VectorLoad(&Pixels[Y1 * Pitch + X1].R);
+
+		const FCubeMapVectorRegister AlphaX = VectorSetFloat1(FX);
+		const FCubeMapVectorRegister Top = VectorMultiplyAdd(VectorSubtract(Color10, Color00), AlphaX, Color00);
+		const FCubeMapVectorRegister Bottom = VectorMultiplyAdd(VectorSubtract(Color11, Color01), AlphaX, Color01);
+		return VectorMultiplyAdd(VectorSubtract(Bottom, Top), VectorSetFloat1(FY), Top);
+	}
+
+	// U wraps around, V is clamped at the poles
+	FORCEINLINE FCubeMapVectorRegister SampleEquirectangular(const TArray64<FLinearColor>& Pixels, const int32 Width, const int32 Height, const float U, const float V)
+	{
+		const float X = (U - FMath::FloorToFloat(U)) * Width - 0.5f;
+		const float Y = FMath::Clamp(V * Height - 0.5f, 0.0f, Height - 1.0f);
+		const float FloorX = FMath::FloorToFloat(X);
+		const float FloorY = FMath::FloorToFloat(Y);
+
+		int32 X0 = static_cast<int32>(FloorX);
+		if (X0 < 0)
+		{
+			X0 += Width;
+		}
+		X0 = FMath::Min(X0, Width - 1);
+		const int32 X1 = X0 + 1 < Width ? X0 + 1 : 0;
+		const int32 Y0 = static_cast<int32>(FloorY);
+		const int32 Y1 = FMath::Min(Y0 + 1, Height - 1);
+
+		return BilinearSampleCubeMapPixels(Pixels.GetData(), Width, X0, X1, Y0, Y1, X - FloorX, Y - FloorY);
+	}
+
+	FORCEINLINE FCubeMapVectorRegister SampleCubeMapFace(const TArray64<FLinearColor>& Pixels, const int32 Resolution, const float U, const float V)
+	{
+		const float X = FMath::Clamp(U * Resolution - 0.5f, 0.0f, Resolution - 1.0f);
+		const float Y = FMath::Clamp(V * Resolution - 0.5f, 0.0f, Resolution - 1.0f);
+		const int32 X0 = static_cast<int32>(X);
+		const int32 Y0 = static_cast<int32>(Y);
+
+		return BilinearSampleCubeMapPixels(Pixels.GetData(), Resolution, X0, FMath::Min(X0 + 1, Resolution - 1), Y0, FMath::Min(Y0 + 1, Resolution - 1), X - X0, Y - Y0);
+	}
+
+	FORCEINLINE FVector GetCubeMapTexelDirection(const int32 FaceIndex, const int32 Resolution, const int32 PixelX, const int32 PixelY)
+	{
+		const FCubeMapFaceBasis& Face = CubeMapFacesBasis[FaceIndex];
+		const float U = (PixelX * 2 + 1) / static_cast<float>(Resolution);
+		const float V = (PixelY * 2 + 1) / static_cast<float>(Resolution);
+		return FVector(
+			Face.Start[0] + U * Face.Right[0] + V * Face.Up[0],
+			Face.Start[1] + U * Face.Right[1] + V * Face.Up[1],
+			Face.Start[2] + U * Face.Right[2] + V * Face.Up[2]).GetUnsafeNormal();
+	}
+
+	FORCEINLINE void GetCubeMapFaceFromDirection(const FVector& Direction, int32& OutFaceIndex, float& OutU, float& OutV)
+	{
+		const FVector AbsDirection = Direction.GetAbs();
+		if (AbsDirection.X >= AbsDirection.Y && AbsDirection.X >= AbsDirection.Z)
+		{
+			OutFaceIndex = Direction.X > 0 ? 0 : 1;
+		}
+		else if (AbsDirection.Y >= AbsDirection.Z)
+		{
+			OutFaceIndex = Direction.Y < 0 ? 2 : 3;
+		}
+		else
+		{
+			OutFaceIndex = Direction.Z < 0 ? 4 : 5;
+		}
+
+		const FCubeMapFaceBasis& Face = CubeMapFacesBasis[OutFaceIndex];
+		const FVector Delta = Direction / AbsDirection.GetMax() - FVector(Face.Start[0], Face.Start[1], Face.Start[2]);
+		OutU = static_cast<float>(Delta | FVector(Face.Right[0], Face.Right[1], Face.Right[2])) * 0.5f;
+		OutV = static_cast<float>(Delta | FVector(Face.Up[0], Face.Up[1], Face.Up[2])) * 0.5f;
+	}
+
+	void GenerateCubeMapMips(const FglTFRuntimeImagesConfig& ImagesConfig, const int32 Resolution, TArray<TArray64<FLinearColor>>& Faces, TArray<int32>& MipResolutions)
+	{
+		SCOPED_NAMED_EVENT(glTFRuntime_GenerateCubeMapMips, FColor::Magenta);
+
+		const int32 NumMips = FMath::FloorLog2(Resolution) + 1;
+
+		// box filtered chain, every level depends on the previous one
+		for (int32 MipIndex = 1; MipIndex < NumMips; MipIndex++)
+		{
+			const int32 PreviousResolution = MipResolutions[MipIndex - 1];
+			const int32 MipResolution = FMath::Max(1, PreviousResolution / 2);
+			MipResolutions.Add(MipResolution);
+
+			for (int32 FaceIndex = 0; FaceIndex < 6; FaceIndex++)
+			{
+				TArray64<FLinearColor>& Face = Faces.AddDefaulted_GetRef();
+				Face.AddUninitialized(MipResolution * MipResolution);
+			}
+
+			ParallelFor(6 * MipResolution, [&](const int32 RowIndex)
 				{
-					const int64 Pitch = Resolution * GPixelFormats[PixelFormat].BlockBytes;
-					OutPixels.AddUninitialized(Pitch * Resolution);
+					const int32 FaceIndex = RowIndex / MipResolution;
+					const int32 PixelY = RowIndex % MipResolution;
+					const TArray64<FLinearColor>& Source = Faces[(MipIndex - 1) * 6 + FaceIndex];
+					TArray64<FLinearColor>& Destination = Faces[MipIndex * 6 + FaceIndex];
+
+					const int32 Y0 = PixelY * 2;
+					const int32 Y1 = FMath::Min(Y0 + 1, PreviousResolution - 1);
+					for (int32 PixelX = 0; PixelX < MipResolution; PixelX++)
+					{
+						const int32 X0 = PixelX * 2;
+						const int32 X1 = FMath::Min(X0 + 1, PreviousResolution - 1);
+						const FCubeMapVectorRegister Color = BilinearSampleCubeMapPixels(Source.GetData(), PreviousResolution, X0, X1, Y0, Y1, 0.5f, 0.5f);
+						VectorStore(Color, &Destination[PixelY * MipResolution + PixelX].R);
+					}
+				});
+		}
 
-					ParallelFor(Resolution, [&](const int32 PixelY)
-						{
-							for (int32 PixelX = 0; PixelX < Resolution; PixelX++)
-							{
-								const int64 Offset = PixelY * Pitch + (PixelX * GPixelFormats[PixelFormat].BlockBytes);
-
-								float PX = Start.X + (PixelX * 2 + 0.5) / Resolution * Right.X + (PixelY * 2 + 0.5) / Resolution * Up.X;
-								float PY = Start.Y + (PixelX * 2 + 0.5) / Resolution * Right.Y + (PixelY * 2 + 0.5) / Resolution * Up.Y;
-								float PZ = Start.Z + (PixelX * 2 + 0.5) / Resolution * Right.Z + (PixelY * 2 + 0.5) / Resolution * Up.Z;
-
-								float Azimuth = FMath::Atan2(PX, -PZ) + PI;
-								float Elevation = FMath::Atan(PY / FMath::Sqrt(PX * PX + PZ * PZ)) + PI / 2;
-
-								float X1 = (Azimuth / PI / 2) * Width;
-								float Y1 = (Elevation / PI) * Height;
-
-								float IX;
-								float FX = FMath::Modf(X1 - 0.5, &IX);
-
-								float IY;
-								float FY = FMath::Modf(Y1 - 0.5, &IY);
-
-								int32 X2 = static_cast<int32>(IX);
-								int32 Y2 = static_cast<int32>(IY);
-								int32 X3 = 0;
-								int32 Y3 = 0;
-
-								if (FX < 0)
-								{
-									X3 = Width - 1;
-								}
-								else if (X2 == Width - 1)
-								{
-									X3 = 0;
-								}
-								else
-								{
-									X3 = X2 + 1;
-								}
-
-								if (FY < 0)
-								{
-									Y3 = Height - 1;
-								}
-								else if (Y2 == Height - 1)
-								{
-									Y3 = 0;
-								}
-								else
-								{
-									Y3 = Y2 + 1;
-								}
-
-								FX = FMath::Abs(FX);
-								FY = FMath::Abs(FY);
+		if (!ImagesConfig.bCubeMapMipsGGX || NumMips < 2)
+		{
+			return;
+		}
 
-#if ENGINE_MAJOR_VERSION >= 5
-								if (PixelFormat == EPixelFormat::PF_FloatRGB)
-								{
-									const FFloat16* Colors = reinterpret_cast<const FFloat16*>(Pixels.GetData());
-									const int64 Offset00 = Y2 * (Width * 3) + (X2 * 3);
-									const FVector3f Color00 = FVector3f(Colors[Offset00], Colors[Offset00 + 1], Colors[Offset00 + 2]);
-									const int64 Offset10 = Y2 * (Width * 3) + (X3 * 3);
-									const FVector3f Color10 = FVector3f(Colors[Offset10], Colors[Offset10 + 1], Colors[Offset10 + 2]);
+		// GGX prefiltering with N = V = R, every level reads from the box filtered chain
+		// (the lod of each sample is chosen from its pdf to reduce the required number of samples)
+		struct FGGXSample
+		{
+			FVector Half;
+			float NoL;
+			int32 MipIndex;
+		};
 
-									const int64 Offset01 = Y3 * (Width * 3) + (X2 * 3);
-									const FVector3f Color01 = FVector3f(Colors[Offset01], Colors[Offset01 + 1], Colors[Offset01 + 2]);
-									const int64 Offset11 = Y3 * (Width * 3) + (X3 * 3);
-									const FVector3f Color11 = FVector3f(Colors[Offset11], Colors[Offset11 + 1], Colors[Offset11 + 2]);
+		const int32 NumSamples = FMath::Max(1, ImagesConfig.CubeMapGGXSamples);
+		const float TexelSolidAngle = 4 * PI / (6.0f * Resolution * Resolution);
 
-									FVector3f Color = FMath::BiLerp(Color00, Color10, Color01, Color11, FX, FY);
+		TArray<TArray<FGGXSample>> MipsSamples;
+		TArray<int32> MipsFirstRow;
+		int32 NumRows = 0;
+		MipsSamples.AddDefaulted(NumMips);
+		MipsFirstRow.AddZeroed(NumMips);
 
-									FFloat16Color Color16 = FLinearColor(Color);
+		for (int32 MipIndex = 1; MipIndex < NumMips; MipIndex++)
+		{
+			const float Roughness = static_cast<float>(MipIndex) / (NumMips - 1);
+			const float Alpha = Roughness * Roughness;
+			const float Alpha2 = Alpha * Alpha;
 
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; SampleIndex++)
+			{
+				const float E1 = static_cast<float>(SampleIndex) / NumSamples;
+				const float E2 = ReverseBits(static_cast<uint32>(SampleIndex)) * 2.3283064365386963e-10f;
 
-									FMemory::Memcpy(OutPixels.GetData() + Offset, &Color16, sizeof(FFloat16) * 3);
-								}
-								else if (PixelFormat == EPixelFormat::PF_FloatRGBA)
-								{
-									const FFloat16* Colors = reinterpret_cast<const FFloat16*>(Pixels.GetData());
-									const int64 Offset00 = Y2 * (Width * 4) + (X2 * 4);
-									const FVector4f Color00 = FVector4f(Colors[Offset00], Colors[Offset00 + 1], Colors[Offset00 + 2], Colors[Offset00 + 3]);
-									const int64 Offset10 = Y2 * (Width * 4) + (X3 * 4);
-									const FVector4f Color10 = FVector4f(Colors[Offset10], Colors[Offset10 + 1], Colors[Offset10 + 2], Colors[Offset10 + 3]);
+				const float Phi = 2 * PI * E1;
+				const float CosTheta = FMath::Sqrt((1 - E2) / (1 + (Alpha2 - 1) * E2));
+				const float SinTheta = FMath::Sqrt(1 - CosTheta * CosTheta);
 
-									const int64 Offset01 = Y3 * (Width * 4) + (X2 * 4);
-									const FVector4f Color01 = FVector4f(Colors[Offset01], Colors[Offset01 + 1], Colors[Offset01 + 2], Colors[Offset01 + 3]);
-									const int64 Offset11 = Y3 * (Width * 4) + (X3 * 4);
-									const FVector4f Color11 = FVector4f(Colors[Offset11], Colors[Offset11 + 1], Colors[Offset11 + 2], Colors[Offset11 + 3]);
+				const float NoL = 2 * CosTheta * CosTheta - 1;
+				if (NoL <= 0)
+				{
+					continue;
+				}
 
-									FVector4f Color = FMath::BiLerp(Color00, Color10, Color01, Color11, FX, FY);
+				const float D = (CosTheta * CosTheta * (Alpha2 - 1) + 1);
+				const float PDF = Alpha2 / (PI * D * D) * 0.25f;
+				const float SampleSolidAngle = 1.0f / (NumSamples * PDF + KINDA_SMALL_NUMBER);
+				const float Lod = FMath::Max(0.0f, 0.5f * FMath::Log2(SampleSolidAngle / TexelSolidAngle) + 1);
 
-									FFloat16Color Color16 = FLinearColor(Color);
+				FGGXSample Sample;
+				Sample.Half = FVector(SinTheta * FMath::Cos(Phi), SinTheta * FMath::Sin(Phi), CosTheta);
+				Sample.NoL = NoL;
+				Sample.MipIndex = FMath::Min(FMath::RoundToInt(Lod), NumMips - 1);
+				MipsSamples[MipIndex].Add(Sample);
+			}
 
-									FMemory::Memcpy(OutPixels.GetData() + Offset, &Color16, sizeof(FFloat16) * 4);
-								}
+			MipsFirstRow[MipIndex] = NumRows;
+			NumRows += 6 * MipResolutions[MipIndex];
+		}
 
-#else
-								if (PixelFormat == EPixelFormat::PF_FloatRGB)
-								{
-									const FFloat16* Colors = reinterpret_cast<const FFloat16*>(Pixels.GetData());
-									const int64 Offset00 = Y2 * (Width * 3) + (X2 * 3);
-									const FVector Color00 = FVector(Colors[Offset00], Colors[Offset00 + 1], Colors[Offset00 + 2]);
-									const int64 Offset10 = Y2 * (Width * 3) + (X3 * 3);
-									const FVector Color10 = FVector(Colors[Offset10], Colors[Offset10 + 1], Colors[Offset10 + 2]);
+		TArray<TArray64<FLinearColor>> FilteredFaces;
+		FilteredFaces.AddDefaulted(Faces.Num());
+		for (int32 FaceIndex = 6; FaceIndex < Faces.Num(); FaceIndex++)
+		{
+			FilteredFaces[FaceIndex].AddUninitialized(Faces[FaceIndex].Num());
+		}
 
-									const int64 Offset01 = Y3 * (Width * 3) + (X2 * 3);
-									const FVector Color01 = FVector(Colors[Offset01], Colors[Offset01 + 1], Colors[Offset01 + 2]);
-									const int64 Offset11 = Y3 * (Width * 3) + (X3 * 3);
-									const FVector Color11 = FVector(Colors[Offset11], Colors[Offset11 + 1], Colors[Offset11 + 2]);
+		ParallelFor(NumRows, [&](const int32 RowIndex)
+			{
+				int32 MipIndex = NumMips - 1;
+				while (MipsFirstRow[MipIndex] > RowIndex)
+				{
+					MipIndex--;
+				}
 
-									FVector Color = FMath::BiLerp(Color00, Color10, Color01, Color11, FX, FY);
+				const int32 MipResolution = MipResolutions[MipIndex];
+				const int32 FaceIndex = (RowIndex - MipsFirstRow[MipIndex]) / MipResolution;
+				const int32 PixelY = (RowIndex - MipsFirstRow[MipIndex]) % MipResolution;
+				TArray64<FLinearColor>& Destination = FilteredFaces[MipIndex * 6 + FaceIndex];
 
-									FFloat16Color Color16 = FLinearColor(Color);
+				for (int32 PixelX = 0; PixelX < MipResolution; PixelX++)
+				{
+					const FVector N = GetCubeMapTexelDirection(FaceIndex, MipResolution, PixelX, PixelY);
+					const FVector UpVector = FMath::Abs(N.Z) < 0.999f ? FVector(0, 0, 1) : FVector(1, 0, 0);
+					const FVector TangentX = (UpVector ^ N).GetUnsafeNormal();
+					const FVector TangentY = N ^ TangentX;
+
+					FCubeMapVectorRegister Color = VectorZero();
+					float Weight = 0;
+					for (const FGGXSample& Sample : MipsSamples[MipIndex])
+					{
+						const FVector H = TangentX * Sample.Half.X + TangentY * Sample.Half.Y + N * Sample.Half.Z;
+						const FVector L = 2 * Sample.Half.Z * H - N;
 
+						int32 SampleFaceIndex = 0;
+						float U = 0;
+						float V = 0;
+						GetCubeMapFaceFromDirection(L, SampleFaceIndex, U, V);
 
-									FMemory::Memcpy(OutPixels.GetData() + Offset, &Color16, sizeof(FFloat16) * 3);
-								}
-								else if (PixelFormat == EPixelFormat::PF_FloatRGBA)
-								{
-									const FFloat16* Colors = reinterpret_cast<const FFloat16*>(Pixels.GetData());
-									const int64 Offset00 = Y2 * (Width * 4) + (X2 * 4);
-									const FVector4 Color00 = FVector4(Colors[Offset00], Colors[Offset00 + 1], Colors[Offset00 + 2], Colors[Offset00 + 3]);
-									const int64 Offset10 = Y2 * (Width * 4) + (X3 * 4);
-									const FVector4 Color10 = FVector4(Colors[Offset10], Colors[Offset10 + 1], Colors[Offset10 + 2], Colors[Offset10 + 3]);
+						const FCubeMapVectorRegister SampleColor = SampleCubeMapFace(Faces[Sample.MipIndex * 6 + SampleFaceIndex], MipResolutions[Sample.MipIndex], U, V);
+						Color = VectorMultiplyAdd(SampleColor, VectorSetFloat1(Sample.NoL), Color);
+						Weight += Sample.NoL;
+					}
 
-									const int64 Offset01 = Y3 * (Width * 4) + (X2 * 4);
-									const FVector4 Color01 = FVector4(Colors[Offset01], Colors[Offset01 + 1], Colors[Offset01 + 2], Colors[Offset01 + 3]);
-									const int64 Offset11 = Y3 * (Width * 4) + (X3 * 4);
-									const FVector4 Color11 = FVector4(Colors[Offset11], Colors[Offset11 + 1], Colors[Offset11 + 2], Colors[Offset11 + 3]);
+					if (Weight > 0)
+					{
+						Color = VectorMultiply(Color, VectorSetFloat1(1.0f / Weight));
+					}
 
-									FVector4 Color = FMath::BiLerp(Color00, Color10, Color01, Color11, FX, FY);
+					VectorStore(Color, &Destination[PixelY * MipResolution + PixelX].R);
+				}
+			});
 
-									FFloat16Color Color16 = FLinearColor(Color);
+		for (int32 FaceIndex = 6; FaceIndex < Faces.Num(); FaceIndex++)
+		{
+			Faces[FaceIndex] = MoveTemp(FilteredFaces[FaceIndex]);
+		}
+	}
 
-									FMemory::Memcpy(OutPixels.GetData() + Offset, &Color16, sizeof(FFloat16) * 4);
-								}
-#endif
-								else
-								{
+	bool LoadCubeMapMipsFromBlob(TSharedRef<FglTFRuntimeParser> Parser, const FglTFRuntimeImagesConfig& ImagesConfig, const bool bSpherical, TArray<FglTFRuntimeMipMap>& MipsXP, TArray<FglTFRuntimeMipMap>& MipsXN, TArray<FglTFRuntimeMipMap>& MipsYP, TArray<FglTFRuntimeMipMap>& MipsYN, TArray<FglTFRuntimeMipMap>& MipsZP, TArray<FglTFRuntimeMipMap>& MipsZN)
+	{
+		TArray64<uint8> UncompressedBytes;
+		int32 Width = 0;
+		int32 Height = 0;
+		EPixelFormat PixelFormat;
 
-								}
-							}
-						});
-				};
+		if (!Parser->LoadImageFromBlob(Parser->GetBlob(), MakeShared<FJsonObject>(), UncompressedBytes, Width, Height, PixelFormat, ImagesConfig))
+		{
+			return false;
+		}
 
-			FglTFRuntimeMipMap MipXP(-1, PixelFormat, Resolution, Resolution);
-			GetCubemapFace(UncompressedBytes, { 1.0f, -1.0f, -1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, MipXP.Pixels);
-			MipsXP.Add(MoveTemp(MipXP));
+		if (Width <= 0 || Height <= 0)
+		{
+			return false;
+		}
 
-			FglTFRuntimeMipMap MipXN(-1, PixelFormat, Resolution, Resolution);
-			GetCubemapFace(UncompressedBytes, { -1.0f, -1.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f }, MipXN.Pixels);
-			MipsXN.Add(MoveTemp(MipXN));
+		// faces are stored as XP, XN, YP, YN, ZP, ZN for each mip
+		TArray<TArray64<FLinearColor>> Faces;
+		TArray<int32> MipResolutions;
 
-			FglTFRuntimeMipMap MipYP(-1, PixelFormat, Resolution, Resolution);
-			GetCubemapFace(UncompressedBytes, { -1.0f, -1.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, MipYP.Pixels);
-			MipsYP.Add(MoveTemp(MipYP));
+		if (bSpherical)
+		{
+			SCOPED_NAMED_EVENT(glTFRuntime_SphericalToCubeMap, FColor::Magenta);
 
-			FglTFRuntimeMipMap MipYN(-1, PixelFormat, Resolution, Resolution);
-			GetCubemapFace(UncompressedBytes, { -1.0f, 1.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, MipYN.Pixels);
-			MipsYN.Add(MoveTemp(MipYN));
+			if (!IsCubeMapPixelFormatSupported(PixelFormat))
+			{
+				Parser->AddError("LoadCubeMapMipsFromBlob", "Unsupported pixel format for spherical cubemap conversion");
+				return false;
+			}
+
+			TArray64<FLinearColor> SourcePixels;
+			DecodeCubeMapPixels(UncompressedBytes.GetData(), PixelFormat, static_cast<int64>(Width) * Height, SourcePixels);
+
+			const int32 Resolution = Height;
+			TSharedRef<const FCubeMapDirectionLUT> LUT = GetCubeMapDirectionLUT(Resolution);
+
+			MipResolutions.Add(Resolution);
+			Faces.AddDefaulted(6);
+			for (TArray64<FLinearColor>& Face : Faces)
+			{
+				Face.AddUninitialized(static_cast<int64>(Resolution) * Resolution);
+			}
 
-			FglTFRuntimeMipMap MipZP(-1, PixelFormat, Resolution, Resolution);
-			GetCubemapFace(UncompressedBytes, { -1.0f, -1.0f, -1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, MipZP.Pixels);
-			MipsZP.Add(MoveTemp(MipZP));
+			// all of the six faces are processed in a single parallel pass
+			ParallelFor(6 * Resolution, [&](const int32 RowIndex)
+				{
+					const int32 FaceIndex = RowIndex / Resolution;
+					const int32 PixelY = RowIndex % Resolution;
+					const FCubeMapFaceBasis& Face = CubeMapFacesBasis[FaceIndex];
+					FLinearColor* Row = Faces[FaceIndex].GetData() + static_cast<int64>(PixelY) * Resolution;
+
+					const int32 CapRow = (Face.bMirrorCap ? (Resolution - 1 - PixelY) : PixelY) * Resolution;
+					const int32 SideRow = PixelY * Resolution;
+
+					for (int32 PixelX = 0; PixelX < Resolution; PixelX++)
+					{
+						float U = 0;
+						float V = 0;
+						if (Face.bCap)
+						{
+							U = LUT->CapU[CapRow + PixelX] + Face.AzimuthOffset;
+							V = 0.5f + Face.ElevationSign * LUT->CapV[SideRow + PixelX];
+						}
+						else
+						{
+							U = LUT->SideU[PixelX] + Face.AzimuthOffset;
+							V = LUT->SideV[SideRow + PixelX];
+						}
 
-			FglTFRuntimeMipMap MipZN(-1, PixelFormat, Resolution, Resolution);
-			GetCubemapFace(UncompressedBytes, { 1.0f, -1.0f, 1.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, MipZN.Pixels);
-			MipsZN.Add(MoveTemp(MipZN));
+						VectorStore(SampleEquirectangular(SourcePixels, Width, Height, U, V), &Row[PixelX].R);
+					}
+				});
 		}
 		else
 		{
@@ -236,28 +497,59 @@ namespace glTFRuntime
 				return false;
 			}
 
-			FglTFRuntimeMipMap MipXP(-1, PixelFormat, Width, Height);
-			MipXP.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 0), ImageSize);
-			MipsXP.Add(MoveTemp(MipXP));
-			FglTFRuntimeMipMap MipXN(-1, PixelFormat, Width, Height);
-			MipXN.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 1), ImageSize);
-			MipsXN.Add(MoveTemp(MipXN));
-
-			FglTFRuntimeMipMap MipYP(-1, PixelFormat, Width, Height);
-			MipYP.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 2), ImageSize);
-			MipsYP.Add(MoveTemp(MipYP));
-			FglTFRuntimeMipMap MipYN(-1, PixelFormat, Width, Height);
-			MipYN.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 3), ImageSize);
-			MipsYN.Add(MoveTemp(MipYN));
-
-			FglTFRuntimeMipMap MipZP(-1, PixelFormat, Width, Height);
-			MipZP.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 4), ImageSize);
-			MipsZP.Add(MoveTemp(MipZP));
-			FglTFRuntimeMipMap MipZN(-1, PixelFormat, Width, Height);
-			MipZN.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 5), ImageSize);
-			MipsZN.Add(MoveTemp(MipZN));
+			if (!ImagesConfig.bGenerateCubeMapMips || Width != Height || !IsCubeMapPixelFormatSupported(PixelFormat))
+			{
+				FglTFRuntimeMipMap MipXP(-1, PixelFormat, Width, Height);
+				MipXP.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 0), ImageSize);
+				MipsXP.Add(MoveTemp(MipXP));
+				FglTFRuntimeMipMap MipXN(-1, PixelFormat, Width, Height);
+				MipXN.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 1), ImageSize);
+				MipsXN.Add(MoveTemp(MipXN));
+
+				FglTFRuntimeMipMap MipYP(-1, PixelFormat, Width, Height);
+				MipYP.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 2), ImageSize);
+				MipsYP.Add(MoveTemp(MipYP));
+				FglTFRuntimeMipMap MipYN(-1, PixelFormat, Width, Height);
+				MipYN.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 3), ImageSize);
+				MipsYN.Add(MoveTemp(MipYN));
+
+				FglTFRuntimeMipMap MipZP(-1, PixelFormat, Width, Height);
+				MipZP.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 4), ImageSize);
+				MipsZP.Add(MoveTemp(MipZP));
+				FglTFRuntimeMipMap MipZN(-1, PixelFormat, Width, Height);
+				MipZN.Pixels.Append(UncompressedBytes.GetData() + (ImageSize * 5), ImageSize);
+				MipsZN.Add(MoveTemp(MipZN));
+
+				return true;
+			}
+
+			MipResolutions.Add(Width);
+			Faces.AddDefaulted(6);
+			for (int32 FaceIndex = 0; FaceIndex < 6; FaceIndex++)
+			{
+				DecodeCubeMapPixels(UncompressedBytes.GetData() + (ImageSize * FaceIndex), PixelFormat, static_cast<int64>(Width) * Height, Faces[FaceIndex]);
+			}
+		}
+
+		if (ImagesConfig.bGenerateCubeMapMips)
+		{
+			GenerateCubeMapMips(ImagesConfig, MipResolutions[0], Faces, MipResolutions);
 		}
 
+		TArray<FglTFRuntimeMipMap>* FacesMips[6] = { &MipsXP, &MipsXN, &MipsYP, &MipsYN, &MipsZP, &MipsZN };
+		for (int32 MipIndex = 0; MipIndex < MipResolutions.Num(); MipIndex++)
+		{
+			for (int32 FaceIndex = 0; FaceIndex < 6; FaceIndex++)
+			{
+				FacesMips[FaceIndex]->Add(FglTFRuntimeMipMap(-1, PixelFormat, MipResolutions[MipIndex], MipResolutions[MipIndex]));
+			}
+		}
+
+		ParallelFor(Faces.Num(), [&](const int32 Index)
+			{
+				EncodeCubeMapPixels(Faces[Index], PixelFormat, (*FacesMips[Index % 6])[Index / 6].Pixels);
+			});
+
 		return true;
 	}
 }
@@ -639,6 +931,29 @@ UAnimSequence* UglTFRuntimeAsset::LoadAndMergeSkeletalAnimations(USkeletalMesh*
 	return Parser->LoadAndMergeSkeletalAnimations(SkeletalMesh, AnimationIndices, bRandomize, SkeletalAnimationConfig);
 }
 
+TArray<UAnimSequence*> UglTFRuntimeAsset::LoadSkeletalAnimations(USkeletalMesh* SkeletalMesh, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	GLTF_CHECK_PARSER(TArray<UAnimSequence*>());
+
+	return Parser->LoadSkeletalAnimations(SkeletalMesh, AnimationIndices, SkeletalAnimationConfig);
+}
+
+void UglTFRuntimeAsset::LoadSkeletalAnimationsAsync(USkeletalMesh* SkeletalMesh, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationsAsync& AsyncCallback, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	GLTF_CHECK_PARSER_VOID();
+
+	Parser->LoadSkeletalAnimationsAsync(SkeletalMesh, AnimationIndices, AsyncCallback, SkeletalAnimationConfig);
+}
+
+FglTFRuntimeVertexAnimation UglTFRuntimeAsset::LoadVertexAnimation(const int32 MeshIndex, const int32 SkinIndex, const TArray<int32>& AnimationIndices, const FglTFRuntimeVertexAnimationConfig& VertexAnimationConfig)
+{
+	FglTFRuntimeVertexAnimation VertexAnimation;
+	GLTF_CHECK_PARSER(VertexAnimation);
+
+	Parser->LoadVertexAnimation(MeshIndex, SkinIndex, AnimationIndices, VertexAnimationConfig, VertexAnimation);
+	return VertexAnimation;
+}
+
 UAnimSequence* UglTFRuntimeAsset::LoadAndMergeSkeletalAnimationsByName(USkeletalMesh* SkeletalMesh, const TArray<FString>& AnimationNames, const bool bIgnoreNonExistent, const bool bRandomize, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
 {
 	GLTF_CHECK_PARSER(nullptr);
@@ -788,6 +1103,13 @@ bool UglTFRuntimeAsset::LoadStaticMeshIntoProceduralMeshComponent(const int32 Me
 	return Parser->LoadStaticMeshIntoProceduralMeshComponent(MeshIndex, ProceduralMeshComponent, ProceduralMeshConfig);
 }
 
+void UglTFRuntimeAsset::LoadStaticMeshIntoProceduralMeshComponentAsync(const int32 MeshIndex, UProceduralMeshComponent* ProceduralMeshComponent, const FglTFRuntimeProceduralMeshComponentAsync& AsyncCallback, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig)
+{
+	GLTF_CHECK_PARSER_VOID();
+
+	Parser->LoadStaticMeshIntoProceduralMeshComponentAsync(MeshIndex, ProceduralMeshComponent, AsyncCallback, ProceduralMeshConfig);
+}
+
 UMaterialInterface* UglTFRuntimeAsset::LoadMaterial(const int32 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors)
 {
 	GLTF_CHECK_PARSER(nullptr);
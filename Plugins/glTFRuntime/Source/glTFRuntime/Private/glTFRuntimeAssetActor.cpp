@@ -225,6 +225,7 @@ void AglTFRuntimeAssetActor::ProcessNode(USceneComponent* NodeParentComponent, c
 				}
 			}
 			StaticMeshComponent->SetStaticMesh(StaticMesh);
+			FglTFRuntimeParser::AddSharedStaticMeshComponent(StaticMeshComponent);
 			ReceiveOnStaticMeshComponentCreated(StaticMeshComponent, Node);
 			NewComponent = StaticMeshComponent;
 		}
@@ -420,6 +421,7 @@ void AglTFRuntimeAssetActor::SetCurveAnimationByName(const FString& CurveAnimati
 		{
 			Pair.Value = WantedCurveAnimationsMap[CurveAnimationName];
 			CurveBasedAnimationsTimeTracker[Pair.Key] = 0;
+			CurveBasedAnimationsCursors.Remove(Pair.Key);
 		}
 		else
 		{
@@ -455,7 +457,7 @@ void AglTFRuntimeAssetActor::Tick(float DeltaTime)
 
 		if (CurrentTime >= MinTime)
 		{
-			FTransform FrameTransform = Pair.Value->GetTransformValue(CurveBasedAnimationsTimeTracker[Pair.Key]);
+			FTransform FrameTransform = Pair.Value->GetTransformValueWithCursor(CurveBasedAnimationsTimeTracker[Pair.Key], CurveBasedAnimationsCursors.FindOrAdd(Pair.Key));
 			Pair.Key->SetRelativeTransform(FrameTransform);
 		}
 		CurveBasedAnimationsTimeTracker[Pair.Key] += DeltaTime;
@@ -187,6 +187,7 @@ void AglTFRuntimeAssetActorAsync::LoadStaticMeshAsync(UStaticMesh* StaticMesh)
 		if (bShowWhileLoading)
 		{
 			StaticMeshComponent->SetStaticMesh(StaticMesh);
+			FglTFRuntimeParser::AddSharedStaticMeshComponent(StaticMeshComponent);
 		}
 
 		if (StaticMesh && !StaticMeshConfig.ExportOriginalPivotToSocket.IsEmpty())
@@ -246,6 +247,7 @@ void AglTFRuntimeAssetActorAsync::ScenesLoaded()
 		for (const TPair<UStaticMeshComponent*, UStaticMesh*>& Pair : DiscoveredStaticMeshComponents)
 		{
 			Pair.Key->SetStaticMesh(Pair.Value);
+			FglTFRuntimeParser::AddSharedStaticMeshComponent(Pair.Key);
 		}
 
 		for (const TPair<USkeletalMeshComponent*, USkeletalMesh*>& Pair : DiscoveredSkeletalMeshComponents)
@@ -616,6 +616,20 @@ bool UglTFRuntimeFunctionLibrary::GetNormalsAsBytesFromglTFRuntimeLODPrimitive(c
 	return true;
 }
 
+bool UglTFRuntimeFunctionLibrary::GetMorphTargetDeltasFromglTFRuntimeLODPrimitive(const FglTFRuntimeMeshLOD& RuntimeLOD, const int32 PrimitiveIndex, const int32 MorphTargetIndex, TArray<FVector>& Positions, TArray<FVector>& Normals)
+{
+	if (!RuntimeLOD.Primitives.IsValidIndex(PrimitiveIndex) || !RuntimeLOD.Primitives[PrimitiveIndex].MorphTargets.IsValidIndex(MorphTargetIndex))
+	{
+		return false;
+	}
+
+	const FglTFRuntimePrimitive& Primitive = RuntimeLOD.Primitives[PrimitiveIndex];
+	const FglTFRuntimeMorphTarget& MorphTarget = Primitive.MorphTargets[MorphTargetIndex];
+	Positions = MorphTarget.GetDensePositions(Primitive.Positions.Num());
+	Normals = MorphTarget.GetDenseNormals(Primitive.Positions.Num());
+	return true;
+}
+
 FglTFRuntimeMeshLOD UglTFRuntimeFunctionLibrary::glTFMergeRuntimeLODs(const TArray<FglTFRuntimeMeshLOD>& RuntimeLODs)
 {
 	FglTFRuntimeMeshLOD NewRuntimeLOD;
@@ -731,7 +745,7 @@ FglTFRuntimeMeshLOD UglTFRuntimeFunctionLibrary::glTFMergeRuntimeLODsWithSkeleto
 						NewPrimitive.Joints[0][VertexIndex].Y = 0;
 						NewPrimitive.Joints[0][VertexIndex].Z = 0;
 						NewPrimitive.Joints[0][VertexIndex].W = 0;
-						NewPrimitive.Weights[0][VertexIndex].X = 1;
+						NewPrimitive.Weights[0][VertexIndex].X = MAX_uint16;
 						NewPrimitive.Weights[0][VertexIndex].Y = 0;
 						NewPrimitive.Weights[0][VertexIndex].Z = 0;
 						NewPrimitive.Weights[0][VertexIndex].W = 0;
@@ -30,6 +30,7 @@
 
 DEFINE_LOG_CATEGORY(LogGLTFRuntime);
 
+FglTFRuntimeOnPreLoadedPrimitive FglTFRuntimeParser::OnDecodePrimitive;
 FglTFRuntimeOnPreLoadedPrimitive FglTFRuntimeParser::OnPreLoadedPrimitive;
 FglTFRuntimeOnLoadedPrimitive FglTFRuntimeParser::OnLoadedPrimitive;
 FglTFRuntimeOnLoadedRefSkeleton FglTFRuntimeParser::OnLoadedRefSkeleton;
@@ -44,6 +45,30 @@ FglTFRuntimeOnPreCreatedStaticMesh FglTFRuntimeParser::OnPreCreatedStaticMesh;
 FglTFRuntimeOnPostCreatedStaticMesh FglTFRuntimeParser::OnPostCreatedStaticMesh;
 FglTFRuntimeOnPreCreatedSkeletalMesh FglTFRuntimeParser::OnPreCreatedSkeletalMesh;
 
+namespace glTFRuntime
+{
+	FCriticalSection DecodableExtensionsLock;
+	TSet<FString> DecodableExtensions;
+}
+
+void FglTFRuntimeParser::RegisterDecodableExtension(const FString& Extension)
+{
+	FScopeLock Lock(&glTFRuntime::DecodableExtensionsLock);
+	glTFRuntime::DecodableExtensions.Add(Extension);
+}
+
+void FglTFRuntimeParser::UnregisterDecodableExtension(const FString& Extension)
+{
+	FScopeLock Lock(&glTFRuntime::DecodableExtensionsLock);
+	glTFRuntime::DecodableExtensions.Remove(Extension);
+}
+
+bool FglTFRuntimeParser::CanDecodeExtension(const FString& Extension)
+{
+	FScopeLock Lock(&glTFRuntime::DecodableExtensionsLock);
+	return glTFRuntime::DecodableExtensions.Contains(Extension);
+}
+
 TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromFilename(const FString& Filename, const FglTFRuntimeConfig& LoaderConfig)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromFilename, FColor::Magenta);
@@ -172,11 +197,9 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromRawDataAndArchive(const u
 		}
 	}
 
-	if (DataNum > 0 && DataNum <= INT32_MAX)
+	if (DataNum > 0)
 	{
-		FString JsonData;
-		FFileHelper::BufferToString(JsonData, DataPtr, (int32)DataNum);
-		return FromString(JsonData, LoaderConfig, InArchive);
+		return FromUTF8(DataPtr, DataNum, LoaderConfig, InArchive);
 	}
 
 	return nullptr;
@@ -186,6 +209,10 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromData, FColor::Magenta);
 
+	// the derived data cache key is based on the original (still compressed) data
+	const uint8* SourceDataPtr = DataPtr;
+	const int64 SourceDataNum = DataNum;
+
 	// required for Gzip and LZ4;
 	TArray64<uint8> UncompressedData;
 
@@ -606,7 +633,13 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromData(const uint8* DataPtr
 		}
 	}
 
-	return FromRawDataAndArchive(DataPtr, DataNum, Archive, LoaderConfig);
+	TSharedPtr<FglTFRuntimeParser> Parser = FromRawDataAndArchive(DataPtr, DataNum, Archive, LoaderConfig);
+	if (Parser && !LoaderConfig.DerivedDataCacheDirectory.IsEmpty())
+	{
+		Parser->SetDerivedDataCache(LoaderConfig.DerivedDataCacheDirectory, SourceDataPtr, SourceDataNum);
+	}
+
+	return Parser;
 }
 
 TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromMap(const TMap<FString, TArray64<uint8>> Map, const FglTFRuntimeConfig& LoaderConfig)
@@ -636,7 +669,12 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromString(const FString& Jso
 	if (!JsonObject)
 		return nullptr;
 
-	TSharedPtr<FglTFRuntimeParser> Parser = MakeShared<FglTFRuntimeParser>(JsonObject.ToSharedRef(), LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
+	return FromJsonObject(JsonObject.ToSharedRef(), LoaderConfig, InArchive);
+}
+
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromJsonObject(TSharedRef<FJsonObject> JsonObject, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive)
+{
+	TSharedPtr<FglTFRuntimeParser> Parser = MakeShared<FglTFRuntimeParser>(JsonObject, LoaderConfig.GetMatrix(), LoaderConfig.SceneScale);
 
 	if (Parser)
 	{
@@ -654,6 +692,7 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromString(const FString& Jso
 		Parser->DefaultPrefixForUnnamedNodes = LoaderConfig.PrefixForUnnamedNodes;
 		Parser->Archive = InArchive;
 		Parser->AssetUserDataClasses = LoaderConfig.AssetUserDataClasses;
+		Parser->bShareAssets = LoaderConfig.bShareAssetsAcrossParsers;
 	}
 
 	return Parser;
@@ -663,7 +702,8 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataP
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromBinary, FColor::Magenta);
 
-	FString JsonData;
+	const uint8* JsonDataPtr = nullptr;
+	int64 JsonDataNum = 0;
 	TArray64<uint8> BinaryBuffer;
 
 	bool bJsonFound = false;
@@ -690,7 +730,8 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataP
 		if (*ChunkType == 0x4E4F534A && !bJsonFound)
 		{
 			bJsonFound = true;
-			FFileHelper::BufferToString(JsonData, &DataPtr[BlobIndex], *ChunkLength);
+			JsonDataPtr = &DataPtr[BlobIndex];
+			JsonDataNum = *ChunkLength;
 		}
 
 		else if (*ChunkType == 0x004E4942 && !bBinaryFound)
@@ -707,7 +748,7 @@ TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromBinary(const uint8* DataP
 		return nullptr;
 	}
 
-	TSharedPtr<FglTFRuntimeParser> Parser = FromString(JsonData, LoaderConfig, InArchive);
+	TSharedPtr<FglTFRuntimeParser> Parser = FromUTF8(JsonDataPtr, JsonDataNum, LoaderConfig, InArchive);
 
 	if (Parser)
 	{
@@ -871,6 +912,8 @@ FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const
 {
 	bAllNodesCached = false;
 	DownloadTime = 0;
+	bMeshoptBufferViewsDecompressed = false;
+	bShareAssets = false;
 
 	if (IsInGameThread())
 	{
@@ -907,11 +950,13 @@ FglTFRuntimeParser::FglTFRuntimeParser(TSharedRef<FJsonObject> JsonObject, const
 
 	if (ExtensionsRequired.Contains("KHR_draco_mesh_compression"))
 	{
-		if (!FModuleManager::Get().IsModuleLoaded(TEXT("glTFRuntimeDraco")))
+		if (!FModuleManager::Get().IsModuleLoaded(TEXT("glTFRuntimeDraco")) && !CanDecodeExtension("KHR_draco_mesh_compression"))
 		{
 			UE_LOG(LogGLTFRuntime, Warning, TEXT("KHR_draco_mesh_compression required but glTFRuntimeDraco module is not loaded"));
 		}
 	}
+
+	BuildDescTables();
 }
 
 bool FglTFRuntimeParser::LoadNodes()
@@ -921,25 +966,17 @@ bool FglTFRuntimeParser::LoadNodes()
 		return true;
 	}
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonNodes;
-
 	// no nodes ?
-	if (!Root->TryGetArrayField(TEXT("nodes"), JsonNodes))
+	if (!Root->HasField(TEXT("nodes")))
 	{
 		return false;
 	}
 
 	// first round for getting all nodes
-	for (int32 Index = 0; Index < JsonNodes->Num(); Index++)
+	for (int32 Index = 0; Index < NodesDescs.Num(); Index++)
 	{
-		TSharedPtr<FJsonObject> JsonNodeObject = (*JsonNodes)[Index]->AsObject();
-		if (!JsonNodeObject)
-		{
-			return false;
-		}
-
 		FglTFRuntimeNode Node;
-		if (!LoadNode_Internal(Index, JsonNodeObject.ToSharedRef(), JsonNodes->Num(), Node))
+		if (!LoadNode_Internal(Index, NodesDescs[Index], Node))
 		{
 			return false;
 		}
@@ -952,6 +989,8 @@ bool FglTFRuntimeParser::LoadNodes()
 		FixNodeParent(Node);
 	}
 
+	BuildSceneGraph();
+
 	bAllNodesCached = true;
 
 	return true;
@@ -959,10 +998,13 @@ bool FglTFRuntimeParser::LoadNodes()
 
 void FglTFRuntimeParser::FixNodeParent(FglTFRuntimeNode& Node)
 {
+	// every node is visited by LoadNodes(), so there is no need to recurse into the children
 	for (int32 Index : Node.ChildrenIndices)
 	{
-		AllNodesCache[Index].ParentIndex = Node.Index;
-		FixNodeParent(AllNodesCache[Index]);
+		if (AllNodesCache.IsValidIndex(Index))
+		{
+			AllNodesCache[Index].ParentIndex = Node.Index;
+		}
 	}
 }
 
@@ -1068,13 +1110,23 @@ bool FglTFRuntimeParser::CheckJsonIndex(TSharedRef<FJsonObject> JsonObject, cons
 
 TSharedPtr<FJsonObject> FglTFRuntimeParser::GetJsonObjectFromIndex(TSharedRef<FJsonObject> JsonObject, const FString& FieldName, const int32 Index) const
 {
-	TArray<TSharedRef<FJsonValue>> JsonArray;
-	if (!CheckJsonIndex(JsonObject, FieldName, Index, JsonArray))
+	if (Index < 0)
+	{
+		return nullptr;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* JsonArray;
+	if (!JsonObject->TryGetArrayField(FieldName, JsonArray))
+	{
+		return nullptr;
+	}
+
+	if (Index >= JsonArray->Num())
 	{
 		return nullptr;
 	}
 
-	return JsonArray[Index]->AsObject();
+	return (*JsonArray)[Index]->AsObject();
 }
 
 TSharedPtr<FJsonObject> FglTFRuntimeParser::GetJsonObjectFromExtensionIndex(TSharedRef<FJsonObject> JsonObject, const FString& ExtensionName, const FString& FieldName, const int32 Index)
@@ -1384,13 +1436,7 @@ int32 FglTFRuntimeParser::AddFakeRootNode(const FString& BaseName)
 
 	for (int32 NodeIndex = 0; NodeIndex < AllNodes.Num(); NodeIndex++)
 	{
-		FglTFRuntimeNode Node;
-		if (!LoadNode(NodeIndex, Node))
-		{
-			return INDEX_NONE;
-		}
-
-		if (Node.ParentIndex <= INDEX_NONE)
+		if (AllNodes[NodeIndex].ParentIndex <= INDEX_NONE)
 		{
 			OrphanNodes.Add(NodeIndex);
 			AllNodesCache[NodeIndex].ParentIndex = AllNodes.Num();
@@ -1404,6 +1450,9 @@ int32 FglTFRuntimeParser::AddFakeRootNode(const FString& BaseName)
 
 	AllNodesCache.Add(NewNode);
 
+	// the hierarchy changed
+	BuildSceneGraph();
+
 	return NewNode.Index;
 }
 
@@ -1488,11 +1537,55 @@ bool FglTFRuntimeParser::LoadJointByName(const int64 RootBoneIndex, const FStrin
 void FglTFRuntimeParser::AddError(const FString& ErrorContext, const FString& ErrorMessage)
 {
 	FString FullMessage = ErrorContext + ": " + ErrorMessage;
-	Errors.Add(FullMessage);
+	const bool bInGameThread = IsInGameThread();
+	bool bDispatchErrors = false;
+	{
+		FScopeLock ErrorsScopeLock(&ErrorsLock);
+		Errors.Add(FullMessage);
+		if (!bInGameThread && OnError.IsBound())
+		{
+			// a single game thread task flushes all of the errors queued in the meantime
+			bDispatchErrors = PendingErrors.Num() == 0;
+			PendingErrors.Add(TPair<FString, FString>(ErrorContext, ErrorMessage));
+		}
+	}
 	UE_LOG(LogGLTFRuntime, Error, TEXT("%s"), *FullMessage);
-	if (OnError.IsBound())
+
+	if (bInGameThread)
+	{
+		if (OnError.IsBound())
+		{
+			OnError.Broadcast(ErrorContext, ErrorMessage);
+		}
+		return;
+	}
+
+	if (bDispatchErrors)
+	{
+		TWeakPtr<FglTFRuntimeParser> WeakParser = AsShared();
+		FFunctionGraphTask::CreateAndDispatchWhenReady([WeakParser]()
+			{
+				TSharedPtr<FglTFRuntimeParser> Parser = WeakParser.Pin();
+				if (Parser)
+				{
+					Parser->BroadcastPendingErrors();
+				}
+			}, TStatId(), nullptr, ENamedThreads::GameThread);
+	}
+}
+
+void FglTFRuntimeParser::BroadcastPendingErrors()
+{
+	TArray<TPair<FString, FString>> ErrorsToBroadcast;
+	{
+		FScopeLock ErrorsScopeLock(&ErrorsLock);
+		ErrorsToBroadcast = MoveTemp(PendingErrors);
+		PendingErrors.Empty();
+	}
+
+	for (const TPair<FString, FString>& Pair : ErrorsToBroadcast)
 	{
-		OnError.Broadcast(ErrorContext, ErrorMessage);
+		OnError.Broadcast(Pair.Key, Pair.Value);
 	}
 }
 
@@ -1508,6 +1601,7 @@ const TArray<FString>& FglTFRuntimeParser::GetErrors() const
 
 void FglTFRuntimeParser::ClearErrors()
 {
+	FScopeLock ErrorsScopeLock(&ErrorsLock);
 	Errors.Empty();
 }
 
@@ -1530,72 +1624,26 @@ bool FglTFRuntimeParser::FillJsonMatrix(const TArray<TSharedPtr<FJsonValue>>* Js
 	return true;
 }
 
-bool FglTFRuntimeParser::LoadNode_Internal(int32 Index, TSharedRef<FJsonObject> JsonNodeObject, int32 NodesCount, FglTFRuntimeNode& Node)
+bool FglTFRuntimeParser::LoadNode_Internal(int32 Index, const FglTFRuntimeNodeDesc& NodeDesc, FglTFRuntimeNode& Node)
 {
-	Node.Index = Index;
-	Node.Name = GetJsonObjectString(JsonNodeObject, "name", DefaultPrefixForUnnamedNodes + FString::FromInt(Node.Index));
-
-	Node.MeshIndex = GetJsonObjectIndex(JsonNodeObject, "mesh", INDEX_NONE);
-
-	Node.SkinIndex = GetJsonObjectIndex(JsonNodeObject, "skin", INDEX_NONE);
-
-	Node.CameraIndex = GetJsonObjectIndex(JsonNodeObject, "camera", INDEX_NONE);
-
-	FMatrix Matrix = FMatrix::Identity;
-
-	const TArray<TSharedPtr<FJsonValue>>* JsonMatrixValues;
-	if (JsonNodeObject->TryGetArrayField(TEXT("matrix"), JsonMatrixValues))
+	if (!NodeDesc.bValid)
 	{
-		if (!FillJsonMatrix(JsonMatrixValues, Matrix))
-		{
-			return false;
-		}
+		return false;
 	}
 
-	FVector MatrixScaleToReapply = FVector::OneVector;
-	bool bMatrixScaleNeedsToBeReapplied = false;
-
-	const TArray<TSharedPtr<FJsonValue>>* JsonScaleValues;
-	if (JsonNodeObject->TryGetArrayField(TEXT("scale"), JsonScaleValues))
-	{
-		FVector MatrixScale;
-		if (!GetJsonVector<3>(JsonScaleValues, MatrixScale))
-		{
-			return false;
-		}
+	Node.Index = Index;
+	Node.Name = NodeDesc.bHasName ? NodeDesc.Name : DefaultPrefixForUnnamedNodes + FString::FromInt(Node.Index);
 
-		if (MatrixScale.IsNearlyZero())
-		{
-			bMatrixScaleNeedsToBeReapplied = true;
-			MatrixScaleToReapply = MatrixScale;
-		}
+	Node.MeshIndex = NodeDesc.MeshIndex;
 
-		Matrix *= FScaleMatrix(MatrixScale);
-	}
+	Node.SkinIndex = NodeDesc.SkinIndex;
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonRotationValues;
-	if (JsonNodeObject->TryGetArrayField(TEXT("rotation"), JsonRotationValues))
-	{
-		FVector4 Vector;
-		if (!GetJsonVector<4>(JsonRotationValues, Vector))
-		{
-			return false;
-		}
-		FQuat Quat = { Vector.X, Vector.Y, Vector.Z, Vector.W };
-		Matrix *= FQuatRotationMatrix(Quat);
-	}
+	Node.CameraIndex = NodeDesc.CameraIndex;
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonTranslationValues;
-	if (JsonNodeObject->TryGetArrayField(TEXT("translation"), JsonTranslationValues))
-	{
-		FVector Translation;
-		if (!GetJsonVector<3>(JsonTranslationValues, Translation))
-		{
-			return false;
-		}
+	FMatrix Matrix = NodeDesc.Matrix;
 
-		Matrix *= FTranslationMatrix(Translation);
-	}
+	const FVector MatrixScaleToReapply = NodeDesc.ScaleToReapply;
+	const bool bMatrixScaleNeedsToBeReapplied = NodeDesc.bScaleNeedsToBeReapplied;
 
 	Matrix.ScaleTranslation(FVector(SceneScale, SceneScale, SceneScale));
 
@@ -1621,25 +1669,7 @@ bool FglTFRuntimeParser::LoadNode_Internal(int32 Index, TSharedRef<FJsonObject>
 	}
 #endif
 
-	const TArray<TSharedPtr<FJsonValue>>* JsonChildren;
-	if (JsonNodeObject->TryGetArrayField(TEXT("children"), JsonChildren))
-	{
-		for (int32 i = 0; i < JsonChildren->Num(); i++)
-		{
-			int64 ChildIndex;
-			if (!(*JsonChildren)[i]->TryGetNumber(ChildIndex))
-			{
-				return false;
-			}
-
-			if (ChildIndex >= NodesCount)
-			{
-				return false;
-			}
-
-			Node.ChildrenIndices.Add(ChildIndex);
-		}
-	}
+	Node.ChildrenIndices.Append(NodesChildrenTable.GetData() + NodeDesc.FirstChild, NodeDesc.ChildrenNum);
 
 	return true;
 }
@@ -1651,7 +1681,7 @@ FTransform FglTFRuntimeParser::RawMatrixToRebasedTransform(const FMatrix& Matrix
 	return FTransform(SceneBasis.Inverse() * MatrixCopy * SceneBasis);
 }
 
-bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension)
+bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension, const TMap<int64, TArray<float>>* SharedTimelines)
 {
 	Name = GetJsonObjectString(JsonAnimationObject, "name", "");
 
@@ -1675,7 +1705,19 @@ bool FglTFRuntimeParser::LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnim
 
 		FglTFRuntimeAnimationCurve AnimationCurve;
 
-		if (!BuildFromAccessorField(JsonSamplerObject.ToSharedRef(), "input", AnimationCurve.Timeline, { 5126 }, INDEX_NONE, false, nullptr))
+		// inputs shared between samplers (and clips) can be decoded only once by the batch loaders
+		int64 InputIndex = INDEX_NONE;
+		const TArray<float>* SharedTimeline = nullptr;
+		if (SharedTimelines && JsonSamplerObject->TryGetNumberField(TEXT("input"), InputIndex))
+		{
+			SharedTimeline = SharedTimelines->Find(InputIndex);
+		}
+
+		if (SharedTimeline)
+		{
+			AnimationCurve.Timeline = *SharedTimeline;
+		}
+		else if (!BuildFromAccessorField(JsonSamplerObject.ToSharedRef(), "input", AnimationCurve.Timeline, { 5126 }, INDEX_NONE, false, nullptr))
 		{
 			AddError("LoadAnimation_Internal()", FString::Printf(TEXT("Unable to retrieve \"input\" from sampler %d"), SamplerIndex));
 			return false;
@@ -1918,7 +1960,7 @@ UglTFRuntimeAnimationCurve* FglTFRuntimeParser::LoadNodeAnimationCurve(const int
 			AnimationCurve->glTFCurveAnimationIndex = JsonAnimationIndex;
 			AnimationCurve->glTFCurveAnimationName = Name;
 			AnimationCurve->glTFCurveAnimationDuration = Duration;
-			AnimationCurve->BasisMatrix = SceneBasis;
+			AnimationCurve->SetBasisMatrix(SceneBasis);
 			return AnimationCurve;
 		}
 	}
@@ -2017,7 +2059,7 @@ TArray<UglTFRuntimeAnimationCurve*> FglTFRuntimeParser::LoadAllNodeAnimationCurv
 			AnimationCurve->glTFCurveAnimationIndex = JsonAnimationIndex;
 			AnimationCurve->glTFCurveAnimationName = Name;
 			AnimationCurve->glTFCurveAnimationDuration = Duration;
-			AnimationCurve->BasisMatrix = SceneBasis;
+			AnimationCurve->SetBasisMatrix(SceneBasis);
 			AnimationCurves.Add(AnimationCurve);
 		}
 	}
@@ -2032,68 +2074,59 @@ bool FglTFRuntimeParser::HasRoot(int32 Index, int32 RootIndex)
 		return true;
 	}
 
-	FglTFRuntimeNode Node;
-	if (!LoadNode(Index, Node))
+	if (!bAllNodesCached && !LoadNodes())
 	{
 		return false;
 	}
 
-	while (Node.ParentIndex != INDEX_NONE)
-	{
-		if (!LoadNode(Node.ParentIndex, Node))
-		{
-			return false;
-		}
-
-		if (Node.Index == RootIndex)
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return SceneGraphIsAncestor(RootIndex, Index);
 }
 
 int32 FglTFRuntimeParser::FindTopRoot(int32 Index)
 {
-	FglTFRuntimeNode Node;
-	if (!LoadNode(Index, Node))
+	if (!bAllNodesCached && !LoadNodes())
+	{
 		return INDEX_NONE;
-	while (Node.ParentIndex != INDEX_NONE)
+	}
+
+	if (!SceneGraphTopRoots.IsValidIndex(Index))
 	{
-		if (!LoadNode(Node.ParentIndex, Node))
-			return INDEX_NONE;
+		return INDEX_NONE;
 	}
 
-	return Node.Index;
+	return SceneGraphTopRoots[Index];
 }
 
 int32 FglTFRuntimeParser::FindCommonRoot(const TArray<int32>& Indices)
 {
+	if (!bAllNodesCached && !LoadNodes())
+	{
+		return INDEX_NONE;
+	}
+
 	int32 CurrentRootIndex = Indices[0];
-	bool bTryNextParent = true;
 
-	while (bTryNextParent && CurrentRootIndex > INDEX_NONE)
+	while (SceneGraphParents.IsValidIndex(CurrentRootIndex))
 	{
-		FglTFRuntimeNode Node;
-		if (!LoadNode(CurrentRootIndex, Node))
-		{
-			return INDEX_NONE;
-		}
-
-		bTryNextParent = false;
+		bool bTryNextParent = false;
 		for (int32 Index : Indices)
 		{
 			if (!HasRoot(Index, CurrentRootIndex))
 			{
 				bTryNextParent = true;
-				CurrentRootIndex = Node.ParentIndex;
 				break;
 			}
 		}
+
+		if (!bTryNextParent)
+		{
+			return CurrentRootIndex;
+		}
+
+		CurrentRootIndex = SceneGraphParents[CurrentRootIndex];
 	}
 
-	return CurrentRootIndex;
+	return INDEX_NONE;
 }
 
 bool FglTFRuntimeParser::LoadCameraIntoCameraComponent(const int32 CameraIndex, UCameraComponent* CameraComponent)
@@ -2192,9 +2225,13 @@ USkeleton* FglTFRuntimeParser::LoadSkeleton(const int32 SkinIndex, const FglTFRu
 		return nullptr;
 	}
 
-	if (CanReadFromCache(SkeletonConfig.CacheMode) && SkeletonsCache.Contains(SkinIndex))
+	if (CanReadFromCache(SkeletonConfig.CacheMode))
 	{
-		return SkeletonsCache[SkinIndex];
+		FReadScopeLock Lock(ObjectsCacheLock);
+		if (SkeletonsCache.Contains(SkinIndex))
+		{
+			return SkeletonsCache[SkinIndex];
+		}
 	}
 
 	TMap<int32, FName> BoneMap;
@@ -2238,6 +2275,7 @@ USkeleton* FglTFRuntimeParser::LoadSkeleton(const int32 SkinIndex, const FglTFRu
 
 	if (CanWriteToCache(SkeletonConfig.CacheMode))
 	{
+		FWriteScopeLock Lock(ObjectsCacheLock);
 		SkeletonsCache.Add(SkinIndex, Skeleton);
 	}
 
@@ -2981,6 +3019,31 @@ bool FglTFRuntimeParser::LoadPrimitives(TSharedRef<FJsonObject> JsonMeshObject,
 		}
 	}
 
+	if (MaterialsConfig.bWeldVertices)
+	{
+		for (int32 PrimitiveIndex = FirstPrimitive; PrimitiveIndex < Primitives.Num(); PrimitiveIndex++)
+		{
+			WeldPrimitiveVertices(Primitives[PrimitiveIndex], MaterialsConfig.WeldPositionsEpsilon, MaterialsConfig.WeldNormalsEpsilon, MaterialsConfig.WeldUVsEpsilon, MaterialsConfig.WeldColorsEpsilon);
+		}
+	}
+
+	if (MaterialsConfig.bOptimizePrimitives)
+	{
+		ParallelFor(Primitives.Num() - FirstPrimitive, [&](const int32 PrimitiveIndex)
+			{
+				OptimizePrimitive(Primitives[FirstPrimitive + PrimitiveIndex]);
+			});
+	}
+
+	// this also loads the materials deferred by LoadPrimitive()
+	if (MaterialsConfig.bAtlasTextures && !MaterialsConfig.bSkipLoad)
+	{
+		if (!AtlasPrimitivesTextures(Primitives, FirstPrimitive, MaterialsConfig))
+		{
+			return false;
+		}
+	}
+
 	if (MaterialsConfig.bMergeSectionsByMaterial)
 	{
 		MergePrimitivesByMaterial(Primitives);
@@ -3050,12 +3113,129 @@ FTransform FglTFRuntimeParser::TransformTransform(const FTransform& Transform) c
 	return NewTransform;
 }
 
+namespace glTFRuntime
+{
+	// normalize the 16 bit fixed point weights of each vertex (across all of the sets, 65535 = 1.0)
+	void NormalizeSkinWeights(TArray<TArray<FglTFRuntimeUInt16Vector4>>& Weights)
+	{
+		const int32 NumSets = Weights.Num();
+
+		int32 NumVertices = 0;
+		for (int32 SetIndex = 0; SetIndex < NumSets; SetIndex++)
+		{
+			NumVertices = FMath::Max(NumVertices, Weights[SetIndex].Num());
+		}
+
+		constexpr int32 ChunkSize = 4096;
+		ParallelFor(FMath::DivideAndRoundUp(NumVertices, ChunkSize), [&](const int32 ChunkIndex)
+			{
+				const int32 FirstVertex = ChunkIndex * ChunkSize;
+				const int32 LastVertex = FMath::Min(FirstVertex + ChunkSize, NumVertices);
+				for (int32 VertexIndex = FirstVertex; VertexIndex < LastVertex; VertexIndex++)
+				{
+					int64 TotalWeight = 0;
+					for (int32 SetIndex = 0; SetIndex < NumSets; SetIndex++)
+					{
+						if (Weights[SetIndex].IsValidIndex(VertexIndex))
+						{
+							const FglTFRuntimeUInt16Vector4& Weight = Weights[SetIndex][VertexIndex];
+							TotalWeight += Weight.X + Weight.Y + Weight.Z + Weight.W;
+						}
+					}
+
+					// already normalized (the common case) or nothing to distribute
+					if (TotalWeight <= 0 || TotalWeight == MAX_uint16)
+					{
+						continue;
+					}
+
+					int64 NormalizedTotalWeight = 0;
+					uint16* BestWeight = nullptr;
+					for (int32 SetIndex = 0; SetIndex < NumSets; SetIndex++)
+					{
+						if (Weights[SetIndex].IsValidIndex(VertexIndex))
+						{
+							FglTFRuntimeUInt16Vector4& Weight = Weights[SetIndex][VertexIndex];
+							for (int32 Component = 0; Component < 4; Component++)
+							{
+								Weight[Component] = static_cast<uint16>((Weight[Component] * static_cast<int64>(MAX_uint16) + TotalWeight / 2) / TotalWeight);
+								NormalizedTotalWeight += Weight[Component];
+								if (!BestWeight || Weight[Component] > *BestWeight)
+								{
+									BestWeight = &Weight[Component];
+								}
+							}
+						}
+					}
+
+					// rounding errors go to the most influent joint
+					*BestWeight = static_cast<uint16>(FMath::Clamp<int64>(*BestWeight + MAX_uint16 - NormalizedTotalWeight, 0, MAX_uint16));
+				}
+			});
+	}
+}
+
+bool FglTFRuntimeParser::BuildSkinWeightsFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<FglTFRuntimeUInt16Vector4>& Weights, const int64 AdditionalBufferView, int64* ComponentTypePtr)
+{
+	int64 AccessorIndex;
+	if (!JsonObject->TryGetNumberField(Name, AccessorIndex))
+	{
+		return false;
+	}
+
+	FglTFRuntimeBlob Blob;
+	int64 ComponentType = 0, Stride = 0, Elements = 0, ElementSize = 0, Count = 0;
+	bool bNormalized = true;
+
+	if (!GetAccessor(AccessorIndex, ComponentType, Stride, Elements, ElementSize, Count, bNormalized, Blob, GetAdditionalBufferView(AdditionalBufferView, Name)))
+	{
+		return false;
+	}
+
+	if (Elements != 4 || (ComponentType != 5126 && ComponentType != 5121 && ComponentType != 5123))
+	{
+		return false;
+	}
+
+	if (ComponentTypePtr)
+	{
+		*ComponentTypePtr = ComponentType;
+	}
+
+	// straight to 16 bit fixed point (65535 = 1.0), normalization across the sets happens later
+	Weights.AddUninitialized(Count);
+	ParallelFor(Count, [&](const int64 ElementIndex)
+		{
+			const uint8* Ptr = &(Blob.Data[ElementIndex * Stride]);
+			FglTFRuntimeUInt16Vector4& Weight = Weights[ElementIndex];
+			for (int32 Component = 0; Component < 4; Component++)
+			{
+				switch (ComponentType)
+				{
+				case(5126):// FLOAT
+					Weight[Component] = static_cast<uint16>(FMath::Clamp<int32>(FMath::RoundToInt(reinterpret_cast<const float*>(Ptr)[Component] * MAX_uint16), 0, MAX_uint16));
+					break;
+				case(5121):// UNSIGNED_BYTE
+					Weight[Component] = static_cast<uint16>(Ptr[Component] * 257);
+					break;
+				case(5123):// UNSIGNED_SHORT
+				default:
+					Weight[Component] = reinterpret_cast<const uint16*>(Ptr)[Component];
+					break;
+				}
+			}
+		});
+
+	return true;
+}
+
 bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObject, FglTFRuntimePrimitive& Primitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bTriangulatePointsAndLines)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadPrimitive, FColor::Magenta);
 
 	UMaterialInterface* ForceBaseMaterial = nullptr;
 
+	OnDecodePrimitive.Broadcast(AsShared(), JsonPrimitiveObject, Primitive);
 	OnPreLoadedPrimitive.Broadcast(AsShared(), JsonPrimitiveObject, Primitive);
 
 	if (!JsonPrimitiveObject->TryGetNumberField(TEXT("mode"), Primitive.Mode))
@@ -3208,10 +3388,9 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 
 	if ((*JsonAttributesObject)->HasField(TEXT("WEIGHTS_0")))
 	{
-		TArray<FVector4> Weights;
+		TArray<FglTFRuntimeUInt16Vector4> Weights;
 		int64 WeightsComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_0", Weights,
-			{ 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, &WeightsComponentType))
+		if (!BuildSkinWeightsFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_0", Weights, Primitive.AdditionalBufferView, &WeightsComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading WEIGHTS_0");
 			return false;
@@ -3222,15 +3401,14 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 			Primitive.bHighPrecisionWeights = true;
 		}
 
-		Primitive.Weights.Add(Weights);
+		Primitive.Weights.Add(MoveTemp(Weights));
 	}
 
 	if ((*JsonAttributesObject)->HasField(TEXT("WEIGHTS_1")))
 	{
-		TArray<FVector4> Weights;
+		TArray<FglTFRuntimeUInt16Vector4> Weights;
 		int64 WeightsComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_1", Weights,
-			{ 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, &WeightsComponentType))
+		if (!BuildSkinWeightsFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_1", Weights, Primitive.AdditionalBufferView, &WeightsComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading WEIGHTS_1");
 			return false;
@@ -3241,15 +3419,14 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 			Primitive.bHighPrecisionWeights = true;
 		}
 
-		Primitive.Weights.Add(Weights);
+		Primitive.Weights.Add(MoveTemp(Weights));
 	}
 
 	if ((*JsonAttributesObject)->HasField(TEXT("WEIGHTS_2")))
 	{
-		TArray<FVector4> Weights;
+		TArray<FglTFRuntimeUInt16Vector4> Weights;
 		int64 WeightsComponentType = 0;
-		if (!BuildFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_2", Weights,
-			{ 4 }, { 5126, 5121, 5123 }, Primitive.AdditionalBufferView, true, &WeightsComponentType))
+		if (!BuildSkinWeightsFromAccessorField(JsonAttributesObject->ToSharedRef(), "WEIGHTS_2", Weights, Primitive.AdditionalBufferView, &WeightsComponentType))
 		{
 			AddError("LoadPrimitive()", "Error loading WEIGHTS_2");
 			return false;
@@ -3260,7 +3437,12 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 			Primitive.bHighPrecisionWeights = true;
 		}
 
-		Primitive.Weights.Add(Weights);
+		Primitive.Weights.Add(MoveTemp(Weights));
+	}
+
+	if (Primitive.Weights.Num() > 0)
+	{
+		glTFRuntime::NormalizeSkinWeights(Primitive.Weights);
 	}
 
 	if ((*JsonAttributesObject)->HasField(TEXT("COLOR_0")))
@@ -3323,7 +3505,9 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 
 			if (bValid)
 			{
-				Primitive.MorphTargets.Add(MorphTarget);
+				// only the vertices with a delta are stored (most targets touch a small portion of the mesh)
+				MorphTarget.Compact();
+				Primitive.MorphTargets.Add(MoveTemp(MorphTarget));
 			}
 		}
 	}
@@ -3483,7 +3667,14 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 			}
 		}
 
-		if (MaterialIndex != INDEX_NONE)
+		// atlas candidates are loaded (or replaced by the atlas material) by AtlasPrimitivesTextures()
+		if (MaterialIndex != INDEX_NONE && !ForceBaseMaterial && MaterialsConfig.bAtlasTextures && !OnLoadedPrimitive.IsBound() && IsAtlasMaterialCandidate(MaterialIndex, MaterialsConfig, Primitive.MaterialName))
+		{
+			Primitive.Material = nullptr;
+			Primitive.bHasMaterial = true;
+			Primitive.MaterialIndex = MaterialIndex;
+		}
+		else if (MaterialIndex != INDEX_NONE)
 		{
 			Primitive.Material = LoadMaterial(MaterialIndex, MaterialsConfig, Primitive.Colors.Num() > 0, Primitive.MaterialName, ForceBaseMaterial);
 			if (!Primitive.Material)
@@ -3492,6 +3683,11 @@ bool FglTFRuntimeParser::LoadPrimitive(TSharedRef<FJsonObject> JsonPrimitiveObje
 				return false;
 			}
 			Primitive.bHasMaterial = true;
+			// materials built over a forced base material cannot be retrieved again by index
+			if (!ForceBaseMaterial)
+			{
+				Primitive.MaterialIndex = MaterialIndex;
+			}
 		}
 		// special case for primitives without a material but with a color buffer
 		else if (Primitive.Colors.Num() > 0)
@@ -4421,11 +4617,27 @@ bool FglTFRuntimeParser::GetBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
 	}
 
 	// first check cache
-	if (BuffersCache.Contains(Index))
 	{
-		Blob.Data = BuffersCache[Index].GetData();
-		Blob.Num = BuffersCache[Index].Num();
-		return true;
+		FReadScopeLock Lock(BuffersCacheLock);
+		if (TArray64<uint8>* CachedBuffer = BuffersCache.Find(Index))
+		{
+			Blob.Data = CachedBuffer->GetData();
+			Blob.Num = CachedBuffer->Num();
+			return true;
+		}
+	}
+
+	// a single thread loads buffers, the others will find them in the cache
+	FScopeLock PopulateLock(&BuffersPopulateLock);
+
+	{
+		FReadScopeLock Lock(BuffersCacheLock);
+		if (TArray64<uint8>* CachedBuffer = BuffersCache.Find(Index))
+		{
+			Blob.Data = CachedBuffer->GetData();
+			Blob.Num = CachedBuffer->Num();
+			return true;
+		}
 	}
 
 	const TArray<TSharedPtr<FJsonValue>>* JsonBuffers;
@@ -4459,235 +4671,335 @@ bool FglTFRuntimeParser::GetBuffer(const int32 Index, FglTFRuntimeBlob& Blob)
 		return false;
 	}
 
+	TArray64<uint8> BufferData;
+	bool bLoaded = false;
+
 	// check it is a valid base64 data uri
 	if (Uri.StartsWith("data:"))
 	{
-		TArray64<uint8> Base64Data;
-		if (ParseBase64Uri(Uri, Base64Data))
+		if (!ParseBase64Uri(Uri, BufferData))
 		{
-			BuffersCache.Add(Index, Base64Data);
-			Blob.Data = BuffersCache[Index].GetData();
-			Blob.Num = BuffersCache[Index].Num();
-			return true;
+			return false;
 		}
-		return false;
+		bLoaded = true;
 	}
 
-	if (Archive)
+	if (!bLoaded && Archive)
 	{
-		TArray64<uint8> ArchiveItemData;
-		if (Archive->GetFileContent(Uri, ArchiveItemData))
-		{
-			BuffersCache.Add(Index, ArchiveItemData);
-			Blob.Data = BuffersCache[Index].GetData();
-			Blob.Num = BuffersCache[Index].Num();
-			return true;
-		}
+		bLoaded = Archive->GetFileContent(Uri, BufferData);
 	}
 
 	// fallback
-	if (!BaseDirectory.IsEmpty())
+	if (!bLoaded && !BaseDirectory.IsEmpty())
 	{
-		TArray64<uint8> FileData;
-		if (FFileHelper::LoadFileToArray(FileData, *FPaths::Combine(BaseDirectory, Uri)))
-		{
-			BuffersCache.Add(Index, FileData);
-			Blob.Data = BuffersCache[Index].GetData();
-			Blob.Num = BuffersCache[Index].Num();
-			return true;
-		}
+		bLoaded = FFileHelper::LoadFileToArray(BufferData, *FPaths::Combine(BaseDirectory, Uri));
 	}
 
-	AddError("GetBuffer()", FString::Printf(TEXT("Unable to load buffer %d from Uri %s (you may want to enable external files loading...)"), Index, *Uri));
-	return false;
-}
-
-bool FglTFRuntimeParser::ParseBase64Uri(const FString& Uri, TArray64<uint8>& Bytes)
-{
-	const FString Base64Signature = ";base64,";
-
-	int32 StringIndex = Uri.Find(Base64Signature, ESearchCase::IgnoreCase, ESearchDir::FromStart, 5);
-
-	if (StringIndex < 5)
-		return false;
-
-	StringIndex += Base64Signature.Len();
-
-	TArray<uint8> BytesBase64;
-
-	bool bSuccess = FBase64::Decode(Uri.Mid(StringIndex), BytesBase64);
-	if (bSuccess)
+	if (!bLoaded)
 	{
-		Bytes.Append(BytesBase64);
+		AddError("GetBuffer()", FString::Printf(TEXT("Unable to load buffer %d from Uri %s (you may want to enable external files loading...)"), Index, *Uri));
+		return false;
 	}
-	return bSuccess;
+
+	// the heap allocation of the array is moved (not copied), so the blob stays valid on rehashing
+	FWriteScopeLock Lock(BuffersCacheLock);
+	TArray64<uint8>& CachedBuffer = BuffersCache.Add(Index, MoveTemp(BufferData));
+	Blob.Data = CachedBuffer.GetData();
+	Blob.Num = CachedBuffer.Num();
+	return true;
 }
 
-bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob, int64& Stride)
+namespace glTFRuntime
 {
-	TSharedPtr<FJsonObject> JsonBufferViewObject = GetJsonObjectFromRootIndex("bufferViews", Index);
-	if (!JsonBufferViewObject)
+	struct FBase64DecodingTable
 	{
-		return false;
-	}
+		uint8 Values[256];
 
-	TSharedPtr<FJsonObject> JsonBufferViewCompressedObject = GetJsonObjectExtension(JsonBufferViewObject.ToSharedRef(), "EXT_meshopt_compression");
-	if (JsonBufferViewCompressedObject)
-	{
-		JsonBufferViewObject = JsonBufferViewCompressedObject;
-		if (CompressedBufferViewsCache.Contains(Index))
+		FBase64DecodingTable()
 		{
-			Blob.Data = CompressedBufferViewsCache[Index].GetData();
-			Blob.Num = CompressedBufferViewsCache[Index].Num();
-			Stride = CompressedBufferViewsStridesCache[Index];
-			return true;
+			FMemory::Memset(Values, 0xFF, sizeof(Values));
+			const ANSICHAR* Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (int32 Index = 0; Index < 64; Index++)
+			{
+				Values[static_cast<uint8>(Alphabet[Index])] = static_cast<uint8>(Index);
+			}
+			// base64url variant
+			Values['-'] = 62;
+			Values['_'] = 63;
 		}
-	}
+	};
 
-	int64 BufferIndex;
-	if (!JsonBufferViewObject->TryGetNumberField(TEXT("buffer"), BufferIndex))
+	// invalid chars have the two high bits set
+	FORCEINLINE uint32 DecodeBase64Char(const FBase64DecodingTable& DecodingTable, const TCHAR Char)
 	{
-		return false;
+		const uint32 Code = static_cast<uint32>(Char);
+		return Code < 256 ? DecodingTable.Values[Code] : 0xFF;
 	}
 
-	FglTFRuntimeBlob BufferBlob;
-	if (!GetBuffer(BufferIndex, BufferBlob))
+	bool DecodeBase64Blocks(const FBase64DecodingTable& DecodingTable, const TCHAR* Source, const int64 BlocksNum, uint8* Output)
 	{
-		return false;
-	}
+		for (int64 BlockIndex = 0; BlockIndex < BlocksNum; BlockIndex++)
+		{
+			const uint32 A = DecodeBase64Char(DecodingTable, Source[0]);
+			const uint32 B = DecodeBase64Char(DecodingTable, Source[1]);
+			const uint32 C = DecodeBase64Char(DecodingTable, Source[2]);
+			const uint32 D = DecodeBase64Char(DecodingTable, Source[3]);
+			if ((A | B | C | D) & 0xC0)
+			{
+				return false;
+			}
 
-	int64 ByteLength;
-	if (!JsonBufferViewObject->TryGetNumberField(TEXT("byteLength"), ByteLength))
-	{
-		return false;
-	}
+			const uint32 Triple = (A << 18) | (B << 12) | (C << 6) | D;
+			Output[0] = static_cast<uint8>(Triple >> 16);
+			Output[1] = static_cast<uint8>(Triple >> 8);
+			Output[2] = static_cast<uint8>(Triple);
 
-	int64 ByteOffset;
-	if (!JsonBufferViewObject->TryGetNumberField(TEXT("byteOffset"), ByteOffset))
-	{
-		ByteOffset = 0;
-	}
+			Source += 4;
+			Output += 3;
+		}
 
-	if (!JsonBufferViewObject->TryGetNumberField(TEXT("byteStride"), Stride))
-	{
-		Stride = 0;
+		return true;
 	}
 
-	if (ByteOffset + ByteLength > BufferBlob.Num)
+	/*
+	* Decodes the base64 string directly into the destination array (appending to it).
+	* Big payloads are split in chunks decoded in parallel.
+	*/
+	bool DecodeBase64(const TCHAR* Source, const int64 SourceNum, TArray64<uint8>& Bytes)
 	{
-		return false;
-	}
+		static const FBase64DecodingTable DecodingTable;
 
-	Blob.Data = BufferBlob.Data + ByteOffset;
-	Blob.Num = ByteLength;
+		int64 Len = SourceNum;
+		while (Len > 0 && Source[Len - 1] == '=')
+		{
+			Len--;
+		}
 
-	if (JsonBufferViewCompressedObject)
-	{
-		// decompress bitstream
-		if (Stride == 0)
+		const int64 Remaining = Len % 4;
+		if (SourceNum - Len > 2 || Remaining == 1)
 		{
 			return false;
 		}
-		int64 Elements;
-		if (!JsonBufferViewObject->TryGetNumberField(TEXT("count"), Elements))
+
+		const int64 BlocksNum = Len / 4;
+		const int64 DecodedSize = BlocksNum * 3 + (Remaining > 0 ? Remaining - 1 : 0);
+
+		const int64 Offset = Bytes.Num();
+		Bytes.AddUninitialized(DecodedSize);
+		uint8* Output = Bytes.GetData() + Offset;
+
+		constexpr int64 BlocksPerChunk = 64 * 1024;
+		const int64 ChunksNum = (BlocksNum + BlocksPerChunk - 1) / BlocksPerChunk;
+
+		bool bSuccess = true;
+		if (ChunksNum > 1)
 		{
-			return false;
+			TArray<bool> ChunksSuccess;
+			ChunksSuccess.AddZeroed(static_cast<int32>(ChunksNum));
+			ParallelFor(static_cast<int32>(ChunksNum), [&](const int32 ChunkIndex)
+				{
+					const int64 FirstBlock = ChunkIndex * BlocksPerChunk;
+					const int64 ChunkBlocksNum = FMath::Min(BlocksPerChunk, BlocksNum - FirstBlock);
+					ChunksSuccess[ChunkIndex] = DecodeBase64Blocks(DecodingTable, Source + FirstBlock * 4, ChunkBlocksNum, Output + FirstBlock * 3);
+				});
+			bSuccess = !ChunksSuccess.Contains(false);
 		}
-		FString MeshOptMode;
-		if (!JsonBufferViewObject->TryGetStringField(TEXT("mode"), MeshOptMode))
+		else
 		{
-			return false;
+			bSuccess = DecodeBase64Blocks(DecodingTable, Source, BlocksNum, Output);
 		}
-		FString MeshOptFilter;
-		if (!JsonBufferViewObject->TryGetStringField(TEXT("filter"), MeshOptFilter))
+
+		if (bSuccess && Remaining > 0)
 		{
-			MeshOptFilter = "NONE";
+			const TCHAR* Tail = Source + BlocksNum * 4;
+			uint8* TailOutput = Output + BlocksNum * 3;
+			const uint32 A = DecodeBase64Char(DecodingTable, Tail[0]);
+			const uint32 B = DecodeBase64Char(DecodingTable, Tail[1]);
+			const uint32 C = Remaining > 2 ? DecodeBase64Char(DecodingTable, Tail[2]) : 0;
+			if ((A | B | C) & 0xC0)
+			{
+				bSuccess = false;
+			}
+			else
+			{
+				const uint32 Triple = (A << 18) | (B << 12) | (C << 6);
+				TailOutput[0] = static_cast<uint8>(Triple >> 16);
+				if (Remaining > 2)
+				{
+					TailOutput[1] = static_cast<uint8>(Triple >> 8);
+				}
+			}
 		}
 
-		CompressedBufferViewsCache.Add(Index);
-		if (!DecompressMeshOptimizer(Blob, Stride, Elements, MeshOptMode, MeshOptFilter, CompressedBufferViewsCache[Index]))
+		if (!bSuccess)
 		{
-			CompressedBufferViewsCache.Remove(Index);
-			return false;
+			Bytes.SetNum(Offset);
 		}
-		Blob.Data = CompressedBufferViewsCache[Index].GetData();
-		Blob.Num = CompressedBufferViewsCache[Index].Num();
-		CompressedBufferViewsStridesCache.Add(Index, Stride);
-	}
 
-	return true;
+		return bSuccess;
+	}
 }
 
-bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, int64& Stride, int64& Elements, int64& ElementSize, int64& Count, bool& bNormalized, FglTFRuntimeBlob& Blob, const FglTFRuntimeBlob* AdditionalBufferView)
+bool FglTFRuntimeParser::ParseBase64Uri(const FString& Uri, TArray64<uint8>& Bytes)
 {
+	const FString Base64Signature = ";base64,";
 
-	TSharedPtr<FJsonObject> JsonAccessorObject = GetJsonObjectFromRootIndex("accessors", Index);
-	if (!JsonAccessorObject)
+	int32 StringIndex = Uri.Find(Base64Signature, ESearchCase::IgnoreCase, ESearchDir::FromStart, 5);
+
+	if (StringIndex < 5)
+		return false;
+
+	StringIndex += Base64Signature.Len();
+
+	// decode in place, without intermediate copies of the (potentially huge) payload
+	return glTFRuntime::DecodeBase64(*Uri + StringIndex, Uri.Len() - StringIndex, Bytes);
+}
+
+bool FglTFRuntimeParser::GetBufferView(const int32 Index, FglTFRuntimeBlob& Blob, int64& Stride)
+{
+	if (!BufferViewsDescs.IsValidIndex(Index))
 	{
 		return false;
 	}
 
-	bool bInitWithZeros = false;
-	bool bHasSparse = false;
+	const FglTFRuntimeBufferViewDesc& BufferViewDesc = BufferViewsDescs[Index];
 
-	int64 BufferViewIndex = INDEX_NONE;
-	int64 ByteOffset = 0;
-
-	if (!AdditionalBufferView)
+	if (BufferViewDesc.bMeshoptCompressed)
 	{
-		if (!JsonAccessorObject->TryGetNumberField(TEXT("bufferView"), BufferViewIndex))
+		auto FindCompressedBufferView = [this, Index, &Blob, &Stride]()
+			{
+				FReadScopeLock Lock(BufferViewsCacheLock);
+				TArray64<uint8>* CachedBufferView = CompressedBufferViewsCache.Find(Index);
+				if (!CachedBufferView)
+				{
+					return false;
+				}
+				Blob.Data = CachedBufferView->GetData();
+				Blob.Num = CachedBufferView->Num();
+				Stride = CompressedBufferViewsStridesCache[Index];
+				return true;
+			};
+
+		if (FindCompressedBufferView())
 		{
-			bInitWithZeros = true;
+			return true;
+		}
+
+		// a single thread decompresses bufferViews, the others will find them in the cache
+		FScopeLock PopulateLock(&BufferViewsPopulateLock);
+
+		// decompress all of the meshopt bufferViews in parallel at the first access
+		if (!bMeshoptBufferViewsDecompressed)
+		{
+			DecompressMeshOptimizerBufferViews();
+		}
+
+		if (FindCompressedBufferView())
+		{
+			return true;
+		}
+
+		// decompress bitstream
+		if (!BufferViewDesc.bValid || BufferViewDesc.ByteStride == 0)
+		{
+			return false;
+		}
+
+		FglTFRuntimeBlob BufferBlob;
+		if (!GetBuffer(BufferViewDesc.Buffer, BufferBlob))
+		{
+			return false;
+		}
+
+		if (BufferViewDesc.ByteOffset + BufferViewDesc.ByteLength > BufferBlob.Num)
+		{
+			return false;
 		}
 
+		FglTFRuntimeBlob CompressedBlob;
+		CompressedBlob.Data = BufferBlob.Data + BufferViewDesc.ByteOffset;
+		CompressedBlob.Num = BufferViewDesc.ByteLength;
 
-		if (!JsonAccessorObject->TryGetNumberField(TEXT("byteOffset"), ByteOffset))
+		TArray64<uint8> UncompressedBytes;
+		if (!DecompressMeshOptimizer(CompressedBlob, BufferViewDesc.ByteStride, BufferViewDesc.MeshoptCount, BufferViewDesc.MeshoptMode, BufferViewDesc.MeshoptFilter, UncompressedBytes))
 		{
-			ByteOffset = 0;
+			return false;
 		}
+
+		FWriteScopeLock Lock(BufferViewsCacheLock);
+		TArray64<uint8>& CachedBufferView = CompressedBufferViewsCache.Add(Index, MoveTemp(UncompressedBytes));
+		CompressedBufferViewsStridesCache.Add(Index, BufferViewDesc.ByteStride);
+		Blob.Data = CachedBufferView.GetData();
+		Blob.Num = CachedBufferView.Num();
+		Stride = BufferViewDesc.ByteStride;
+		return true;
 	}
 
-	const TSharedPtr<FJsonObject>* JsonSparseObject = nullptr;
-	if (JsonAccessorObject->TryGetObjectField(TEXT("sparse"), JsonSparseObject))
+	if (!BufferViewDesc.bValid)
 	{
-		bHasSparse = true;
+		return false;
 	}
 
-	const bool bOriginalNormalized = bNormalized;
-
-	if (!JsonAccessorObject->TryGetBoolField(TEXT("normalized"), bNormalized))
+	FglTFRuntimeBlob BufferBlob;
+	if (!GetBuffer(BufferViewDesc.Buffer, BufferBlob))
 	{
-		bNormalized = bOriginalNormalized;
+		return false;
 	}
 
-	if (!JsonAccessorObject->TryGetNumberField(TEXT("componentType"), ComponentType))
+	Stride = BufferViewDesc.ByteStride;
+
+	if (BufferViewDesc.ByteOffset + BufferViewDesc.ByteLength > BufferBlob.Num)
 	{
 		return false;
 	}
 
-	if (!JsonAccessorObject->TryGetNumberField(TEXT("count"), Count))
+	Blob.Data = BufferBlob.Data + BufferViewDesc.ByteOffset;
+	Blob.Num = BufferViewDesc.ByteLength;
+
+	return true;
+}
+
+bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, int64& Stride, int64& Elements, int64& ElementSize, int64& Count, bool& bNormalized, FglTFRuntimeBlob& Blob, const FglTFRuntimeBlob* AdditionalBufferView)
+{
+	if (!AccessorsDescs.IsValidIndex(Index))
 	{
 		return false;
 	}
 
-	FString Type;
-	if (!JsonAccessorObject->TryGetStringField(TEXT("type"), Type))
+	const FglTFRuntimeAccessorDesc& AccessorDesc = AccessorsDescs[Index];
+
+	bool bInitWithZeros = false;
+	const bool bHasSparse = AccessorDesc.bHasSparse;
+
+	int64 BufferViewIndex = INDEX_NONE;
+	int64 ByteOffset = 0;
+
+	if (!AdditionalBufferView)
 	{
-		return false;
+		BufferViewIndex = AccessorDesc.BufferView;
+		if (BufferViewIndex == INDEX_NONE)
+		{
+			bInitWithZeros = true;
+		}
+
+		ByteOffset = AccessorDesc.ByteOffset;
 	}
 
-	ElementSize = GetComponentTypeSize(ComponentType);
-	if (ElementSize == 0)
+	if (AccessorDesc.bHasNormalized)
 	{
-		return false;
+		bNormalized = AccessorDesc.bNormalized;
 	}
 
-	Elements = GetTypeSize(Type);
-	if (Elements == 0)
+	if (!AccessorDesc.bValid)
 	{
 		return false;
 	}
 
+	ComponentType = AccessorDesc.ComponentType;
+	Count = AccessorDesc.Count;
+	ElementSize = AccessorDesc.ElementSize;
+	Elements = AccessorDesc.Elements;
+
 	int64 FinalSize = ElementSize * Elements * Count;
 
 	if (AdditionalBufferView)
@@ -4714,11 +5026,16 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 	else if (bInitWithZeros)
 	{
 
-		if (ZeroBuffer.Num() < FinalSize)
 		{
-			ZeroBuffer.AddZeroed(FinalSize - ZeroBuffer.Num());
+			FWriteScopeLock Lock(AccessorsCacheLock);
+			if (ZeroBuffers.Num() == 0 || ZeroBuffers.Last().Num() < FinalSize)
+			{
+				// older blocks are kept alive, other threads could still be reading them
+				const int64 ZeroBufferSize = ZeroBuffers.Num() > 0 ? FMath::Max<int64>(FinalSize, ZeroBuffers.Last().Num() * 2) : FinalSize;
+				ZeroBuffers.AddDefaulted_GetRef().AddZeroed(ZeroBufferSize);
+			}
+			Blob.Data = ZeroBuffers.Last().GetData();
 		}
-		Blob.Data = ZeroBuffer.GetData();
 		Blob.Num = FinalSize;
 		if (!bHasSparse)
 		{
@@ -4764,14 +5081,45 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 		}
 	}
 
-	if (SparseAccessorsCache.Contains(Index))
+	auto FindSparseAccessor = [this, Index, &Blob, &Stride]()
+		{
+			FReadScopeLock Lock(AccessorsCacheLock);
+			TArray64<uint8>* CachedSparseAccessor = SparseAccessorsCache.Find(Index);
+			if (!CachedSparseAccessor)
+			{
+				return false;
+			}
+			Stride = SparseAccessorsStridesCache[Index];
+			Blob.Data = CachedSparseAccessor->GetData();
+			Blob.Num = CachedSparseAccessor->Num();
+			return true;
+		};
+
+	if (FindSparseAccessor())
+	{
+		return true;
+	}
+
+	// a single thread applies sparse values, the others will find them in the cache
+	FScopeLock PopulateLock(&AccessorsPopulateLock);
+
+	if (FindSparseAccessor())
 	{
-		Stride = SparseAccessorsStridesCache[Index];
-		Blob.Data = SparseAccessorsCache[Index].GetData();
-		Blob.Num = SparseAccessorsCache[Index].Num();
 		return true;
 	}
 
+	TSharedPtr<FJsonObject> JsonAccessorObject = GetJsonObjectFromRootIndex("accessors", Index);
+	if (!JsonAccessorObject)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* JsonSparseObject = nullptr;
+	if (!JsonAccessorObject->TryGetObjectField(TEXT("sparse"), JsonSparseObject))
+	{
+		return false;
+	}
+
 	int64 SparseCount;
 	if (!(*JsonSparseObject)->TryGetNumberField(TEXT("count"), SparseCount))
 	{
@@ -4886,9 +5234,8 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 
 	Stride = SparseBufferViewValuesStride;
 
-	SparseAccessorsCache.Add(Index);
-	SparseAccessorsStridesCache.Add(Index, Stride);
-	TArray64<uint8>& SparseData = SparseAccessorsCache[Index];
+	// patch a private copy, it is published only when complete
+	TArray64<uint8> SparseData;
 	SparseData.Append(Blob.Data, Blob.Num);
 
 	for (int32 IndexToChange = 0; IndexToChange < SparseCount; IndexToChange++)
@@ -4904,7 +5251,9 @@ bool FglTFRuntimeParser::GetAccessor(const int32 Index, int64& ComponentType, in
 		FMemory::Memcpy(OriginalValuePtr, NewValuePtr, SparseBufferViewValuesStride);
 	}
 
-	Blob.Data = SparseData.GetData();
+	FWriteScopeLock Lock(AccessorsCacheLock);
+	SparseAccessorsStridesCache.Add(Index, Stride);
+	Blob.Data = SparseAccessorsCache.Add(Index, MoveTemp(SparseData)).GetData();
 
 	return true;
 }
@@ -4954,12 +5303,15 @@ int64 FglTFRuntimeParser::GetTypeSize(const FString& Type) const
 
 void FglTFRuntimeParser::AddReferencedObjects(FReferenceCollector& Collector)
 {
+	FReadScopeLock Lock(ObjectsCacheLock);
 	Collector.AddReferencedObjects(StaticMeshesCache);
 	Collector.AddReferencedObjects(MaterialsCache);
 	Collector.AddReferencedObjects(SkeletonsCache);
 	Collector.AddReferencedObjects(SkeletalMeshesCache);
 	Collector.AddReferencedObjects(TexturesCache);
-	Collector.AddReferencedObjects(MaterialsNameCache);
+	Collector.AddReferencedObjects(CanonicalMaterialsCache);
+	Collector.AddReferencedObjects(AtlasMaterialsCache);
+	Collector.AddReferencedObjects(AtlasTexturesCache);
 	Collector.AddReferencedObjects(MetallicRoughnessMaterialsMap);
 	Collector.AddReferencedObjects(SpecularGlossinessMaterialsMap);
 	Collector.AddReferencedObjects(UnlitMaterialsMap);
@@ -4969,17 +5321,27 @@ void FglTFRuntimeParser::AddReferencedObjects(FReferenceCollector& Collector)
 
 void FglTFRuntimeParser::ClearCache()
 {
+	FWriteScopeLock Lock(ObjectsCacheLock);
 	StaticMeshesCache.Empty();
 	MaterialsCache.Empty();
 	SkeletonsCache.Empty();
 	SkeletalMeshesCache.Empty();
 	TexturesCache.Empty();
+	CanonicalMaterialsCache.Empty();
 	MaterialsNameCache.Empty();
+	AtlasMaterialsCache.Empty();
+	AtlasTexturesCache.Empty();
+	AtlasLayoutsCache.Empty();
 	MetallicRoughnessMaterialsMap.Empty();
 	SpecularGlossinessMaterialsMap.Empty();
 	UnlitMaterialsMap.Empty();
 	TransmissionMaterialsMap.Empty();
 	ClearCoatMaterialsMap.Empty();
+	TexturesVariantsCache.Empty();
+
+	FScopeLock DecodedImagesLock(&DecodedImagesCacheLock);
+	DecodedImagesCache.Empty();
+	ImagesRemainingReferences.Empty();
 }
 
 float FglTFRuntimeParser::FindBestFrames(const TArray<float>& FramesTimes, float WantedTime, int32& FirstIndex, int32& SecondIndex)
@@ -5074,6 +5436,7 @@ bool FglTFRuntimeParser::MergePrimitives(TArray<FglTFRuntimePrimitive> SourcePri
 	for (FglTFRuntimePrimitive& SourcePrimitive : SourcePrimitives)
 	{
 		OutPrimitive.Material = SourcePrimitive.Material;
+		OutPrimitive.MaterialIndex = SourcePrimitive.MaterialIndex;
 
 		// TODO the logic here is available only for staticmeshes loaded as skeletal ones.
 		// It should be improved to support plain recursive loading of skeletalmeshes
@@ -5093,6 +5456,10 @@ bool FglTFRuntimeParser::MergePrimitives(TArray<FglTFRuntimePrimitive> SourcePri
 			OutPrimitive.Joints = SourcePrimitive.Joints;
 			OutPrimitive.Weights = SourcePrimitive.Weights;
 			OutPrimitive.MorphTargets = SourcePrimitive.MorphTargets;
+			for (FglTFRuntimeMorphTarget& MorphTarget : OutPrimitive.MorphTargets)
+			{
+				MorphTarget.Compact();
+			}
 		}
 		else
 		{
@@ -5113,8 +5480,8 @@ bool FglTFRuntimeParser::MergePrimitives(TArray<FglTFRuntimePrimitive> SourcePri
 
 			for (int32 MorphTargetsIndex = 0; MorphTargetsIndex < OutPrimitive.MorphTargets.Num(); MorphTargetsIndex++)
 			{
-				OutPrimitive.MorphTargets[MorphTargetsIndex].Positions.Append(SourcePrimitive.MorphTargets[MorphTargetsIndex].Positions);
-				OutPrimitive.MorphTargets[MorphTargetsIndex].Normals.Append(SourcePrimitive.MorphTargets[MorphTargetsIndex].Normals);
+				SourcePrimitive.MorphTargets[MorphTargetsIndex].Compact();
+				OutPrimitive.MorphTargets[MorphTargetsIndex].AppendSparse(SourcePrimitive.MorphTargets[MorphTargetsIndex], BaseIndex);
 			}
 		}
 
@@ -5810,20 +6177,21 @@ const FglTFRuntimeBlob* FglTFRuntimeParser::GetAdditionalBufferView(const int64
 		return nullptr;
 	}
 
-	const TMap<FString, FglTFRuntimeBlob>* Value = AdditionalBufferViewsCache.Find(Index);
+	FReadScopeLock Lock(AdditionalBufferViewsLock);
+
+	const TMap<FString, TSharedPtr<FglTFRuntimeBlob>>* Value = AdditionalBufferViewsCache.Find(Index);
 	if (!Value)
 	{
 		return nullptr;
 	}
 
-	if (!Value->Contains(Name))
+	const TSharedPtr<FglTFRuntimeBlob>* Blob = Value->Find(Name);
+	if (!Blob)
 	{
 		return nullptr;
 	}
 
-	const FglTFRuntimeBlob& Blob = (*Value)[Name];
-
-	return &Blob;
+	return Blob->Get();
 }
 
 void FglTFRuntimeParser::AddAdditionalBufferView(const int64 Index, const FString& Name, const FglTFRuntimeBlob& Blob)
@@ -5833,20 +6201,16 @@ void FglTFRuntimeParser::AddAdditionalBufferView(const int64 Index, const FStrin
 		return;
 	}
 
-	if (!AdditionalBufferViewsCache.Contains(Index))
-	{
-		AdditionalBufferViewsCache.Add(Index);
-	}
+	FWriteScopeLock Lock(AdditionalBufferViewsLock);
 
-	if (!AdditionalBufferViewsCache[Index].Contains(Name))
+	// blobs are heap allocated, so the pointers returned by GetAdditionalBufferView survive rehashing;
+	// a published blob is never modified, replacing it swaps in a new one and retires the old (readers may still hold it)
+	TSharedPtr<FglTFRuntimeBlob>& CachedBlob = AdditionalBufferViewsCache.FindOrAdd(Index).FindOrAdd(Name);
+	if (CachedBlob)
 	{
-		AdditionalBufferViewsCache[Index].Add(Name, Blob);
+		AdditionalBufferViewsRetired.Add(CachedBlob);
 	}
-	else
-	{
-		AdditionalBufferViewsCache[Index][Name] = Blob;
-	}
-
+	CachedBlob = MakeShared<FglTFRuntimeBlob>(Blob);
 }
 
 bool FglTFRuntimeParser::GetNumberFromExtras(const FString& Key, float& Value) const
@@ -5977,28 +6341,29 @@ TSharedPtr<FJsonObject> FglTFRuntimeParser::GetNodeObject(const int32 NodeIndex)
 	return GetJsonObjectFromRootIndex("nodes", NodeIndex);
 }
 
-bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes)
+namespace glTFRuntime
 {
-	auto DecodeZigZag = [](const uint8 V)
-		{
-			return ((V & 1) != 0) ? ~(V >> 1) : (V >> 1);
-		};
+	FORCEINLINE uint8 DecodeMeshOptimizerZigZag(const uint8 V)
+	{
+		return static_cast<uint8>(((V & 1) != 0) ? ~(V >> 1) : (V >> 1));
+	}
 
 	// refactored in april 2024 to be more compliant with https://www.npmjs.com/package/meshoptimize
-	if (Mode == "ATTRIBUTES" && Blob.Num > 32 && Blob.Data[0] == 0xa0)
+	bool DecodeMeshOptimizerAttributes(const uint8* Data, const int64 DataNum, const int64 Stride, const int64 Elements, uint8* Output)
 	{
 		const int64 MaxBlockElements = FMath::Min<int64>((8192 / Stride) & ~15, 256);
-		TArray<uint8, TInlineAllocator<16>> Deltas;
-		Deltas.AddZeroed(16);
+		if (MaxBlockElements <= 0)
+		{
+			return false;
+		}
 
-		TArray<uint8> TempData;
-		TempData.Append(Blob.Data + Blob.Num - Stride, Stride);
+		uint8 Deltas[16];
 
-		int64 Offset = 1;
-		const int64 Limit = Blob.Num - Stride;
+		TArray<uint8, TInlineAllocator<256>> TempData;
+		TempData.Append(Data + DataNum - Stride, Stride);
 
-		// preallocated output
-		UncompressedBytes.AddUninitialized(Elements * Stride);
+		int64 Offset = 1;
+		const int64 Limit = DataNum - Stride;
 
 		for (int64 ElementIndex = 0; ElementIndex < Elements; ElementIndex += MaxBlockElements)
 		{
@@ -6010,48 +6375,56 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 
 			for (int64 ElementByteIndex = 0; ElementByteIndex < Stride; ElementByteIndex++)
 			{
-
 				if (Offset + NumberOfHeaderBytes > Limit)
 				{
 					return false;
 				}
 
-				int64 HeaderOffset = Offset;
+				const uint8* Header = Data + Offset;
 				Offset += NumberOfHeaderBytes;
 
+				uint8 Value = TempData[ElementByteIndex];
+
 				for (int64 GroupIndex = 0; GroupIndex < GroupCount; GroupIndex++)
 				{
-					const uint8 ModeValue = (Blob.Data[HeaderOffset] >> ((GroupIndex & 0x03) << 1)) & 0x03;
-					if ((GroupIndex & 0x03) == 0x03)
-					{
-						HeaderOffset++;
-					}
+					const uint8 ModeValue = (Header[GroupIndex >> 2] >> ((GroupIndex & 0x03) << 1)) & 0x03;
+
+					const int64 DestinationElementGroup = ElementIndex + (GroupIndex << 4);
+					const int64 GroupElements = FMath::Min<int64>(16, Elements - DestinationElementGroup);
+					uint8* Destination = Output + DestinationElementGroup * Stride + ElementByteIndex;
 
+					// all deltas are zero, just replicate the last value
 					if (ModeValue == 0)
 					{
-						FMemory::Memset(Deltas.GetData(), 0, 16);
+						for (int64 Index = 0; Index < GroupElements; Index++)
+						{
+							*Destination = Value;
+							Destination += Stride;
+						}
+						continue;
 					}
-					else if (ModeValue == 1)
+
+					if (ModeValue == 1)
 					{
 						if (Offset + 4 > Limit)
 						{
 							return false;
 						}
 
-						const int64 BaseOffset = Offset;
+						const uint8* Bits = Data + Offset;
 						Offset += 4;
 
 						for (int64 Index = 0; Index < 16; Index++)
 						{
 							const int64 Shift = (6 - ((Index & 0x03) << 1));
-							uint8 Delta = (Blob.Data[BaseOffset + (Index >> 2)] >> Shift) & 0x03;
+							uint8 Delta = (Bits[Index >> 2] >> Shift) & 0x03;
 							if (Delta == 3)
 							{
 								if (Offset + 1 > Limit)
 								{
 									return false;
 								}
-								Delta = Blob.Data[Offset++];
+								Delta = Data[Offset++];
 							}
 							Deltas[Index] = Delta;
 						}
@@ -6063,103 +6436,123 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 							return false;
 						}
 
-						const int64 BaseOffset = Offset;
+						const uint8* Bits = Data + Offset;
 						Offset += 8;
 
 						for (int64 Index = 0; Index < 16; Index++)
 						{
 							const int64 Shift = (Index & 0x01) ? 0 : 4;
-							uint8 Delta = (Blob.Data[BaseOffset + (Index >> 1)] >> Shift) & 0x0f;
+							uint8 Delta = (Bits[Index >> 1] >> Shift) & 0x0f;
 							if (Delta == 0xf)
 							{
 								if (Offset + 1 > Limit)
 								{
 									return false;
 								}
-								Delta = Blob.Data[Offset++];
+								Delta = Data[Offset++];
 							}
 							Deltas[Index] = Delta;
 						}
 					}
-					else if (ModeValue == 3)
+					else
 					{
 						if (Offset + 16 > Limit)
 						{
 							return false;
 						}
-						FMemory::Memcpy(Deltas.GetData(), Blob.Data + Offset, 16);
+						FMemory::Memcpy(Deltas, Data + Offset, 16);
 						Offset += 16;
 					}
 
-					const int64 DestinationElementGroup = ElementIndex + (GroupIndex << 4);
-
-					for (int64 Index = 0; Index < 16; Index++)
+					for (int64 Index = 0; Index < GroupElements; Index++)
 					{
-						const int64 DestinationElementIndex = DestinationElementGroup + Index;
-						if (DestinationElementIndex >= Elements)
-						{
-							break;
-						}
-
-						const uint8 Delta = DecodeZigZag(Deltas[Index]);
-						TempData[ElementByteIndex] += Delta;
-						UncompressedBytes[DestinationElementIndex * Stride + ElementByteIndex] = TempData[ElementByteIndex];
+						Value += DecodeMeshOptimizerZigZag(Deltas[Index]);
+						*Destination = Value;
+						Destination += Stride;
 					}
-
 				}
+
+				TempData[ElementByteIndex] = Value;
 			}
 		}
+
+		return true;
 	}
-	else if (Mode == "TRIANGLES" && Blob.Num >= 17 && Blob.Data[0] == 0xe1 && (Stride == 2 || Stride == 4) && ((Elements % 3) == 0))
+
+	bool DecodeMeshOptimizerTriangles(const uint8* Data, const int64 DataNum, const int64 Stride, const int64 Elements, uint8* Output)
 	{
-		TArray<uint8> CodeAux;
-		const int64 Limit = Blob.Num - 16;
-		CodeAux.Append(Blob.Data + Limit, 16);
+		const int64 Limit = DataNum - 16;
+		const uint8* CodeAux = Data + Limit;
 
 		uint32 Next = 0;
 		uint32 Last = 0;
-		TArray<TPair<uint32, uint32>> EdgeFifo;
-		TArray<uint32> VertexFifo;
+
+		// the encoder never references more than the last 16 edges/vertices, so ring buffers are enough
+		uint32 EdgeFifo[16][2];
+		int32 EdgeFifoOffset = 0;
+		int32 EdgeFifoNum = 0;
+		uint32 VertexFifo[16];
+		int32 VertexFifoOffset = 0;
+		int32 VertexFifoNum = 0;
+
+		auto PushEdge = [&EdgeFifo, &EdgeFifoOffset, &EdgeFifoNum](const uint32 A, const uint32 B)
+			{
+				EdgeFifo[EdgeFifoOffset][0] = A;
+				EdgeFifo[EdgeFifoOffset][1] = B;
+				EdgeFifoOffset = (EdgeFifoOffset + 1) & 15;
+				EdgeFifoNum = FMath::Min(EdgeFifoNum + 1, 16);
+			};
+
+		auto GetEdge = [&EdgeFifo, &EdgeFifoOffset, &EdgeFifoNum](const int32 Index, uint32& A, uint32& B) -> bool
+			{
+				if (Index >= EdgeFifoNum)
+				{
+					return false;
+				}
+				const int32 Slot = (EdgeFifoOffset - 1 - Index) & 15;
+				A = EdgeFifo[Slot][0];
+				B = EdgeFifo[Slot][1];
+				return true;
+			};
+
+		auto PushVertex = [&VertexFifo, &VertexFifoOffset, &VertexFifoNum](const uint32 V)
+			{
+				VertexFifo[VertexFifoOffset] = V;
+				VertexFifoOffset = (VertexFifoOffset + 1) & 15;
+				VertexFifoNum = FMath::Min(VertexFifoNum + 1, 16);
+			};
+
+		auto GetVertex = [&VertexFifo, &VertexFifoOffset, &VertexFifoNum](const int32 Index, uint32& V) -> bool
+			{
+				if (Index >= VertexFifoNum)
+				{
+					return false;
+				}
+				V = VertexFifo[(VertexFifoOffset - 1 - Index) & 15];
+				return true;
+			};
 
 		int64 Offset = 1;
-		const uint32 TrianglesNum = Elements / 3;
+		const int64 TrianglesNum = Elements / 3;
 		int64 DataOffset = Offset + TrianglesNum;
-		int64 TriangleOffset = 0;
-
-		UncompressedBytes.AddUninitialized(Elements * Stride);
 
-		auto EmitTriangle = [Stride, &TriangleOffset, &UncompressedBytes](const uint32 A, const uint32 B, const uint32 C)
+		auto EmitTriangle = [Stride, &Output](const uint32 A, const uint32 B, const uint32 C)
 			{
 				if (Stride == 2)
 				{
-					const uint16 AShort = A;
-					const uint16 BShort = B;
-					const uint16 CShort = C;
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&AShort)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&AShort)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&BShort)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&BShort)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&CShort)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&CShort)[1];
+					const uint16 Triangle[3] = { static_cast<uint16>(A), static_cast<uint16>(B), static_cast<uint16>(C) };
+					FMemory::Memcpy(Output, Triangle, sizeof(Triangle));
+					Output += sizeof(Triangle);
 				}
 				else
 				{
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[2];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&A)[3];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[2];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&B)[3];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[0];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[1];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[2];
-					UncompressedBytes[TriangleOffset++] = reinterpret_cast<const uint8*>(&C)[3];
+					const uint32 Triangle[3] = { A, B, C };
+					FMemory::Memcpy(Output, Triangle, sizeof(Triangle));
+					Output += sizeof(Triangle);
 				}
 			};
 
-		auto DecodeIndex = [&Blob, &DataOffset, &Last, Limit]() -> bool
+		auto DecodeIndex = [Data, &DataOffset, &Last, Limit]() -> bool
 			{
 				uint32 V = 0;
 				for (int32 Shift = 0; ; Shift += 7)
@@ -6169,7 +6562,7 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 						return false;
 					}
 
-					const uint32 Byte = Blob.Data[DataOffset++];
+					const uint32 Byte = Data[DataOffset++];
 					V |= (Byte & 0x7F) << Shift;
 
 					if (Byte < 0x80)
@@ -6184,106 +6577,66 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 				return true;
 			};
 
-		for (uint32 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex++)
+		for (int64 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex++)
 		{
 			if (Offset >= Limit)
 			{
 				return false;
 			}
-			uint8 Code = Blob.Data[Offset++];
-			uint8 NibbleLeft = Code >> 4;
-			uint8 NibbleRight = Code & 0x0f;
+			const uint8 Code = Data[Offset++];
+			const uint8 NibbleLeft = Code >> 4;
+			const uint8 NibbleRight = Code & 0x0f;
 
-			if (NibbleLeft < 0xf && NibbleRight == 0) // 0xX0
+			if (NibbleLeft < 0xf)
 			{
-				if (NibbleLeft >= EdgeFifo.Num())
+				uint32 A = 0;
+				uint32 B = 0;
+				if (!GetEdge(NibbleLeft, A, B))
 				{
 					return false;
 				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-				const uint32 C = Next++;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
 
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight > 0 && NibbleRight < 0x0d) // 0xXY
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
+				uint32 C = 0;
+				bool bNewVertex = true;
+				if (NibbleRight == 0) // 0xX0
 				{
-					return false;
+					C = Next++;
 				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				if (NibbleRight >= VertexFifo.Num())
+				else if (NibbleRight < 0x0d) // 0xXY
 				{
-					return false;
+					if (!GetVertex(NibbleRight, C))
+					{
+						return false;
+					}
+					bNewVertex = false;
 				}
-
-				const uint32 C = VertexFifo[NibbleRight];
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight == 0x0d) // 0xXd
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
+				else if (NibbleRight == 0x0d) // 0xXd
 				{
-					return false;
+					C = --Last;
 				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				const uint32 C = Last - 1;
-				Last = C;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight == 0x0e) // 0xXe
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
+				else if (NibbleRight == 0x0e) // 0xXe
 				{
-					return false;
+					C = ++Last;
 				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
-
-				const uint32 C = Last + 1;
-				Last = C;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
-			}
-			else if (NibbleLeft < 0xf && NibbleRight == 0x0f) // 0xXf
-			{
-				if (NibbleLeft >= EdgeFifo.Num())
+				else // 0xXf
 				{
-					return false;
+					if (!DecodeIndex())
+					{
+						return false;
+					}
+					C = Last;
 				}
-				const TPair<uint32, uint32> AB = EdgeFifo[NibbleLeft];
 
-				if (!DecodeIndex())
+				PushEdge(C, B); // push CB
+				PushEdge(A, C); // push AC
+				if (bNewVertex)
 				{
-					return false;
+					PushVertex(C);
 				}
 
-				const uint32 C = Last;
-
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, AB.Value), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(AB.Key, C), 0); // push AC
-				VertexFifo.Insert(C, 0);
-
-				EmitTriangle(AB.Key, AB.Value, C);
+				EmitTriangle(A, B, C);
 			}
-			else if (NibbleLeft == 0xf && NibbleRight < 0xe) // 0xfY
+			else if (NibbleRight < 0xe) // 0xfY
 			{
 				const uint8 ZW = CodeAux[NibbleRight];
 				const uint8 Z = ZW >> 4;
@@ -6297,53 +6650,45 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 				{
 					B = Next++;
 				}
-				else
+				else if (!GetVertex(Z - 1, B))
 				{
-					if (Z - 1 >= VertexFifo.Num())
-					{
-						return false;
-					}
-					B = VertexFifo[Z - 1];
+					return false;
 				}
 
 				if (W == 0)
 				{
 					C = Next++;
 				}
-				else
+				else if (!GetVertex(W - 1, C))
 				{
-					if (W - 1 >= VertexFifo.Num())
-					{
-						return false;
-					}
-					C = VertexFifo[W - 1];
+					return false;
 				}
 
-				EdgeFifo.Insert(TPair<uint32, uint32>(B, A), 0); // push BA
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, B), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(A, C), 0); // push AC
-				VertexFifo.Insert(A, 0);
+				PushEdge(B, A); // push BA
+				PushEdge(C, B); // push CB
+				PushEdge(A, C); // push AC
+				PushVertex(A);
 				if (Z == 0)
 				{
-					VertexFifo.Insert(B, 0);
+					PushVertex(B);
 				}
 				if (W == 0)
 				{
-					VertexFifo.Insert(C, 0);
+					PushVertex(C);
 				}
 
 				EmitTriangle(A, B, C);
 			}
-			else if (Code == 0xfe || Code == 0xff) // 0xfe - 0xff
+			else // 0xfe - 0xff
 			{
 				if (DataOffset >= Limit)
 				{
 					return false;
 				}
 
-				uint8 ZW = Blob.Data[DataOffset++];
-				uint8 Z = ZW >> 4;
-				uint8 W = ZW & 0x0f;
+				const uint8 ZW = Data[DataOffset++];
+				const uint8 Z = ZW >> 4;
+				const uint8 W = ZW & 0x0f;
 				if (ZW == 0)
 				{
 					Next = 0;
@@ -6370,11 +6715,10 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 				}
 				else if (Z < 0xf)
 				{
-					if (Z - 1 >= VertexFifo.Num())
+					if (!GetVertex(Z - 1, B))
 					{
 						return false;
 					}
-					B = VertexFifo[Z - 1];
 				}
 				else
 				{
@@ -6392,11 +6736,10 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 				}
 				else if (W < 0xf)
 				{
-					if (W - 1 >= VertexFifo.Num())
+					if (!GetVertex(W - 1, C))
 					{
 						return false;
 					}
-					C = VertexFifo[W - 1];
 				}
 				else
 				{
@@ -6407,137 +6750,269 @@ bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, c
 					C = Last;
 				}
 
-				EdgeFifo.Insert(TPair<uint32, uint32>(B, A), 0); // push BA
-				EdgeFifo.Insert(TPair<uint32, uint32>(C, B), 0); // push CB
-				EdgeFifo.Insert(TPair<uint32, uint32>(A, C), 0); // push AC
-				VertexFifo.Insert(A, 0);
+				PushEdge(B, A); // push BA
+				PushEdge(C, B); // push CB
+				PushEdge(A, C); // push AC
+				PushVertex(A);
 				if (Z == 0 || Z == 0xf)
 				{
-					VertexFifo.Insert(B, 0);
+					PushVertex(B);
 				}
 				if (W == 0 || W == 0xf)
 				{
-					VertexFifo.Insert(C, 0);
+					PushVertex(C);
 				}
 
 				EmitTriangle(A, B, C);
 			}
 		}
+
+		return true;
 	}
-	else
+
+	template<typename IntType>
+	void ApplyMeshOptimizerOctahedralFilter(IntType* Data, const int64 First, const int64 Last)
 	{
-		return false;
+		constexpr float MaxInt = TNumericLimits<IntType>::Max();
+		for (int64 Index = First * 4; Index < Last * 4; Index += 4)
+		{
+			float X = Data[Index];
+			float Y = Data[Index + 1];
+			const float One = Data[Index + 2];
+			X /= One;
+			Y /= One;
+			const float Z = 1.0f - FMath::Abs(X) - FMath::Abs(Y);
+			const float T = FMath::Max(-Z, 0.0f);
+			X -= (X >= 0) ? T : -T;
+			Y -= (Y >= 0) ? T : -T;
+			const float H = MaxInt / FMath::Sqrt(X * X + Y * Y + Z * Z);
+			Data[Index + 0] = FMath::RoundToInt(X * H);
+			Data[Index + 1] = FMath::RoundToInt(Y * H);
+			Data[Index + 2] = FMath::RoundToInt(Z * H);
+		}
 	}
 
-	if (UncompressedBytes.Num() > 0)
+	void ApplyMeshOptimizerQuaternionFilter(int16* Data, const int64 First, const int64 Last)
 	{
-		if (Filter == "OCTAHEDRAL" && (Stride == 4 || Stride == 8))
+		const float Range = 1.0f / FMath::Sqrt(2.0f);
+
+		for (int64 Offset = First * 4; Offset < Last * 4; Offset += 4)
 		{
-			if (Stride == 4)
+			const float One = Data[Offset + 3] | 3;
+
+			const float X = Data[Offset] / One * Range;
+			const float Y = Data[Offset + 1] / One * Range;
+			const float Z = Data[Offset + 2] / One * Range;
+
+			const float W = FMath::Sqrt(FMath::Max(0.0f, 1.0f - X * X - Y * Y - Z * Z));
+
+			const int32 MaxComp = Data[Offset + 3] & 3;
+
+			Data[Offset + ((MaxComp + 1) % 4)] = FMath::RoundToInt(X * 32767.0f);
+			Data[Offset + ((MaxComp + 2) % 4)] = FMath::RoundToInt(Y * 32767.0f);
+			Data[Offset + ((MaxComp + 3) % 4)] = FMath::RoundToInt(Z * 32767.0f);
+			Data[Offset + ((MaxComp + 0) % 4)] = FMath::RoundToInt(W * 32767.0f);
+		}
+	}
+
+	void ApplyMeshOptimizerExponentialFilter(uint8* Bytes, const int64 First, const int64 Last)
+	{
+		for (int64 Offset = First; Offset < Last; Offset++)
+		{
+			int32 Value;
+			FMemory::Memcpy(&Value, Bytes + Offset * 4, 4);
+			const int32 E = Value >> 24;
+			const int32 M = (Value << 8) >> 8;
+			float Result;
+			if (E >= -126)
 			{
-				int8* Data = reinterpret_cast<int8*>(UncompressedBytes.GetData());
-				const int64 MaxInt = 127;
-				for (int64 Index = 0; Index < 4 * Elements; Index += 4)
-				{
-					float X = Data[Index];
-					float Y = Data[Index + 1];
-					float One = Data[Index + 2];
-					X /= One;
-					Y /= One;
-					const float Z = 1.0 - FMath::Abs(X) - FMath::Abs(Y);
-					const float T = FMath::Max(-Z, 0.0f);
-					X -= (X >= 0) ? T : -T;
-					Y -= (Y >= 0) ? T : -T;
-					const float H = MaxInt / FMath::Sqrt(X * X + Y * Y + Z * Z);
-					Data[Index + 0] = FMath::RoundToInt(X * H);
-					Data[Index + 1] = FMath::RoundToInt(Y * H);
-					Data[Index + 2] = FMath::RoundToInt(Z * H);
-				}
+				// build 2^E directly from its bits
+				const uint32 ExponentBits = static_cast<uint32>(E + 127) << 23;
+				float Exponent;
+				FMemory::Memcpy(&Exponent, &ExponentBits, 4);
+				Result = Exponent * M;
 			}
 			else
 			{
-				int16* Data = reinterpret_cast<int16*>(UncompressedBytes.GetData());
-				const int64 MaxInt = 32767;
-				for (int64 Index = 0; Index < 4 * Elements; Index += 4)
-				{
-					float X = Data[Index];
-					float Y = Data[Index + 1];
-					float One = Data[Index + 2];
-					X /= One;
-					Y /= One;
-					const float Z = 1.0 - FMath::Abs(X) - FMath::Abs(Y);
-					const float T = FMath::Max(-Z, 0.0f);
-					X -= (X >= 0) ? T : -T;
-					Y -= (Y >= 0) ? T : -T;
-					const float H = MaxInt / FMath::Sqrt(X * X + Y * Y + Z * Z);
-					Data[Index + 0] = FMath::RoundToInt(X * H);
-					Data[Index + 1] = FMath::RoundToInt(Y * H);
-					Data[Index + 2] = FMath::RoundToInt(Z * H);
-				}
+				Result = FMath::Pow(2.0f, E) * M;
 			}
+			FMemory::Memcpy(Bytes + Offset * 4, &Result, 4);
 		}
-		else if (Filter == "QUATERNION" && Stride == 8)
-		{
-			int16* Data = reinterpret_cast<int16*>(UncompressedBytes.GetData());
+	}
 
-			const float Range = 1.0f / FMath::Sqrt(2.0f);
+	// run the filter in parallel over chunks of elements
+	template<typename Callable>
+	void ApplyMeshOptimizerFilter(const int64 Elements, Callable Filter)
+	{
+		constexpr int64 ElementsPerChunk = 16 * 1024;
+		const int32 ChunksNum = static_cast<int32>((Elements + ElementsPerChunk - 1) / ElementsPerChunk);
+		if (ChunksNum <= 1)
+		{
+			Filter(0, Elements);
+			return;
+		}
 
-			for (int64 Offset = 0; Offset < Elements * 4; Offset += 4)
+		ParallelFor(ChunksNum, [&](const int32 ChunkIndex)
 			{
-				float One = Data[Offset + 3] | 3;
-
-				float X = Data[Offset] / One * Range;
-				float Y = Data[Offset + 1] / One * Range;
-				float Z = Data[Offset + 2] / One * Range;
+				const int64 First = ChunkIndex * ElementsPerChunk;
+				Filter(First, FMath::Min(First + ElementsPerChunk, Elements));
+			});
+	}
 
-				float W = FMath::Sqrt(FMath::Max(0.0, 1.0 - X * X - Y * Y - Z * Z));
+	/*
+	* Thread-safe EXT_meshopt_compression decoder.
+	* bUnsupportedFilter is set when the failure is caused by an unknown filter.
+	*/
+	bool DecodeMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes, bool& bUnsupportedFilter)
+	{
+		bUnsupportedFilter = false;
 
-				int32 MaxComp = Data[Offset + 3] & 3;
+		if (Stride <= 0 || Elements <= 0)
+		{
+			return false;
+		}
 
-				Data[Offset + ((MaxComp + 1) % 4)] = FMath::RoundToInt(X * 32767.0);
-				Data[Offset + ((MaxComp + 2) % 4)] = FMath::RoundToInt(Y * 32767.0);
-				Data[Offset + ((MaxComp + 3) % 4)] = FMath::RoundToInt(Z * 32767.0);
-				Data[Offset + ((MaxComp + 0) % 4)] = FMath::RoundToInt(W * 32767.0);
+		if (Mode == "ATTRIBUTES" && Blob.Num > 32 && Blob.Data[0] == 0xa0 && Blob.Num > Stride)
+		{
+			UncompressedBytes.SetNumUninitialized(Elements * Stride);
+			if (!DecodeMeshOptimizerAttributes(Blob.Data, Blob.Num, Stride, Elements, UncompressedBytes.GetData()))
+			{
+				return false;
 			}
 		}
-		else if (Filter == "EXPONENTIAL" && (Stride % 4) == 0)
+		else if (Mode == "TRIANGLES" && Blob.Num >= 17 && Blob.Data[0] == 0xe1 && (Stride == 2 || Stride == 4) && ((Elements % 3) == 0))
 		{
-			int32* Data = reinterpret_cast<int32*>(UncompressedBytes.GetData());
-			float* Dest = reinterpret_cast<float*>(UncompressedBytes.GetData());
-			for (int64 Offset = 0; Offset < UncompressedBytes.Num() / 4; Offset++)
+			UncompressedBytes.SetNumUninitialized(Elements * Stride);
+			if (!DecodeMeshOptimizerTriangles(Blob.Data, Blob.Num, Stride, Elements, UncompressedBytes.GetData()))
 			{
-				int32 E = Data[Offset] >> 24;
-				int32 M = (Data[Offset] << 8) >> 8;
-				Dest[Offset] = FMath::Pow(2.0f, E) * M;
+				return false;
 			}
 		}
+		else
+		{
+			return false;
+		}
+
+		if (Filter == "OCTAHEDRAL" && (Stride == 4 || Stride == 8))
+		{
+			if (Stride == 4)
+			{
+				int8* Data = reinterpret_cast<int8*>(UncompressedBytes.GetData());
+				ApplyMeshOptimizerFilter(Elements, [Data](const int64 First, const int64 Last) { ApplyMeshOptimizerOctahedralFilter(Data, First, Last); });
+			}
+			else
+			{
+				int16* Data = reinterpret_cast<int16*>(UncompressedBytes.GetData());
+				ApplyMeshOptimizerFilter(Elements, [Data](const int64 First, const int64 Last) { ApplyMeshOptimizerOctahedralFilter(Data, First, Last); });
+			}
+		}
+		else if (Filter == "QUATERNION" && Stride == 8)
+		{
+			int16* Data = reinterpret_cast<int16*>(UncompressedBytes.GetData());
+			ApplyMeshOptimizerFilter(Elements, [Data](const int64 First, const int64 Last) { ApplyMeshOptimizerQuaternionFilter(Data, First, Last); });
+		}
+		else if (Filter == "EXPONENTIAL" && (Stride % 4) == 0)
+		{
+			uint8* Data = UncompressedBytes.GetData();
+			ApplyMeshOptimizerFilter(UncompressedBytes.Num() / 4, [Data](const int64 First, const int64 Last) { ApplyMeshOptimizerExponentialFilter(Data, First, Last); });
+		}
 		else if (Filter != "" && Filter != "NONE")
 		{
-			AddError("DecompressMeshOptimizer()", "Unsupported Filter");
+			bUnsupportedFilter = true;
 			return false;
 		}
+
+		return true;
+	}
+}
+
+bool FglTFRuntimeParser::DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes)
+{
+	bool bUnsupportedFilter = false;
+	if (!glTFRuntime::DecodeMeshOptimizer(Blob, Stride, Elements, Mode, Filter, UncompressedBytes, bUnsupportedFilter))
+	{
+		if (bUnsupportedFilter)
+		{
+			AddError("DecompressMeshOptimizer()", "Unsupported Filter");
+		}
+		return false;
 	}
 
 	return true;
 }
 
-FTransform FglTFRuntimeParser::GetParentNodeWorldTransform(const FglTFRuntimeNode& Node)
+void FglTFRuntimeParser::DecompressMeshOptimizerBufferViews()
 {
-	FTransform WorldTransform = FTransform::Identity;
-	int32 ParentIndex = Node.ParentIndex;
-	while (ParentIndex > INDEX_NONE)
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_DecompressMeshOptimizerBufferViews, FColor::Magenta);
+
+	// called by GetBufferView with BufferViewsPopulateLock held, so the cache can be read without the RW lock
+	bMeshoptBufferViewsDecompressed = true;
+
+	struct FCompressedBufferView
 	{
-		FglTFRuntimeNode ParentNode;
-		if (!LoadNode(ParentIndex, ParentNode))
+		int32 Index;
+		FglTFRuntimeBlob Blob;
+		TArray64<uint8> UncompressedBytes;
+		bool bSuccess;
+	};
+
+	TArray<FCompressedBufferView> CompressedBufferViews;
+
+	for (int32 Index = 0; Index < BufferViewsDescs.Num(); Index++)
+	{
+		const FglTFRuntimeBufferViewDesc& BufferViewDesc = BufferViewsDescs[Index];
+		if (!BufferViewDesc.bMeshoptCompressed || !BufferViewDesc.bValid || BufferViewDesc.ByteStride == 0 || CompressedBufferViewsCache.Contains(Index))
 		{
-			break;
+			continue;
+		}
+
+		// buffers are resolved on the current thread (they could require I/O or populate the cache)
+		FglTFRuntimeBlob BufferBlob;
+		if (!GetBuffer(BufferViewDesc.Buffer, BufferBlob) || BufferViewDesc.ByteOffset + BufferViewDesc.ByteLength > BufferBlob.Num)
+		{
+			continue;
+		}
+
+		FCompressedBufferView& CompressedBufferView = CompressedBufferViews.AddDefaulted_GetRef();
+		CompressedBufferView.Index = Index;
+		CompressedBufferView.Blob.Data = BufferBlob.Data + BufferViewDesc.ByteOffset;
+		CompressedBufferView.Blob.Num = BufferViewDesc.ByteLength;
+		CompressedBufferView.bSuccess = false;
+	}
+
+	ParallelFor(CompressedBufferViews.Num(), [&](const int32 CompressedBufferViewIndex)
+		{
+			FCompressedBufferView& CompressedBufferView = CompressedBufferViews[CompressedBufferViewIndex];
+			const FglTFRuntimeBufferViewDesc& BufferViewDesc = BufferViewsDescs[CompressedBufferView.Index];
+			bool bUnsupportedFilter = false;
+			CompressedBufferView.bSuccess = glTFRuntime::DecodeMeshOptimizer(CompressedBufferView.Blob, BufferViewDesc.ByteStride, BufferViewDesc.MeshoptCount, BufferViewDesc.MeshoptMode, BufferViewDesc.MeshoptFilter, CompressedBufferView.UncompressedBytes, bUnsupportedFilter);
+		});
+
+	// failed ones will be retried (and reported) by GetBufferView
+	FWriteScopeLock Lock(BufferViewsCacheLock);
+	for (FCompressedBufferView& CompressedBufferView : CompressedBufferViews)
+	{
+		if (CompressedBufferView.bSuccess)
+		{
+			CompressedBufferViewsCache.Add(CompressedBufferView.Index, MoveTemp(CompressedBufferView.UncompressedBytes));
+			CompressedBufferViewsStridesCache.Add(CompressedBufferView.Index, BufferViewsDescs[CompressedBufferView.Index].ByteStride);
 		}
+	}
+}
 
-		WorldTransform = ParentNode.Transform * WorldTransform;
-		ParentIndex = ParentNode.ParentIndex;
+FTransform FglTFRuntimeParser::GetParentNodeWorldTransform(const FglTFRuntimeNode& Node)
+{
+	if (!bAllNodesCached && !LoadNodes())
+	{
+		return FTransform::Identity;
+	}
+
+	if (!SceneGraphWorldTransforms.IsValidIndex(Node.ParentIndex))
+	{
+		return FTransform::Identity;
 	}
 
-	return WorldTransform;
+	return SceneGraphWorldTransforms[Node.ParentIndex];
 }
 
 FTransform FglTFRuntimeParser::GetNodeWorldTransform(const FglTFRuntimeNode& Node)
@@ -6561,24 +7036,28 @@ int32 FglTFRuntimeParser::GetNodeDistance(const FglTFRuntimeNode& Node, const in
 		return 0;
 	}
 
-	int32 Distance = 0;
+	if (!bAllNodesCached && !LoadNodes())
+	{
+		return -1;
+	}
 
-	FglTFRuntimeNode CurrentNode = Node;
-	while (CurrentNode.ParentIndex > INDEX_NONE)
+	const int32 ParentIndex = Node.ParentIndex;
+	if (!SceneGraphDepths.IsValidIndex(ParentIndex))
 	{
-		Distance++;
-		if (!LoadNode(CurrentNode.ParentIndex, CurrentNode))
-		{
-			return -1;
-		}
+		return -1;
+	}
 
-		if (CurrentNode.Index == Ancestor)
-		{
-			return Distance;
-		}
+	if (ParentIndex == Ancestor)
+	{
+		return 1;
+	}
+
+	if (!SceneGraphIsAncestor(Ancestor, ParentIndex))
+	{
+		return -1;
 	}
 
-	return -1;
+	return SceneGraphDepths[ParentIndex] - SceneGraphDepths[Ancestor] + 1;
 }
 
 FString FglTFRuntimeParser::GetVersion() const
@@ -0,0 +1,661 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+
+namespace glTFRuntime
+{
+	// texture slots that can be moved to an atlas (sRGB flag and name of the slot in the json material)
+	static const TPair<const TCHAR*, bool> AtlasTextureSlots[] =
+	{
+		{ TEXT("/pbrMetallicRoughness/baseColorTexture"), true },
+		{ TEXT("/pbrMetallicRoughness/metallicRoughnessTexture"), false },
+		{ TEXT("/normalTexture"), false },
+		{ TEXT("/occlusionTexture"), false },
+		{ TEXT("/emissiveTexture"), true },
+	};
+
+	struct FAtlasMaterial
+	{
+		int64 MaterialIndex = INDEX_NONE;
+		TSharedPtr<FJsonObject> JsonMaterialObject;
+		FString MaterialName;
+		TArray<int32> Primitives;
+
+		// one image per AtlasTextureSlots item (or INDEX_NONE/empty)
+		TArray<int64> SlotsImages;
+		TArray<TArray64<uint8>> SlotsPixels;
+		int32 Width = 0;
+		int32 Height = 0;
+
+		// KHR_texture_transform, baked into the UVs
+		int32 TexCoord = 0;
+		FVector2D Offset = FVector2D::ZeroVector;
+		FVector2D Scale = FVector2D(1, 1);
+		double Rotation = 0;
+
+		// region (in pixels) inside the atlas
+		int32 AtlasX = 0;
+		int32 AtlasY = 0;
+	};
+
+	TSharedRef<FJsonObject> CanonicalizeAtlasMaterial(TSharedRef<FJsonObject> JsonObject, const FString& Path, TMap<FString, TSharedRef<FJsonObject>>& OutSlots)
+	{
+		TSharedRef<FJsonObject> JsonCanonicalObject = MakeShared<FJsonObject>();
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonObject->Values)
+		{
+			// name and extras do not affect the material instance
+			if (Path.IsEmpty() && (Pair.Key == TEXT("name") || Pair.Key == TEXT("extras")))
+			{
+				continue;
+			}
+
+			const TSharedPtr<FJsonObject>* JsonChildObject = nullptr;
+			if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(JsonChildObject))
+			{
+				JsonCanonicalObject->Values.Add(Pair.Key, Pair.Value);
+				continue;
+			}
+
+			const FString ChildPath = Path + TEXT("/") + Pair.Key;
+			if (Pair.Key.EndsWith(TEXT("Texture")) && (*JsonChildObject)->HasField(TEXT("index")))
+			{
+				OutSlots.Add(ChildPath, JsonChildObject->ToSharedRef());
+				// keep only the texture parameters (scale, strength...)
+				TSharedRef<FJsonObject> JsonSlotObject = MakeShared<FJsonObject>();
+				JsonSlotObject->Values = (*JsonChildObject)->Values;
+				JsonSlotObject->RemoveField(TEXT("index"));
+				JsonSlotObject->RemoveField(TEXT("texCoord"));
+				JsonSlotObject->RemoveField(TEXT("extensions"));
+				JsonCanonicalObject->SetObjectField(Pair.Key, JsonSlotObject);
+			}
+			else
+			{
+				JsonCanonicalObject->SetObjectField(Pair.Key, CanonicalizeAtlasMaterial(JsonChildObject->ToSharedRef(), ChildPath, OutSlots));
+			}
+		}
+		return JsonCanonicalObject;
+	}
+
+	FString JsonObjectToAtlasKey(TSharedRef<FJsonObject> JsonObject)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(JsonObject, JsonWriter);
+		return Json;
+	}
+
+	// returns the uv in the texture space of the material (only the affine KHR_texture_transform is applied)
+	FORCEINLINE FVector2D GetAtlasMaterialUV(const FAtlasMaterial& AtlasMaterial, const FVector2D& UV)
+	{
+		const double Cos = FMath::Cos(AtlasMaterial.Rotation);
+		const double Sin = FMath::Sin(AtlasMaterial.Rotation);
+		const double ScaledU = UV.X * AtlasMaterial.Scale.X;
+		const double ScaledV = UV.Y * AtlasMaterial.Scale.Y;
+
+		return FVector2D(AtlasMaterial.Offset.X + Cos * ScaledU + Sin * ScaledV, AtlasMaterial.Offset.Y - Sin * ScaledU + Cos * ScaledV);
+	}
+
+	// simple shelf packing (items must be sorted by height), returns false if the items do not fit
+	bool PackAtlasShelves(TArray<FAtlasMaterial*>& Items, const int32 AtlasWidth, const int32 MaxHeight, const int32 Padding, int32& OutHeight)
+	{
+		int32 X = 0;
+		int32 Y = 0;
+		int32 ShelfHeight = 0;
+		for (FAtlasMaterial* Item : Items)
+		{
+			const int32 ItemWidth = Item->Width + Padding * 2;
+			const int32 ItemHeight = Item->Height + Padding * 2;
+			if (ItemWidth > AtlasWidth)
+			{
+				return false;
+			}
+
+			if (X + ItemWidth > AtlasWidth)
+			{
+				X = 0;
+				Y += ShelfHeight;
+				ShelfHeight = 0;
+			}
+
+			Item->AtlasX = X + Padding;
+			Item->AtlasY = Y + Padding;
+			X += ItemWidth;
+			ShelfHeight = FMath::Max(ShelfHeight, ItemHeight);
+
+			if (Y + ShelfHeight > MaxHeight)
+			{
+				return false;
+			}
+		}
+
+		OutHeight = Y + ShelfHeight;
+		return true;
+	}
+
+	// json only checks (no image is decoded), returns the key of the group of materials it can be merged with
+	bool ParseAtlasMaterial(FglTFRuntimeParser& Parser, const int64 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, FAtlasMaterial& AtlasMaterial, FString& GroupKey)
+	{
+		constexpr int32 NumSlots = UE_ARRAY_COUNT(AtlasTextureSlots);
+
+		TSharedPtr<FJsonObject> JsonMaterialObject = Parser.GetJsonObjectFromRootIndex("materials", MaterialIndex);
+		if (!JsonMaterialObject || MaterialsConfig.MaterialsOverrideMap.Contains(MaterialIndex))
+		{
+			return false;
+		}
+
+		FString MaterialName;
+		JsonMaterialObject->TryGetStringField(TEXT("name"), MaterialName);
+		if (MaterialName.IsEmpty() && MaterialsConfig.bForceEmptyMaterialNameToMaterialIndex)
+		{
+			MaterialName = FString::FromInt(MaterialIndex);
+		}
+
+		if (MaterialsConfig.MaterialsOverrideByNameMap.Contains(MaterialName))
+		{
+			return false;
+		}
+
+		TMap<FString, TSharedRef<FJsonObject>> Slots;
+		TSharedRef<FJsonObject> JsonCanonicalObject = CanonicalizeAtlasMaterial(JsonMaterialObject.ToSharedRef(), "", Slots);
+		if (Slots.Num() == 0)
+		{
+			return false;
+		}
+
+		AtlasMaterial.MaterialIndex = MaterialIndex;
+		AtlasMaterial.JsonMaterialObject = JsonMaterialObject;
+		AtlasMaterial.MaterialName = MaterialName;
+		AtlasMaterial.SlotsImages.Init(INDEX_NONE, NumSlots);
+		AtlasMaterial.SlotsPixels.AddDefaulted(NumSlots);
+
+		FString TransformKey;
+		for (const TPair<FString, TSharedRef<FJsonObject>>& Pair : Slots)
+		{
+			int32 SlotIndex = INDEX_NONE;
+			for (int32 CurrentSlotIndex = 0; CurrentSlotIndex < NumSlots; CurrentSlotIndex++)
+			{
+				if (Pair.Key == AtlasTextureSlots[CurrentSlotIndex].Key)
+				{
+					SlotIndex = CurrentSlotIndex;
+					break;
+				}
+			}
+
+			const int64 TextureIndex = static_cast<int64>(Pair.Value->GetNumberField(TEXT("index")));
+			TSharedPtr<FJsonObject> JsonTextureObject = Parser.GetJsonObjectFromRootIndex("textures", TextureIndex);
+			if (SlotIndex == INDEX_NONE || !JsonTextureObject || MaterialsConfig.TexturesOverrideMap.Contains(TextureIndex))
+			{
+				return false;
+			}
+
+			int64 ImageIndex = INDEX_NONE;
+			FglTFRuntimeParser::OnTextureImageIndex.Broadcast(Parser.AsShared(), JsonTextureObject.ToSharedRef(), ImageIndex);
+			if ((ImageIndex <= INDEX_NONE && !JsonTextureObject->TryGetNumberField(TEXT("source"), ImageIndex)) || MaterialsConfig.ImagesOverrideMap.Contains(ImageIndex))
+			{
+				return false;
+			}
+			AtlasMaterial.SlotsImages[SlotIndex] = ImageIndex;
+
+			// all of the slots must share the same uv set, transform and wrap mode
+			int64 TexCoord = 0;
+			Pair.Value->TryGetNumberField(TEXT("texCoord"), TexCoord);
+			TexCoord = Parser.GetJsonExtensionObjectIndex(Pair.Value, "KHR_texture_transform", "texCoord", TexCoord);
+
+			const TArray<double> Offset = Parser.GetJsonExtensionObjectNumbers(Pair.Value, "KHR_texture_transform", "offset");
+			const TArray<double> Scale = Parser.GetJsonExtensionObjectNumbers(Pair.Value, "KHR_texture_transform", "scale");
+			const double Rotation = Parser.GetJsonExtensionObjectNumber(Pair.Value, "KHR_texture_transform", "rotation", 0);
+
+			int64 WrapS = 10497;
+			int64 WrapT = 10497;
+			int64 SamplerIndex = INDEX_NONE;
+			if (JsonTextureObject->TryGetNumberField(TEXT("sampler"), SamplerIndex))
+			{
+				if (TSharedPtr<FJsonObject> JsonSamplerObject = Parser.GetJsonObjectFromRootIndex("samplers", SamplerIndex))
+				{
+					JsonSamplerObject->TryGetNumberField(TEXT("wrapS"), WrapS);
+					JsonSamplerObject->TryGetNumberField(TEXT("wrapT"), WrapT);
+				}
+			}
+
+			const FString SlotTransformKey = FString::Printf(TEXT("%lld/%s/%s/%f/%lld/%lld"), TexCoord,
+				*FString::JoinBy(Offset, TEXT(","), [](const double Value) { return FString::SanitizeFloat(Value); }),
+				*FString::JoinBy(Scale, TEXT(","), [](const double Value) { return FString::SanitizeFloat(Value); }),
+				Rotation, WrapS, WrapT);
+			if (!TransformKey.IsEmpty() && TransformKey != SlotTransformKey)
+			{
+				return false;
+			}
+			TransformKey = SlotTransformKey;
+
+			AtlasMaterial.TexCoord = static_cast<int32>(TexCoord);
+			if (Offset.Num() >= 2)
+			{
+				AtlasMaterial.Offset = FVector2D(Offset[0], Offset[1]);
+			}
+			if (Scale.Num() >= 2)
+			{
+				AtlasMaterial.Scale = FVector2D(Scale[0], Scale[1]);
+			}
+			AtlasMaterial.Rotation = Rotation;
+		}
+
+		// materials can be merged only if they differ just by their textures
+		GroupKey = FString::Printf(TEXT("%s/%d"), *JsonObjectToAtlasKey(JsonCanonicalObject), AtlasMaterial.TexCoord);
+		return true;
+	}
+}
+
+bool FglTFRuntimeParser::IsAtlasMaterialCandidate(const int64 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, FString& MaterialName)
+{
+	glTFRuntime::FAtlasMaterial AtlasMaterial;
+	FString GroupKey;
+	if (!glTFRuntime::ParseAtlasMaterial(*this, MaterialIndex, MaterialsConfig, AtlasMaterial, GroupKey))
+	{
+		return false;
+	}
+
+	MaterialName = AtlasMaterial.MaterialName;
+	return true;
+}
+
+bool FglTFRuntimeParser::AtlasPrimitivesTextures(TArray<FglTFRuntimePrimitive>& Primitives, const int32 FirstPrimitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_AtlasPrimitivesTextures, FColor::Magenta);
+
+	constexpr int32 NumSlots = UE_ARRAY_COUNT(glTFRuntime::AtlasTextureSlots);
+	const int32 Padding = FMath::Max(0, MaterialsConfig.AtlasPadding);
+
+	// collect the materials (with their primitives) deferred by LoadPrimitive()
+	TMap<int64, glTFRuntime::FAtlasMaterial> AtlasMaterials;
+	TSet<int64> SkippedMaterials;
+	TMap<int64, FString> MaterialsGroups;
+
+	for (int32 PrimitiveIndex = FirstPrimitive; PrimitiveIndex < Primitives.Num(); PrimitiveIndex++)
+	{
+		const FglTFRuntimePrimitive& Primitive = Primitives[PrimitiveIndex];
+		if (Primitive.Material || !Primitive.bHasMaterial || Primitive.MaterialIndex <= INDEX_NONE || SkippedMaterials.Contains(Primitive.MaterialIndex))
+		{
+			continue;
+		}
+
+		if (glTFRuntime::FAtlasMaterial* AtlasMaterial = AtlasMaterials.Find(Primitive.MaterialIndex))
+		{
+			AtlasMaterial->Primitives.Add(PrimitiveIndex);
+			continue;
+		}
+
+		glTFRuntime::FAtlasMaterial AtlasMaterial;
+		FString GroupKey;
+		if (!glTFRuntime::ParseAtlasMaterial(*this, Primitive.MaterialIndex, MaterialsConfig, AtlasMaterial, GroupKey))
+		{
+			SkippedMaterials.Add(Primitive.MaterialIndex);
+			continue;
+		}
+
+		AtlasMaterial.Primitives.Add(PrimitiveIndex);
+		MaterialsGroups.Add(Primitive.MaterialIndex, FString::Printf(TEXT("%s/%d"), *GroupKey, Primitive.Colors.Num() > 0 ? 1 : 0));
+		AtlasMaterials.Add(Primitive.MaterialIndex, MoveTemp(AtlasMaterial));
+	}
+
+	// materials can be atlased only if the uvs do not exit the 0-1 range, whatever the wrap mode:
+	// clamping a uv per vertex would distort the interpolation across the triangle and
+	// once in the atlas the sampler would read the neighbouring regions instead of the edge texels
+	for (TPair<int64, glTFRuntime::FAtlasMaterial>& Pair : AtlasMaterials)
+	{
+		glTFRuntime::FAtlasMaterial& AtlasMaterial = Pair.Value;
+		for (const int32 PrimitiveIndex : AtlasMaterial.Primitives)
+		{
+			const FglTFRuntimePrimitive& Primitive = Primitives[PrimitiveIndex];
+			bool bValid = AtlasMaterial.TexCoord < Primitive.UVs.Num();
+			if (bValid)
+			{
+				for (const FVector2D& UV : Primitive.UVs[AtlasMaterial.TexCoord])
+				{
+					const FVector2D TextureUV = glTFRuntime::GetAtlasMaterialUV(AtlasMaterial, UV);
+					if (TextureUV.X < -KINDA_SMALL_NUMBER || TextureUV.X > 1 + KINDA_SMALL_NUMBER || TextureUV.Y < -KINDA_SMALL_NUMBER || TextureUV.Y > 1 + KINDA_SMALL_NUMBER)
+					{
+						bValid = false;
+						break;
+					}
+				}
+			}
+
+			if (!bValid)
+			{
+				MaterialsGroups.Remove(Pair.Key);
+				break;
+			}
+		}
+	}
+
+	TMap<FString, TArray<glTFRuntime::FAtlasMaterial*>> Groups;
+	for (const TPair<int64, FString>& Pair : MaterialsGroups)
+	{
+		Groups.FindOrAdd(Pair.Value).Add(&AtlasMaterials[Pair.Key]);
+	}
+
+	// atlases are injected as overrides of fake texture indices (after the real ones)
+	int32 NumTextures = 0;
+	const TArray<TSharedPtr<FJsonValue>>* JsonTextures;
+	if (Root->TryGetArrayField(TEXT("textures"), JsonTextures))
+	{
+		NumTextures = JsonTextures->Num();
+	}
+
+	const FString MaterialsConfigKey = GetMaterialsConfigKey(MaterialsConfig);
+
+	for (TPair<FString, TArray<glTFRuntime::FAtlasMaterial*>>& Group : Groups)
+	{
+		TArray<glTFRuntime::FAtlasMaterial*>& Items = Group.Value;
+		if (Items.Num() < 2)
+		{
+			continue;
+		}
+
+		Items.Sort([](const glTFRuntime::FAtlasMaterial& A, const glTFRuntime::FAtlasMaterial& B)
+			{
+				return A.MaterialIndex < B.MaterialIndex;
+			});
+
+		// the same group of materials (for the other LODs or for a reload) reuses the same atlas
+		const FString AtlasKey = FString::Printf(TEXT("%s/%s/%s"), *Group.Key,
+			*FString::JoinBy(Items, TEXT(","), [](const glTFRuntime::FAtlasMaterial* Item) { return FString::Printf(TEXT("%lld"), Item->MaterialIndex); }),
+			*MaterialsConfigKey);
+
+		FglTFRuntimeAtlasLayout AtlasLayout;
+		UMaterialInterface* AtlasMaterialInterface = nullptr;
+		bool bCached = false;
+		if (CanReadFromCache(MaterialsConfig.CacheMode))
+		{
+			FReadScopeLock Lock(ObjectsCacheLock);
+			if (const FglTFRuntimeAtlasLayout* CachedAtlasLayout = AtlasLayoutsCache.Find(AtlasKey))
+			{
+				AtlasLayout = *CachedAtlasLayout;
+				AtlasMaterialInterface = AtlasMaterialsCache.FindRef(AtlasKey);
+				bCached = true;
+			}
+		}
+
+		if (!bCached)
+		{
+			// only small 8 bit images of the same size
+			Items.RemoveAll([&](glTFRuntime::FAtlasMaterial* Item)
+				{
+					for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++)
+					{
+						if (Item->SlotsImages[SlotIndex] <= INDEX_NONE)
+						{
+							continue;
+						}
+
+						int32 Width = 0;
+						int32 Height = 0;
+						EPixelFormat PixelFormat = EPixelFormat::PF_Unknown;
+						if (!LoadImage(Item->SlotsImages[SlotIndex], Item->SlotsPixels[SlotIndex], Width, Height, PixelFormat, MaterialsConfig.ImagesConfig) ||
+							PixelFormat != EPixelFormat::PF_B8G8R8A8 || Width <= 0 || Height <= 0 ||
+							Width > MaterialsConfig.AtlasMaxTextureSize || Height > MaterialsConfig.AtlasMaxTextureSize ||
+							(Item->Width > 0 && (Item->Width != Width || Item->Height != Height)))
+						{
+							return true;
+						}
+						Item->Width = Width;
+						Item->Height = Height;
+					}
+					return false;
+				});
+
+			Items.Sort([](const glTFRuntime::FAtlasMaterial& A, const glTFRuntime::FAtlasMaterial& B)
+				{
+					return A.Height == B.Height ? A.MaterialIndex < B.MaterialIndex : A.Height > B.Height;
+				});
+
+			// find the smallest power of two atlas, dropping the biggest items until everything fits
+			int32 AtlasWidth = 0;
+			int32 AtlasHeight = 0;
+			while (Items.Num() > 1)
+			{
+				for (int32 CandidateWidth = 64; CandidateWidth <= MaterialsConfig.AtlasMaxSize; CandidateWidth *= 2)
+				{
+					int32 UsedHeight = 0;
+					if (glTFRuntime::PackAtlasShelves(Items, CandidateWidth, MaterialsConfig.AtlasMaxSize, Padding, UsedHeight))
+					{
+						const int32 CandidateHeight = FMath::RoundUpToPowerOfTwo(UsedHeight);
+						if (AtlasWidth == 0 || static_cast<int64>(CandidateWidth) * CandidateHeight < static_cast<int64>(AtlasWidth) * AtlasHeight)
+						{
+							AtlasWidth = CandidateWidth;
+							AtlasHeight = CandidateHeight;
+						}
+					}
+				}
+
+				if (AtlasWidth > 0)
+				{
+					break;
+				}
+
+				Items.RemoveAt(0);
+			}
+
+			if (Items.Num() > 1 && AtlasWidth > 0)
+			{
+				// restore the positions of the selected size
+				int32 UsedHeight = 0;
+				glTFRuntime::PackAtlasShelves(Items, AtlasWidth, AtlasHeight, Padding, UsedHeight);
+
+				// fill the atlases (padding replicates the edges, like clamping would do)
+				TArray<TArray64<uint8>> AtlasesPixels;
+				AtlasesPixels.AddDefaulted(NumSlots);
+				for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++)
+				{
+					if (Items[0]->SlotsPixels[SlotIndex].Num() == 0)
+					{
+						continue;
+					}
+
+					TArray64<uint8>& AtlasPixels = AtlasesPixels[SlotIndex];
+					AtlasPixels.AddZeroed(static_cast<int64>(AtlasWidth) * AtlasHeight * 4);
+
+					ParallelFor(Items.Num(), [&](const int32 ItemIndex)
+						{
+							const glTFRuntime::FAtlasMaterial& Item = *Items[ItemIndex];
+							const uint32* SourcePixels = reinterpret_cast<const uint32*>(Item.SlotsPixels[SlotIndex].GetData());
+							uint32* DestinationPixels = reinterpret_cast<uint32*>(AtlasPixels.GetData());
+							for (int32 Y = -Padding; Y < Item.Height + Padding; Y++)
+							{
+								const int32 SourceY = FMath::Clamp(Y, 0, Item.Height - 1);
+								for (int32 X = -Padding; X < Item.Width + Padding; X++)
+								{
+									const int32 SourceX = FMath::Clamp(X, 0, Item.Width - 1);
+									DestinationPixels[static_cast<int64>(Item.AtlasY + Y) * AtlasWidth + Item.AtlasX + X] = SourcePixels[static_cast<int64>(SourceY) * Item.Width + SourceX];
+								}
+							}
+						});
+				}
+
+				// the decoded images are not needed anymore
+				for (glTFRuntime::FAtlasMaterial* Item : Items)
+				{
+					Item->SlotsPixels.Empty();
+				}
+
+				// replace the texture slots of the first material with the atlases
+				const glTFRuntime::FAtlasMaterial& FirstItem = *Items[0];
+				const FString AtlasMaterialName = FirstItem.MaterialName + TEXT("_Atlas");
+				const bool bUseVertexColors = Primitives[FirstItem.Primitives[0]].Colors.Num() > 0;
+
+				TFunction<void(TSharedRef<FJsonObject>, TSharedRef<FJsonObject>, const FString&)> CopyMaterial = [&](TSharedRef<FJsonObject> Source, TSharedRef<FJsonObject> Destination, const FString& Path)
+					{
+						for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Source->Values)
+						{
+							const TSharedPtr<FJsonObject>* JsonChildObject = nullptr;
+							if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(JsonChildObject))
+							{
+								Destination->Values.Add(Pair.Key, Pair.Value);
+								continue;
+							}
+
+							const FString ChildPath = Path + TEXT("/") + Pair.Key;
+							int32 SlotIndex = INDEX_NONE;
+							for (int32 CurrentSlotIndex = 0; CurrentSlotIndex < NumSlots; CurrentSlotIndex++)
+							{
+								if (ChildPath == glTFRuntime::AtlasTextureSlots[CurrentSlotIndex].Key)
+								{
+									SlotIndex = CurrentSlotIndex;
+									break;
+								}
+							}
+
+							TSharedRef<FJsonObject> JsonChildCopy = MakeShared<FJsonObject>();
+							if (SlotIndex != INDEX_NONE && AtlasesPixels[SlotIndex].Num() > 0)
+							{
+								// the texture transform is already baked in the uvs
+								JsonChildCopy->Values = (*JsonChildObject)->Values;
+								JsonChildCopy->RemoveField(TEXT("extensions"));
+								JsonChildCopy->SetNumberField(TEXT("index"), NumTextures + SlotIndex);
+								JsonChildCopy->SetNumberField(TEXT("texCoord"), FirstItem.TexCoord);
+							}
+							else
+							{
+								CopyMaterial(JsonChildObject->ToSharedRef(), JsonChildCopy, ChildPath);
+							}
+							Destination->SetObjectField(Pair.Key, JsonChildCopy);
+						}
+					};
+
+				TSharedRef<FJsonObject> JsonAtlasMaterialObject = MakeShared<FJsonObject>();
+				CopyMaterial(FirstItem.JsonMaterialObject.ToSharedRef(), JsonAtlasMaterialObject, "");
+				JsonAtlasMaterialObject->SetStringField(TEXT("name"), AtlasMaterialName);
+
+				FglTFRuntimeMaterialsConfig AtlasMaterialsConfig = MaterialsConfig;
+
+				auto BuildAtlasTextures = [&]()
+					{
+						for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++)
+						{
+							if (AtlasesPixels[SlotIndex].Num() == 0)
+							{
+								continue;
+							}
+
+							FglTFRuntimeMipMap Mip(-1, EPixelFormat::PF_B8G8R8A8, AtlasWidth, AtlasHeight);
+							Mip.Pixels = MoveTemp(AtlasesPixels[SlotIndex]);
+							TArray<FglTFRuntimeMipMap> Mips;
+							Mips.Add(MoveTemp(Mip));
+
+							FglTFRuntimeImagesConfig ImagesConfig = MaterialsConfig.ImagesConfig;
+							ImagesConfig.bSRGB = glTFRuntime::AtlasTextureSlots[SlotIndex].Value;
+							FglTFRuntimeTextureSampler Sampler;
+							Sampler.TileX = TextureAddress::TA_Clamp;
+							Sampler.TileY = TextureAddress::TA_Clamp;
+
+							UTexture2D* AtlasTexture = BuildTexture(GetTransientPackage(), Mips, ImagesConfig, Sampler);
+							if (AtlasTexture)
+							{
+								// the material keeps the textures alive, but they must survive the gap until it is built
+								FWriteScopeLock Lock(ObjectsCacheLock);
+								AtlasTexturesCache.Add(FString::Printf(TEXT("%s/%d"), *AtlasKey, SlotIndex), AtlasTexture);
+							}
+							AtlasMaterialsConfig.TexturesOverrideMap.Add(NumTextures + SlotIndex, AtlasTexture);
+						}
+					};
+
+				if (IsInGameThread())
+				{
+					BuildAtlasTextures();
+				}
+				else
+				{
+					FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&BuildAtlasTextures]()
+						{
+							// this is mainly for editor ...
+							if (IsGarbageCollecting())
+							{
+								return;
+							}
+							BuildAtlasTextures();
+						}, TStatId(), nullptr, ENamedThreads::GameThread);
+					FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+				}
+
+				AtlasMaterialInterface = LoadMaterial_Internal(FirstItem.MaterialIndex, AtlasMaterialName, JsonAtlasMaterialObject, AtlasMaterialsConfig, bUseVertexColors, nullptr);
+				if (AtlasMaterialInterface)
+				{
+					AtlasLayout.Width = AtlasWidth;
+					AtlasLayout.Height = AtlasHeight;
+					AtlasLayout.MaterialName = AtlasMaterialName;
+					for (const glTFRuntime::FAtlasMaterial* Item : Items)
+					{
+						AtlasLayout.Regions.Add(Item->MaterialIndex, FIntRect(Item->AtlasX, Item->AtlasY, Item->AtlasX + Item->Width, Item->AtlasY + Item->Height));
+					}
+				}
+				else
+				{
+					AddError("AtlasPrimitivesTextures()", "Unable to build atlas material");
+				}
+			}
+
+			if (CanWriteToCache(MaterialsConfig.CacheMode))
+			{
+				FWriteScopeLock Lock(ObjectsCacheLock);
+				AtlasLayoutsCache.Add(AtlasKey, AtlasLayout);
+				if (AtlasMaterialInterface)
+				{
+					AtlasMaterialsCache.Add(AtlasKey, AtlasMaterialInterface);
+				}
+			}
+		}
+
+		if (!AtlasMaterialInterface)
+		{
+			continue;
+		}
+
+		// move the uvs of the primitives in the atlas regions
+		for (const glTFRuntime::FAtlasMaterial* Item : Items)
+		{
+			const FIntRect* Region = AtlasLayout.Regions.Find(Item->MaterialIndex);
+			if (!Region)
+			{
+				continue;
+			}
+
+			const FVector2D RegionOffset(static_cast<double>(Region->Min.X) / AtlasLayout.Width, static_cast<double>(Region->Min.Y) / AtlasLayout.Height);
+			const FVector2D RegionScale(static_cast<double>(Region->Width()) / AtlasLayout.Width, static_cast<double>(Region->Height()) / AtlasLayout.Height);
+
+			for (const int32 PrimitiveIndex : Item->Primitives)
+			{
+				FglTFRuntimePrimitive& Primitive = Primitives[PrimitiveIndex];
+				for (FVector2D& UV : Primitive.UVs[Item->TexCoord])
+				{
+					UV = RegionOffset + glTFRuntime::GetAtlasMaterialUV(*Item, UV) * RegionScale;
+				}
+
+				Primitive.Material = AtlasMaterialInterface;
+				Primitive.MaterialName = AtlasLayout.MaterialName;
+				// atlas materials cannot be retrieved again by index
+				Primitive.MaterialIndex = INDEX_NONE;
+			}
+		}
+	}
+
+	// the deferred materials that have not been atlased
+	for (int32 PrimitiveIndex = FirstPrimitive; PrimitiveIndex < Primitives.Num(); PrimitiveIndex++)
+	{
+		FglTFRuntimePrimitive& Primitive = Primitives[PrimitiveIndex];
+		if (Primitive.Material || !Primitive.bHasMaterial)
+		{
+			continue;
+		}
+
+		Primitive.Material = LoadMaterial(Primitive.MaterialIndex, MaterialsConfig, Primitive.Colors.Num() > 0, Primitive.MaterialName, nullptr);
+		if (!Primitive.Material)
+		{
+			AddError("AtlasPrimitivesTextures()", FString::Printf(TEXT("Unable to load material %lld"), Primitive.MaterialIndex));
+			return false;
+		}
+	}
+
+	return true;
+}
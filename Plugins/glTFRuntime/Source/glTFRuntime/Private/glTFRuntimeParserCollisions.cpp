@@ -0,0 +1,468 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Async/ParallelFor.h"
+#include "StaticMeshResources.h"
+
+namespace glTFRuntime
+{
+	// above this number of triangles the splitting planes are evaluated on a subset of the mesh
+	static constexpr int32 ConvexDecompositionMaxSampledTriangles = 32768;
+	// the hulls used for measuring the concavity are computed by brute force, so limit their vertices
+	static constexpr int32 ConvexDecompositionMaxConcavityDirections = 64;
+
+	struct FConvexHullPlane
+	{
+		FVector Normal;
+		double Distance;
+	};
+
+	struct FConvexDecompositionNode
+	{
+		// INDEX_NONE for leaves
+		int32 Axis = INDEX_NONE;
+		double Threshold = 0;
+		int32 Children[2] = { INDEX_NONE, INDEX_NONE };
+		int32 HullIndex = INDEX_NONE;
+	};
+
+	struct FConvexDecompositionCluster
+	{
+		TArray<int32> Triangles;
+		double Concavity = 0;
+		int32 NodeIndex = INDEX_NONE;
+	};
+
+	struct FConvexDecomposition
+	{
+		TArray<FVector> Positions;
+		TArray<uint32> Indices;
+		TArray<FVector> Centroids;
+		// 26-DOP directions (they come in opposite pairs)
+		TArray<FVector> KDOPDirections;
+		// the support directions of the generated hulls
+		TArray<FVector> ConcavityDirections;
+		TArray<FConvexDecompositionNode> Nodes;
+
+		FConvexDecomposition()
+		{
+			for (int32 X = -1; X <= 1; X++)
+			{
+				for (int32 Y = -1; Y <= 1; Y++)
+				{
+					for (int32 Z = -1; Z <= 1; Z++)
+					{
+						if (X != 0 || Y != 0 || Z != 0)
+						{
+							KDOPDirections.Add(FVector(X, Y, Z).GetSafeNormal());
+						}
+					}
+				}
+			}
+		}
+
+		// the same vertices picked when generating the hull of the cluster
+		void ComputeSupportPoints(const TArray<int32>& Triangles, TArray<FVector>& SupportPoints) const
+		{
+			TArray<double> Support;
+			Support.Init(-MAX_dbl, ConcavityDirections.Num());
+			TArray<uint32> SupportVertices;
+			SupportVertices.Init(0, ConcavityDirections.Num());
+			for (const int32 TriangleIndex : Triangles)
+			{
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const uint32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+					for (int32 DirectionIndex = 0; DirectionIndex < ConcavityDirections.Num(); DirectionIndex++)
+					{
+						const double Distance = FVector::DotProduct(ConcavityDirections[DirectionIndex], Positions[VertexIndex]);
+						if (Distance > Support[DirectionIndex])
+						{
+							Support[DirectionIndex] = Distance;
+							SupportVertices[DirectionIndex] = VertexIndex;
+						}
+					}
+				}
+			}
+
+			TSet<uint32> UniqueVertices;
+			SupportPoints.Reset();
+			for (int32 DirectionIndex = 0; DirectionIndex < ConcavityDirections.Num(); DirectionIndex++)
+			{
+				if (Support[DirectionIndex] > -MAX_dbl && !UniqueVertices.Contains(SupportVertices[DirectionIndex]))
+				{
+					UniqueVertices.Add(SupportVertices[DirectionIndex]);
+					SupportPoints.Add(Positions[SupportVertices[DirectionIndex]]);
+				}
+			}
+		}
+
+		// every plane passing by three points and leaving all of them on the same side is a face of their hull
+		void ComputeHullPlanes(const TArray<FVector>& Points, TArray<FConvexHullPlane>& Planes) const
+		{
+			Planes.Reset();
+			if (Points.Num() < 3)
+			{
+				return;
+			}
+
+			const double Tolerance = FMath::Max(FBox(Points).GetSize().Size() * 1e-6, static_cast<double>(SMALL_NUMBER));
+
+			auto AddPlane = [&Planes, Tolerance](const FVector& Normal, const double Distance)
+				{
+					for (const FConvexHullPlane& Plane : Planes)
+					{
+						if (FVector::DotProduct(Plane.Normal, Normal) > 1 - 1e-6 && FMath::Abs(Plane.Distance - Distance) < Tolerance)
+						{
+							return;
+						}
+					}
+					Planes.Add({ Normal, Distance });
+				};
+
+			for (int32 A = 0; A < Points.Num(); A++)
+			{
+				for (int32 B = A + 1; B < Points.Num(); B++)
+				{
+					for (int32 C = B + 1; C < Points.Num(); C++)
+					{
+						FVector Normal = FVector::CrossProduct(Points[B] - Points[A], Points[C] - Points[A]);
+						if (!Normal.Normalize(SMALL_NUMBER))
+						{
+							continue;
+						}
+
+						const double Distance = FVector::DotProduct(Normal, Points[A]);
+						bool bAbove = false;
+						bool bBelow = false;
+						for (const FVector& Point : Points)
+						{
+							const double PointDistance = FVector::DotProduct(Normal, Point) - Distance;
+							bAbove |= PointDistance > Tolerance;
+							bBelow |= PointDistance < -Tolerance;
+							if (bAbove && bBelow)
+							{
+								break;
+							}
+						}
+
+						// coplanar points generate both the sides of a flat hull
+						if (!bAbove)
+						{
+							AddPlane(Normal, Distance);
+						}
+						if (!bBelow)
+						{
+							AddPlane(-Normal, -Distance);
+						}
+					}
+				}
+			}
+		}
+
+		// a convex patch lies on the boundary of its hull, so the depth of the deepest triangle
+		// (measured against the hull built from the support points of the cluster) is used as the concavity estimation
+		double ComputeConcavity(const TArray<int32>& Triangles) const
+		{
+			TArray<FVector> SupportPoints;
+			ComputeSupportPoints(Triangles, SupportPoints);
+
+			TArray<FConvexHullPlane> Planes;
+			ComputeHullPlanes(SupportPoints, Planes);
+			if (Planes.Num() == 0)
+			{
+				return 0;
+			}
+
+			double MaxDepth = 0;
+			for (const int32 TriangleIndex : Triangles)
+			{
+				double Depth = MAX_dbl;
+				for (const FConvexHullPlane& Plane : Planes)
+				{
+					Depth = FMath::Min<double>(Depth, Plane.Distance - FVector::DotProduct(Plane.Normal, Centroids[TriangleIndex]));
+				}
+				MaxDepth = FMath::Max(MaxDepth, Depth);
+			}
+			return MaxDepth;
+		}
+
+		// try a median cut along each axis and keep the one generating the less concave pair
+		bool Split(const FConvexDecompositionCluster& Cluster, FConvexDecompositionCluster& OutFirst, FConvexDecompositionCluster& OutSecond)
+		{
+			double BestConcavity = MAX_dbl;
+			int32 BestAxis = INDEX_NONE;
+			double BestThreshold = 0;
+
+			for (int32 Axis = 0; Axis < 3; Axis++)
+			{
+				TArray<double> Values;
+				Values.Reserve(Cluster.Triangles.Num());
+				for (const int32 TriangleIndex : Cluster.Triangles)
+				{
+					Values.Add(Centroids[TriangleIndex][Axis]);
+				}
+				Values.Sort();
+
+				const double Threshold = Values[Values.Num() / 2];
+
+				FConvexDecompositionCluster First;
+				FConvexDecompositionCluster Second;
+				for (const int32 TriangleIndex : Cluster.Triangles)
+				{
+					(Centroids[TriangleIndex][Axis] < Threshold ? First : Second).Triangles.Add(TriangleIndex);
+				}
+
+				if (First.Triangles.Num() == 0 || Second.Triangles.Num() == 0)
+				{
+					continue;
+				}
+
+				First.Concavity = ComputeConcavity(First.Triangles);
+				Second.Concavity = ComputeConcavity(Second.Triangles);
+
+				if (First.Concavity + Second.Concavity < BestConcavity)
+				{
+					BestConcavity = First.Concavity + Second.Concavity;
+					BestAxis = Axis;
+					BestThreshold = Threshold;
+					OutFirst = MoveTemp(First);
+					OutSecond = MoveTemp(Second);
+				}
+			}
+
+			if (BestAxis == INDEX_NONE)
+			{
+				return false;
+			}
+
+			OutFirst.NodeIndex = Nodes.AddDefaulted();
+			OutSecond.NodeIndex = Nodes.AddDefaulted();
+
+			FConvexDecompositionNode& Node = Nodes[Cluster.NodeIndex];
+			Node.Axis = BestAxis;
+			Node.Threshold = BestThreshold;
+			Node.Children[0] = OutFirst.NodeIndex;
+			Node.Children[1] = OutSecond.NodeIndex;
+
+			return true;
+		}
+
+		int32 Classify(const int32 TriangleIndex) const
+		{
+			int32 NodeIndex = 0;
+			while (Nodes[NodeIndex].Axis != INDEX_NONE)
+			{
+				const FConvexDecompositionNode& Node = Nodes[NodeIndex];
+				NodeIndex = Node.Children[Centroids[TriangleIndex][Node.Axis] < Node.Threshold ? 0 : 1];
+			}
+			return Nodes[NodeIndex].HullIndex;
+		}
+	};
+
+	static TArray<FVector> GetConvexHullSupportDirections(const int32 NumDirections)
+	{
+		// fibonacci sphere
+		TArray<FVector> Directions;
+		const double GoldenAngle = PI * (3.0 - FMath::Sqrt(5.0));
+		for (int32 Index = 0; Index < NumDirections; Index++)
+		{
+			const double Z = 1.0 - (2.0 * Index + 1.0) / NumDirections;
+			const double Radius = FMath::Sqrt(FMath::Max(0.0, 1.0 - Z * Z));
+			const double Theta = GoldenAngle * Index;
+			Directions.Add(FVector(FMath::Cos(Theta) * Radius, FMath::Sin(Theta) * Radius, Z));
+		}
+		return Directions;
+	}
+}
+
+void FglTFRuntimeParser::BuildStaticMeshConvexDecomposition(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_BuildStaticMeshConvexDecomposition, FColor::Magenta);
+
+	const FglTFRuntimeStaticMeshConfig& StaticMeshConfig = StaticMeshContext->StaticMeshConfig;
+	FStaticMeshRenderData* RenderData = StaticMeshContext->RenderData;
+
+	StaticMeshContext->ConvexHulls.Empty();
+
+	if (!StaticMeshConfig.bBuildConvexDecomposition || StaticMeshConfig.ConvexDecompositionMaxHulls < 1 || !RenderData || RenderData->LODResources.Num() < 1)
+	{
+		return;
+	}
+
+	const FStaticMeshLODResources& LODResources = RenderData->LODResources[0];
+	const FPositionVertexBuffer& PositionVertexBuffer = LODResources.VertexBuffers.PositionVertexBuffer;
+
+	glTFRuntime::FConvexDecomposition Decomposition;
+	LODResources.IndexBuffer.GetCopy(Decomposition.Indices);
+
+	const int32 NumTriangles = Decomposition.Indices.Num() / 3;
+	if (PositionVertexBuffer.GetNumVertices() < 4 || NumTriangles < 1)
+	{
+		return;
+	}
+
+	Decomposition.Positions.AddUninitialized(PositionVertexBuffer.GetNumVertices());
+	for (uint32 VertexIndex = 0; VertexIndex < PositionVertexBuffer.GetNumVertices(); VertexIndex++)
+	{
+		Decomposition.Positions[VertexIndex] = FVector(PositionVertexBuffer.VertexPosition(VertexIndex));
+	}
+
+	Decomposition.Centroids.AddUninitialized(NumTriangles);
+	for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+	{
+		Decomposition.Centroids[TriangleIndex] = (Decomposition.Positions[Decomposition.Indices[TriangleIndex * 3]] +
+			Decomposition.Positions[Decomposition.Indices[TriangleIndex * 3 + 1]] +
+			Decomposition.Positions[Decomposition.Indices[TriangleIndex * 3 + 2]]) / 3.0;
+	}
+
+	const TArray<FVector> SupportDirections = glTFRuntime::GetConvexHullSupportDirections(FMath::Clamp(StaticMeshConfig.ConvexDecompositionMaxHullVertices, 4, 256));
+	Decomposition.ConcavityDirections = glTFRuntime::GetConvexHullSupportDirections(FMath::Min(SupportDirections.Num(), glTFRuntime::ConvexDecompositionMaxConcavityDirections));
+
+	const FBox Bounds(Decomposition.Positions);
+	// stop splitting when the surface is close enough to the hulls
+	const double MinConcavity = Bounds.GetSize().Size() * 0.01;
+	const double MinThickness = FMath::Max(Bounds.GetSize().Size() * 0.001, 0.1);
+
+	TArray<glTFRuntime::FConvexDecompositionCluster> Clusters;
+	glTFRuntime::FConvexDecompositionCluster& RootCluster = Clusters.AddDefaulted_GetRef();
+	const int32 TrianglesStride = FMath::Max(1, NumTriangles / glTFRuntime::ConvexDecompositionMaxSampledTriangles);
+	for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex += TrianglesStride)
+	{
+		RootCluster.Triangles.Add(TriangleIndex);
+	}
+	RootCluster.Concavity = Decomposition.ComputeConcavity(RootCluster.Triangles);
+	RootCluster.NodeIndex = Decomposition.Nodes.AddDefaulted();
+
+	while (Clusters.Num() < StaticMeshConfig.ConvexDecompositionMaxHulls)
+	{
+		int32 ClusterToSplit = INDEX_NONE;
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+		{
+			if (Clusters[ClusterIndex].Triangles.Num() > 1 && Clusters[ClusterIndex].Concavity > MinConcavity && (ClusterToSplit == INDEX_NONE || Clusters[ClusterIndex].Concavity > Clusters[ClusterToSplit].Concavity))
+			{
+				ClusterToSplit = ClusterIndex;
+			}
+		}
+
+		if (ClusterToSplit == INDEX_NONE)
+		{
+			break;
+		}
+
+		glTFRuntime::FConvexDecompositionCluster First;
+		glTFRuntime::FConvexDecompositionCluster Second;
+		if (!Decomposition.Split(Clusters[ClusterToSplit], First, Second))
+		{
+			// cannot be split further
+			Clusters[ClusterToSplit].Concavity = 0;
+			continue;
+		}
+
+		Clusters[ClusterToSplit] = MoveTemp(First);
+		Clusters.Add(MoveTemp(Second));
+	}
+
+	for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+	{
+		Decomposition.Nodes[Clusters[ClusterIndex].NodeIndex].HullIndex = ClusterIndex;
+	}
+
+	// the whole mesh (not only the sampled triangles) contributes to the hulls
+	TArray<int32> TrianglesHulls;
+	TrianglesHulls.AddUninitialized(NumTriangles);
+	ParallelFor(NumTriangles, [&](const int32 TriangleIndex)
+		{
+			TrianglesHulls[TriangleIndex] = Decomposition.Classify(TriangleIndex);
+		});
+
+	TArray<TArray<FVector>> ConvexHulls;
+	ConvexHulls.AddDefaulted(Clusters.Num());
+
+	ParallelFor(Clusters.Num(), [&](const int32 HullIndex)
+		{
+			TArray<double> Support;
+			Support.Init(-MAX_dbl, SupportDirections.Num());
+			TArray<uint32> SupportVertices;
+			SupportVertices.Init(0, SupportDirections.Num());
+
+			TArray<double> KDOPMin;
+			KDOPMin.Init(MAX_dbl, Decomposition.KDOPDirections.Num());
+			TArray<double> KDOPMax;
+			KDOPMax.Init(-MAX_dbl, Decomposition.KDOPDirections.Num());
+
+			for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++)
+			{
+				if (TrianglesHulls[TriangleIndex] != HullIndex)
+				{
+					continue;
+				}
+
+				for (int32 Corner = 0; Corner < 3; Corner++)
+				{
+					const uint32 VertexIndex = Decomposition.Indices[TriangleIndex * 3 + Corner];
+					const FVector& Position = Decomposition.Positions[VertexIndex];
+					for (int32 DirectionIndex = 0; DirectionIndex < SupportDirections.Num(); DirectionIndex++)
+					{
+						const double Distance = FVector::DotProduct(SupportDirections[DirectionIndex], Position);
+						if (Distance > Support[DirectionIndex])
+						{
+							Support[DirectionIndex] = Distance;
+							SupportVertices[DirectionIndex] = VertexIndex;
+						}
+					}
+
+					for (int32 DirectionIndex = 0; DirectionIndex < Decomposition.KDOPDirections.Num(); DirectionIndex++)
+					{
+						const double Distance = FVector::DotProduct(Decomposition.KDOPDirections[DirectionIndex], Position);
+						KDOPMin[DirectionIndex] = FMath::Min(KDOPMin[DirectionIndex], Distance);
+						KDOPMax[DirectionIndex] = FMath::Max(KDOPMax[DirectionIndex], Distance);
+					}
+				}
+			}
+
+			if (Support[0] == -MAX_dbl)
+			{
+				return;
+			}
+
+			TSet<uint32> UniqueVertices;
+			TArray<FVector>& HullVertices = ConvexHulls[HullIndex];
+			for (const uint32 VertexIndex : SupportVertices)
+			{
+				if (!UniqueVertices.Contains(VertexIndex))
+				{
+					UniqueVertices.Add(VertexIndex);
+					HullVertices.Add(Decomposition.Positions[VertexIndex]);
+				}
+			}
+
+			// flat patches would generate degenerate hulls, so give them some thickness
+			int32 ThinnestDirection = 0;
+			for (int32 DirectionIndex = 1; DirectionIndex < Decomposition.KDOPDirections.Num(); DirectionIndex++)
+			{
+				if (KDOPMax[DirectionIndex] - KDOPMin[DirectionIndex] < KDOPMax[ThinnestDirection] - KDOPMin[ThinnestDirection])
+				{
+					ThinnestDirection = DirectionIndex;
+				}
+			}
+
+			if (KDOPMax[ThinnestDirection] - KDOPMin[ThinnestDirection] < MinThickness || HullVertices.Num() < 4)
+			{
+				const FVector Offset = Decomposition.KDOPDirections[ThinnestDirection] * MinThickness;
+				const int32 NumHullVertices = HullVertices.Num();
+				for (int32 HullVertexIndex = 0; HullVertexIndex < NumHullVertices; HullVertexIndex++)
+				{
+					HullVertices.Add(HullVertices[HullVertexIndex] + Offset);
+				}
+			}
+		});
+
+	for (TArray<FVector>& HullVertices : ConvexHulls)
+	{
+		if (HullVertices.Num() >= 4)
+		{
+			StaticMeshContext->ConvexHulls.Add(MoveTemp(HullVertices));
+		}
+	}
+}
@@ -0,0 +1,276 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "StaticMeshResources.h"
+
+namespace glTFRuntime
+{
+	constexpr uint32 DerivedDataMagic = 0x44445447; // GTDD
+	// bump it whenever the layout of the derived data (or the way meshes are generated) changes
+	constexpr uint32 DerivedDataVersion = 1;
+
+	bool SerializeStaticMeshDerivedData(FArchive& Ar, FglTFRuntimeStaticMeshDerivedData& DerivedData)
+	{
+		uint32 Magic = DerivedDataMagic;
+		uint32 Version = DerivedDataVersion;
+		Ar << Magic;
+		Ar << Version;
+		if (Ar.IsError() || Magic != DerivedDataMagic || Version != DerivedDataVersion)
+		{
+			return false;
+		}
+
+		int32 LODsNum = DerivedData.LODs.Num();
+		Ar << LODsNum;
+		if (Ar.IsLoading())
+		{
+			if (Ar.IsError() || LODsNum < 0 || LODsNum > MAX_STATIC_MESH_LODS)
+			{
+				return false;
+			}
+			DerivedData.LODs.SetNum(LODsNum);
+		}
+
+		for (FglTFRuntimeStaticMeshDerivedDataLOD& DerivedDataLOD : DerivedData.LODs)
+		{
+			Ar << DerivedDataLOD.VerticesNum;
+			Ar << DerivedDataLOD.Vertices;
+			Ar << DerivedDataLOD.Indices;
+
+			int32 SectionsNum = DerivedDataLOD.Sections.Num();
+			Ar << SectionsNum;
+			if (Ar.IsLoading())
+			{
+				if (Ar.IsError() || SectionsNum < 0 || SectionsNum > DerivedDataLOD.Indices.Num())
+				{
+					return false;
+				}
+				DerivedDataLOD.Sections.SetNum(SectionsNum);
+			}
+
+			for (FglTFRuntimeStaticMeshDerivedDataSection& DerivedDataSection : DerivedDataLOD.Sections)
+			{
+				Ar << DerivedDataSection.FirstIndex;
+				Ar << DerivedDataSection.NumTriangles;
+				Ar << DerivedDataSection.MaterialIndex;
+				Ar << DerivedDataSection.bCastShadow;
+			}
+
+			Ar << DerivedDataLOD.NumUVs;
+			Ar << DerivedDataLOD.bHighPrecisionUVs;
+			Ar << DerivedDataLOD.bHasVertexColors;
+		}
+
+		int32 MaterialsNum = DerivedData.Materials.Num();
+		Ar << MaterialsNum;
+		if (Ar.IsLoading())
+		{
+			if (Ar.IsError() || MaterialsNum < 0 || MaterialsNum > MAX_uint16)
+			{
+				return false;
+			}
+			DerivedData.Materials.SetNum(MaterialsNum);
+		}
+
+		for (FglTFRuntimeStaticMeshDerivedDataMaterial& DerivedDataMaterial : DerivedData.Materials)
+		{
+			Ar << DerivedDataMaterial.SlotName;
+			Ar << DerivedDataMaterial.MaterialIndex;
+			Ar << DerivedDataMaterial.bUseVertexColors;
+			Ar << DerivedDataMaterial.bVertexColorOnly;
+		}
+
+		Ar << DerivedData.BoundingBoxAndSphere;
+		Ar << DerivedData.LOD0PivotDelta;
+		Ar << DerivedData.LODScreenSize;
+		Ar << DerivedData.AdditionalSockets;
+
+		return !Ar.IsError();
+	}
+}
+
+void FglTFRuntimeParser::SetDerivedDataCache(const FString& Directory, const uint8* SourceDataPtr, const int64 SourceDataNum)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_SetDerivedDataCache, FColor::Magenta);
+
+	DerivedDataCacheDirectory = FPaths::IsRelative(Directory) ? FPaths::Combine(FPaths::ProjectSavedDir(), Directory) : Directory;
+	DerivedDataCacheSourceHash.Empty();
+
+	if (!SourceDataPtr || SourceDataNum <= 0)
+	{
+		return;
+	}
+
+	uint8 Hash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(SourceDataPtr, SourceDataNum, Hash);
+	DerivedDataCacheSourceHash = BytesToHex(Hash, FSHA1::DigestSize);
+}
+
+bool FglTFRuntimeParser::GetDerivedDataCacheBuffersHash(FString& BuffersHash)
+{
+	FScopeLock Lock(&DerivedDataCacheBuffersLock);
+
+	if (!bDerivedDataCacheBuffersHashed)
+	{
+		SCOPED_NAMED_EVENT(FglTFRuntimeParser_GetDerivedDataCacheBuffersHash, FColor::Magenta);
+
+		bDerivedDataCacheBuffersHashed = true;
+		bDerivedDataCacheBuffersValid = true;
+
+		FSHA1 Sha1;
+		const TArray<TSharedPtr<FJsonValue>>* JsonBuffers;
+		if (Root->TryGetArrayField(TEXT("buffers"), JsonBuffers))
+		{
+			for (int32 BufferIndex = 0; BufferIndex < JsonBuffers->Num(); BufferIndex++)
+			{
+				TSharedPtr<FJsonObject> JsonBufferObject = (*JsonBuffers)[BufferIndex]->AsObject();
+				FString Uri;
+				// the GLB chunk and the data uris are already part of the source data
+				if (!JsonBufferObject || !JsonBufferObject->TryGetStringField(TEXT("uri"), Uri) || Uri.StartsWith(TEXT("data:")))
+				{
+					continue;
+				}
+
+				// external buffers are resolved (and cached) the same way the mesh loader will do
+				FglTFRuntimeBlob Blob;
+				if (!GetBuffer(BufferIndex, Blob))
+				{
+					bDerivedDataCacheBuffersValid = false;
+					break;
+				}
+
+				Sha1.Update(reinterpret_cast<const uint8*>(&BufferIndex), sizeof(int32));
+				for (int64 Offset = 0; Offset < Blob.Num; Offset += MAX_uint32)
+				{
+					Sha1.Update(Blob.Data + Offset, static_cast<uint32>(FMath::Min<int64>(Blob.Num - Offset, MAX_uint32)));
+				}
+			}
+		}
+
+		Sha1.Final();
+		uint8 Hash[FSHA1::DigestSize];
+		Sha1.GetHash(Hash);
+		DerivedDataCacheBuffersHash = BytesToHex(Hash, FSHA1::DigestSize);
+	}
+
+	BuffersHash = DerivedDataCacheBuffersHash;
+	return bDerivedDataCacheBuffersValid;
+}
+
+FString FglTFRuntimeParser::GetStaticMeshDerivedDataCacheFilename(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext)
+{
+	if (DerivedDataCacheDirectory.IsEmpty() || DerivedDataCacheSourceHash.IsEmpty() || StaticMeshContext->MeshIndex < 0)
+	{
+		return "";
+	}
+
+	const FglTFRuntimeStaticMeshConfig& StaticMeshConfig = StaticMeshContext->StaticMeshConfig;
+	const FglTFRuntimeMaterialsConfig& MaterialsConfig = StaticMeshConfig.MaterialsConfig;
+
+	// those are not stored in the cache (or could change the result in unpredictable ways)
+	if (StaticMeshConfig.bGenerateStaticMeshDescription || StaticMeshConfig.bBuildLumenCards || MaterialsConfig.bAtlasTextures || MaterialsConfig.MaterialSlotRemapper.Remapper.IsBound() || OnPreCreatedStaticMesh.IsBound() || OnPostCreatedStaticMesh.IsBound() ||
+		OnPreLoadedPrimitive.IsBound() || OnLoadedPrimitive.IsBound())
+	{
+		return "";
+	}
+
+	// images are not part of the derived data (materials and textures are always built from the asset)
+	FString BuffersHash;
+	if (!GetDerivedDataCacheBuffersHash(BuffersHash))
+	{
+		return "";
+	}
+
+	// the whole config is part of the key, so new settings cannot serve stale data
+	FString ConfigKey = FString::Printf(TEXT("%d.%d/%d/%s/%f/"), ENGINE_MAJOR_VERSION, ENGINE_MINOR_VERSION, static_cast<int32>(sizeof(FStaticMeshBuildVertex)), *SceneBasis.ToString(), SceneScale);
+	ConfigKey += GetStaticMeshConfigKey(StaticMeshConfig);
+	ConfigKey += TEXT("/") + BuffersHash;
+
+	const FString ConfigHash = FMD5::HashAnsiString(*ConfigKey);
+
+	return FPaths::Combine(DerivedDataCacheDirectory, FString::Printf(TEXT("%s_%d_%s.gltfddc"), *DerivedDataCacheSourceHash, StaticMeshContext->MeshIndex, *ConfigHash));
+}
+
+UStaticMesh* FglTFRuntimeParser::LoadStaticMeshFromDerivedDataCache(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext)
+{
+	const FString Filename = GetStaticMeshDerivedDataCacheFilename(StaticMeshContext);
+	if (Filename.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadStaticMeshFromDerivedDataCache, FColor::Magenta);
+
+	TArray<uint8> Data;
+	if (IFileManager::Get().FileExists(*Filename) && FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent))
+	{
+		FglTFRuntimeStaticMeshDerivedData DerivedData;
+		FMemoryReader Reader(Data);
+		if (glTFRuntime::SerializeStaticMeshDerivedData(Reader, DerivedData))
+		{
+			UStaticMesh* StaticMesh = LoadStaticMeshFromDerivedData_Internal(StaticMeshContext, DerivedData);
+			if (StaticMesh)
+			{
+				return StaticMesh;
+			}
+		}
+
+		UE_LOG(LogGLTFRuntime, Warning, TEXT("Invalid derived data cache entry %s, it will be regenerated."), *Filename);
+	}
+
+	// record the render data while generating the static mesh
+	StaticMeshContext->DerivedData = MakeShared<FglTFRuntimeStaticMeshDerivedData>();
+	return nullptr;
+}
+
+void FglTFRuntimeParser::WriteStaticMeshToDerivedDataCache(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext)
+{
+	if (!StaticMeshContext->DerivedData.IsValid())
+	{
+		return;
+	}
+
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_WriteStaticMeshToDerivedDataCache, FColor::Magenta);
+
+	// the recorded data is no more useful after this call
+	TSharedPtr<FglTFRuntimeStaticMeshDerivedData> DerivedData = StaticMeshContext->DerivedData;
+	StaticMeshContext->DerivedData.Reset();
+
+	const FString Filename = GetStaticMeshDerivedDataCacheFilename(StaticMeshContext);
+	if (!DerivedData->bCacheable || Filename.IsEmpty() || DerivedData->LODs.Num() != StaticMeshContext->LODs.Num())
+	{
+		return;
+	}
+
+	DerivedData->BoundingBoxAndSphere = StaticMeshContext->BoundingBoxAndSphere;
+	DerivedData->LOD0PivotDelta = StaticMeshContext->LOD0PivotDelta;
+	DerivedData->LODScreenSize = StaticMeshContext->LODScreenSize;
+	DerivedData->AdditionalSockets = StaticMeshContext->AdditionalSockets;
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	if (!glTFRuntime::SerializeStaticMeshDerivedData(Writer, *DerivedData))
+	{
+		return;
+	}
+
+	// write to a temporary file and rename it, so that concurrent loaders never see partial entries
+	const FString TempFilename = FString::Printf(TEXT("%s.%s.tmp"), *Filename, *FGuid::NewGuid().ToString());
+	if (!FFileHelper::SaveArrayToFile(Data, *TempFilename))
+	{
+		UE_LOG(LogGLTFRuntime, Warning, TEXT("Unable to write derived data cache entry %s."), *TempFilename);
+		return;
+	}
+
+	if (!IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		IFileManager::Get().Delete(*TempFilename);
+	}
+}
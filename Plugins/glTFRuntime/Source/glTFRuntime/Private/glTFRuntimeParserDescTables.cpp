@@ -0,0 +1,225 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+
+void FglTFRuntimeParser::BuildDescTables()
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_BuildDescTables, FColor::Magenta);
+
+	const TArray<TSharedPtr<FJsonValue>>* JsonBufferViews;
+	if (Root->TryGetArrayField(TEXT("bufferViews"), JsonBufferViews))
+	{
+		BufferViewsDescs.SetNum(JsonBufferViews->Num());
+		for (int32 BufferViewIndex = 0; BufferViewIndex < JsonBufferViews->Num(); BufferViewIndex++)
+		{
+			const TSharedPtr<FJsonObject>* JsonBufferViewObjectPtr = nullptr;
+			if (!(*JsonBufferViews)[BufferViewIndex]->TryGetObject(JsonBufferViewObjectPtr))
+			{
+				continue;
+			}
+
+			FglTFRuntimeBufferViewDesc& BufferViewDesc = BufferViewsDescs[BufferViewIndex];
+
+			TSharedPtr<FJsonObject> JsonBufferViewObject = *JsonBufferViewObjectPtr;
+			TSharedPtr<FJsonObject> JsonBufferViewCompressedObject = GetJsonObjectExtension(JsonBufferViewObject.ToSharedRef(), "EXT_meshopt_compression");
+			if (JsonBufferViewCompressedObject)
+			{
+				JsonBufferViewObject = JsonBufferViewCompressedObject;
+				BufferViewDesc.bMeshoptCompressed = true;
+			}
+
+			if (!JsonBufferViewObject->TryGetNumberField(TEXT("buffer"), BufferViewDesc.Buffer))
+			{
+				continue;
+			}
+
+			if (!JsonBufferViewObject->TryGetNumberField(TEXT("byteLength"), BufferViewDesc.ByteLength))
+			{
+				continue;
+			}
+
+			if (!JsonBufferViewObject->TryGetNumberField(TEXT("byteOffset"), BufferViewDesc.ByteOffset))
+			{
+				BufferViewDesc.ByteOffset = 0;
+			}
+
+			if (!JsonBufferViewObject->TryGetNumberField(TEXT("byteStride"), BufferViewDesc.ByteStride))
+			{
+				BufferViewDesc.ByteStride = 0;
+			}
+
+			if (BufferViewDesc.bMeshoptCompressed)
+			{
+				if (!JsonBufferViewObject->TryGetNumberField(TEXT("count"), BufferViewDesc.MeshoptCount))
+				{
+					continue;
+				}
+
+				if (!JsonBufferViewObject->TryGetStringField(TEXT("mode"), BufferViewDesc.MeshoptMode))
+				{
+					continue;
+				}
+
+				if (!JsonBufferViewObject->TryGetStringField(TEXT("filter"), BufferViewDesc.MeshoptFilter))
+				{
+					BufferViewDesc.MeshoptFilter = "NONE";
+				}
+			}
+
+			BufferViewDesc.bValid = true;
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* JsonAccessors;
+	if (Root->TryGetArrayField(TEXT("accessors"), JsonAccessors))
+	{
+		AccessorsDescs.SetNum(JsonAccessors->Num());
+		for (int32 AccessorIndex = 0; AccessorIndex < JsonAccessors->Num(); AccessorIndex++)
+		{
+			const TSharedPtr<FJsonObject>* JsonAccessorObject = nullptr;
+			if (!(*JsonAccessors)[AccessorIndex]->TryGetObject(JsonAccessorObject))
+			{
+				continue;
+			}
+
+			FglTFRuntimeAccessorDesc& AccessorDesc = AccessorsDescs[AccessorIndex];
+
+			if (!(*JsonAccessorObject)->TryGetNumberField(TEXT("bufferView"), AccessorDesc.BufferView))
+			{
+				AccessorDesc.BufferView = INDEX_NONE;
+			}
+
+			if (!(*JsonAccessorObject)->TryGetNumberField(TEXT("byteOffset"), AccessorDesc.ByteOffset))
+			{
+				AccessorDesc.ByteOffset = 0;
+			}
+
+			const TSharedPtr<FJsonObject>* JsonSparseObject = nullptr;
+			AccessorDesc.bHasSparse = (*JsonAccessorObject)->TryGetObjectField(TEXT("sparse"), JsonSparseObject);
+
+			AccessorDesc.bHasNormalized = (*JsonAccessorObject)->TryGetBoolField(TEXT("normalized"), AccessorDesc.bNormalized);
+
+			if (!(*JsonAccessorObject)->TryGetNumberField(TEXT("componentType"), AccessorDesc.ComponentType))
+			{
+				continue;
+			}
+
+			if (!(*JsonAccessorObject)->TryGetNumberField(TEXT("count"), AccessorDesc.Count))
+			{
+				continue;
+			}
+
+			FString Type;
+			if (!(*JsonAccessorObject)->TryGetStringField(TEXT("type"), Type))
+			{
+				continue;
+			}
+
+			AccessorDesc.ElementSize = GetComponentTypeSize(AccessorDesc.ComponentType);
+			AccessorDesc.Elements = GetTypeSize(Type);
+
+			AccessorDesc.bValid = AccessorDesc.ElementSize > 0 && AccessorDesc.Elements > 0;
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* JsonNodes;
+	if (Root->TryGetArrayField(TEXT("nodes"), JsonNodes))
+	{
+		NodesDescs.SetNum(JsonNodes->Num());
+		for (int32 NodeIndex = 0; NodeIndex < JsonNodes->Num(); NodeIndex++)
+		{
+			const TSharedPtr<FJsonObject>* JsonNodeObjectPtr = nullptr;
+			if (!(*JsonNodes)[NodeIndex]->TryGetObject(JsonNodeObjectPtr))
+			{
+				continue;
+			}
+
+			TSharedRef<FJsonObject> JsonNodeObject = JsonNodeObjectPtr->ToSharedRef();
+			FglTFRuntimeNodeDesc& NodeDesc = NodesDescs[NodeIndex];
+
+			NodeDesc.bHasName = JsonNodeObject->TryGetStringField(TEXT("name"), NodeDesc.Name);
+			NodeDesc.MeshIndex = GetJsonObjectIndex(JsonNodeObject, "mesh", INDEX_NONE);
+			NodeDesc.SkinIndex = GetJsonObjectIndex(JsonNodeObject, "skin", INDEX_NONE);
+			NodeDesc.CameraIndex = GetJsonObjectIndex(JsonNodeObject, "camera", INDEX_NONE);
+
+			const TArray<TSharedPtr<FJsonValue>>* JsonMatrixValues;
+			if (JsonNodeObject->TryGetArrayField(TEXT("matrix"), JsonMatrixValues))
+			{
+				if (!FillJsonMatrix(JsonMatrixValues, NodeDesc.Matrix))
+				{
+					continue;
+				}
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* JsonScaleValues;
+			if (JsonNodeObject->TryGetArrayField(TEXT("scale"), JsonScaleValues))
+			{
+				FVector MatrixScale;
+				if (!GetJsonVector<3>(JsonScaleValues, MatrixScale))
+				{
+					continue;
+				}
+
+				if (MatrixScale.IsNearlyZero())
+				{
+					NodeDesc.bScaleNeedsToBeReapplied = true;
+					NodeDesc.ScaleToReapply = MatrixScale;
+				}
+
+				NodeDesc.Matrix *= FScaleMatrix(MatrixScale);
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* JsonRotationValues;
+			if (JsonNodeObject->TryGetArrayField(TEXT("rotation"), JsonRotationValues))
+			{
+				FVector4 Vector;
+				if (!GetJsonVector<4>(JsonRotationValues, Vector))
+				{
+					continue;
+				}
+				FQuat Quat = { Vector.X, Vector.Y, Vector.Z, Vector.W };
+				NodeDesc.Matrix *= FQuatRotationMatrix(Quat);
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* JsonTranslationValues;
+			if (JsonNodeObject->TryGetArrayField(TEXT("translation"), JsonTranslationValues))
+			{
+				FVector Translation;
+				if (!GetJsonVector<3>(JsonTranslationValues, Translation))
+				{
+					continue;
+				}
+
+				NodeDesc.Matrix *= FTranslationMatrix(Translation);
+			}
+
+			NodeDesc.FirstChild = NodesChildrenTable.Num();
+
+			bool bValidChildren = true;
+			const TArray<TSharedPtr<FJsonValue>>* JsonChildren;
+			if (JsonNodeObject->TryGetArrayField(TEXT("children"), JsonChildren))
+			{
+				for (const TSharedPtr<FJsonValue>& JsonChild : *JsonChildren)
+				{
+					int64 ChildIndex;
+					if (!JsonChild->TryGetNumber(ChildIndex) || ChildIndex >= JsonNodes->Num())
+					{
+						bValidChildren = false;
+						break;
+					}
+
+					NodesChildrenTable.Add(static_cast<int32>(ChildIndex));
+				}
+			}
+
+			if (!bValidChildren)
+			{
+				NodesChildrenTable.SetNum(NodeDesc.FirstChild);
+				continue;
+			}
+
+			NodeDesc.ChildrenNum = NodesChildrenTable.Num() - NodeDesc.FirstChild;
+			NodeDesc.bValid = true;
+		}
+	}
+}
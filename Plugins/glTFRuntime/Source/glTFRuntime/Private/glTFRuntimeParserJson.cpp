@@ -0,0 +1,545 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace glTFRuntime
+{
+	/*
+	* Single pass UTF-8 JSON parser building the same DOM of FJsonSerializer,
+	* but without converting the whole document to UTF-16 and without the per-character
+	* virtual calls of TJsonReader. Strings are scanned 8 bytes at a time (SWAR).
+	*/
+	class FJsonUTF8Parser
+	{
+	public:
+		FJsonUTF8Parser(const uint8* InData, const int64 InNum) : Data(InData), Num(InNum), Offset(0), bError(false)
+		{
+			// skip UTF-8 BOM
+			if (Num >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+			{
+				Offset = 3;
+			}
+		}
+
+		TSharedPtr<FJsonObject> Parse()
+		{
+			SkipWhitespaces();
+			if (Offset >= Num || Data[Offset] != '{')
+			{
+				return nullptr;
+			}
+
+			TSharedPtr<FJsonValue> RootValue = ParseValue(0);
+			if (bError || !RootValue)
+			{
+				return nullptr;
+			}
+
+			SkipWhitespaces();
+			// allow trailing nulls (common in GLB JSON chunks padding)
+			while (Offset < Num && Data[Offset] == 0)
+			{
+				Offset++;
+			}
+
+			if (Offset != Num)
+			{
+				return nullptr;
+			}
+
+			return RootValue->AsObject();
+		}
+
+	private:
+		static constexpr int32 MaxDepth = 512;
+
+		const uint8* Data;
+		const int64 Num;
+		int64 Offset;
+		bool bError;
+		TArray<ANSICHAR> EscapedString;
+
+		FORCEINLINE void SkipWhitespaces()
+		{
+			while (Offset < Num)
+			{
+				const uint8 Char = Data[Offset];
+				if (Char != ' ' && Char != '\n' && Char != '\r' && Char != '\t')
+				{
+					break;
+				}
+				Offset++;
+			}
+		}
+
+		FORCEINLINE bool Expect(const ANSICHAR* Literal, const int32 LiteralLen)
+		{
+			if (Offset + LiteralLen > Num || FMemory::Memcmp(Data + Offset, Literal, LiteralLen) != 0)
+			{
+				bError = true;
+				return false;
+			}
+			Offset += LiteralLen;
+			return true;
+		}
+
+		// returns the offset of the first '"', '\\' or control char starting from Offset
+		FORCEINLINE int64 FindStringSpecialChar(int64 Current) const
+		{
+			constexpr uint64 Ones = 0x0101010101010101ULL;
+			constexpr uint64 Highs = 0x8080808080808080ULL;
+			while (Current + 8 <= Num)
+			{
+				uint64 Word;
+				FMemory::Memcpy(&Word, Data + Current, 8);
+				const uint64 Quotes = Word ^ (Ones * '"');
+				const uint64 Backslashes = Word ^ (Ones * '\\');
+				// a byte is zero (a match) or lower than 0x20 (a control char)
+				const uint64 Matches = ((Quotes - Ones) & ~Quotes) | ((Backslashes - Ones) & ~Backslashes) | ((Word - Ones * 0x20) & ~Word);
+				if (Matches & Highs)
+				{
+					break;
+				}
+				Current += 8;
+			}
+
+			while (Current < Num)
+			{
+				const uint8 Char = Data[Current];
+				if (Char == '"' || Char == '\\' || Char < 0x20)
+				{
+					return Current;
+				}
+				Current++;
+			}
+
+			return Current;
+		}
+
+		static void AppendUTF8(TArray<ANSICHAR>& Output, uint32 CodePoint)
+		{
+			if (CodePoint < 0x80)
+			{
+				Output.Add(static_cast<ANSICHAR>(CodePoint));
+			}
+			else if (CodePoint < 0x800)
+			{
+				Output.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+				Output.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+			else if (CodePoint < 0x10000)
+			{
+				Output.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+				Output.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+				Output.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+			else
+			{
+				Output.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+				Output.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+				Output.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+				Output.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+			}
+		}
+
+		bool ParseHex4(uint32& CodePoint)
+		{
+			if (Offset + 4 > Num)
+			{
+				return false;
+			}
+
+			CodePoint = 0;
+			for (int32 HexIndex = 0; HexIndex < 4; HexIndex++)
+			{
+				const uint8 Char = Data[Offset++];
+				CodePoint <<= 4;
+				if (Char >= '0' && Char <= '9')
+				{
+					CodePoint |= Char - '0';
+				}
+				else if (Char >= 'a' && Char <= 'f')
+				{
+					CodePoint |= Char - 'a' + 10;
+				}
+				else if (Char >= 'A' && Char <= 'F')
+				{
+					CodePoint |= Char - 'A' + 10;
+				}
+				else
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool ParseString(FString& Value)
+		{
+			// skip the opening quote
+			Offset++;
+
+			const int64 Start = Offset;
+			int64 End = FindStringSpecialChar(Offset);
+			if (End >= Num)
+			{
+				return false;
+			}
+
+			// fast path: no escapes
+			if (Data[End] == '"')
+			{
+				const int32 Len = static_cast<int32>(End - Start);
+				if (Len > 0)
+				{
+					FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + Start), Len);
+					Value = FString(Converter.Length(), Converter.Get());
+				}
+				Offset = End + 1;
+				return true;
+			}
+
+			EscapedString.Reset();
+			EscapedString.Append(reinterpret_cast<const ANSICHAR*>(Data + Start), static_cast<int32>(End - Start));
+			Offset = End;
+
+			for (;;)
+			{
+				if (Offset >= Num)
+				{
+					return false;
+				}
+
+				const uint8 Char = Data[Offset];
+				if (Char == '"')
+				{
+					Offset++;
+					break;
+				}
+
+				if (Char < 0x20)
+				{
+					return false;
+				}
+
+				if (Char != '\\')
+				{
+					End = FindStringSpecialChar(Offset);
+					EscapedString.Append(reinterpret_cast<const ANSICHAR*>(Data + Offset), static_cast<int32>(End - Offset));
+					Offset = End;
+					continue;
+				}
+
+				Offset++;
+				if (Offset >= Num)
+				{
+					return false;
+				}
+
+				const uint8 Escape = Data[Offset++];
+				switch (Escape)
+				{
+				case '"':
+				case '\\':
+				case '/':
+					EscapedString.Add(static_cast<ANSICHAR>(Escape));
+					break;
+				case 'b':
+					EscapedString.Add('\b');
+					break;
+				case 'f':
+					EscapedString.Add('\f');
+					break;
+				case 'n':
+					EscapedString.Add('\n');
+					break;
+				case 'r':
+					EscapedString.Add('\r');
+					break;
+				case 't':
+					EscapedString.Add('\t');
+					break;
+				case 'u':
+				{
+					uint32 CodePoint = 0;
+					if (!ParseHex4(CodePoint))
+					{
+						return false;
+					}
+					// surrogate pair ?
+					if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Offset + 6 <= Num && Data[Offset] == '\\' && Data[Offset + 1] == 'u')
+					{
+						Offset += 2;
+						uint32 LowSurrogate = 0;
+						if (!ParseHex4(LowSurrogate))
+						{
+							return false;
+						}
+						if (LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+						{
+							CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+						}
+					}
+					AppendUTF8(EscapedString, CodePoint);
+					break;
+				}
+				default:
+					return false;
+				}
+			}
+
+			if (EscapedString.Num() > 0)
+			{
+				FUTF8ToTCHAR Converter(EscapedString.GetData(), EscapedString.Num());
+				Value = FString(Converter.Length(), Converter.Get());
+			}
+			return true;
+		}
+
+		bool ParseNumber(double& Value)
+		{
+			const int64 Start = Offset;
+			bool bNegative = false;
+			if (Data[Offset] == '-')
+			{
+				bNegative = true;
+				Offset++;
+			}
+
+			// fast path for plain integers (the vast majority of glTF numbers)
+			uint64 Integer = 0;
+			int32 Digits = 0;
+			while (Offset < Num && Data[Offset] >= '0' && Data[Offset] <= '9')
+			{
+				Integer = Integer * 10 + (Data[Offset] - '0');
+				Offset++;
+				Digits++;
+			}
+
+			if (Digits == 0)
+			{
+				return false;
+			}
+
+			const bool bIsFloat = Offset < Num && (Data[Offset] == '.' || Data[Offset] == 'e' || Data[Offset] == 'E');
+			if (!bIsFloat && Digits <= 15)
+			{
+				Value = bNegative ? -static_cast<double>(Integer) : static_cast<double>(Integer);
+				return true;
+			}
+
+			while (Offset < Num && ((Data[Offset] >= '0' && Data[Offset] <= '9') || Data[Offset] == '.' || Data[Offset] == 'e' || Data[Offset] == 'E' || Data[Offset] == '+' || Data[Offset] == '-'))
+			{
+				Offset++;
+			}
+
+			ANSICHAR NumberString[128];
+			const int64 NumberLen = Offset - Start;
+			if (NumberLen >= UE_ARRAY_COUNT(NumberString))
+			{
+				return false;
+			}
+			FMemory::Memcpy(NumberString, Data + Start, NumberLen);
+			NumberString[NumberLen] = 0;
+			Value = FCStringAnsi::Atod(NumberString);
+			return true;
+		}
+
+		TSharedPtr<FJsonValue> ParseValue(const int32 Depth)
+		{
+			if (Depth > MaxDepth)
+			{
+				bError = true;
+				return nullptr;
+			}
+
+			SkipWhitespaces();
+			if (Offset >= Num)
+			{
+				bError = true;
+				return nullptr;
+			}
+
+			const uint8 Char = Data[Offset];
+			if (Char == '{')
+			{
+				Offset++;
+				TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+				SkipWhitespaces();
+				if (Offset < Num && Data[Offset] == '}')
+				{
+					Offset++;
+					return MakeShared<FJsonValueObject>(JsonObject);
+				}
+
+				for (;;)
+				{
+					SkipWhitespaces();
+					FString Key;
+					if (Offset >= Num || Data[Offset] != '"' || !ParseString(Key))
+					{
+						bError = true;
+						return nullptr;
+					}
+
+					SkipWhitespaces();
+					if (Offset >= Num || Data[Offset] != ':')
+					{
+						bError = true;
+						return nullptr;
+					}
+					Offset++;
+
+					TSharedPtr<FJsonValue> Value = ParseValue(Depth + 1);
+					if (!Value)
+					{
+						return nullptr;
+					}
+					JsonObject->Values.Add(MoveTemp(Key), Value);
+
+					SkipWhitespaces();
+					if (Offset >= Num)
+					{
+						bError = true;
+						return nullptr;
+					}
+
+					if (Data[Offset] == ',')
+					{
+						Offset++;
+						continue;
+					}
+
+					if (Data[Offset] == '}')
+					{
+						Offset++;
+						return MakeShared<FJsonValueObject>(JsonObject);
+					}
+
+					bError = true;
+					return nullptr;
+				}
+			}
+
+			if (Char == '[')
+			{
+				Offset++;
+				TArray<TSharedPtr<FJsonValue>> Items;
+				SkipWhitespaces();
+				if (Offset < Num && Data[Offset] == ']')
+				{
+					Offset++;
+					return MakeShared<FJsonValueArray>(Items);
+				}
+
+				for (;;)
+				{
+					TSharedPtr<FJsonValue> Value = ParseValue(Depth + 1);
+					if (!Value)
+					{
+						return nullptr;
+					}
+					Items.Add(Value);
+
+					SkipWhitespaces();
+					if (Offset >= Num)
+					{
+						bError = true;
+						return nullptr;
+					}
+
+					if (Data[Offset] == ',')
+					{
+						Offset++;
+						continue;
+					}
+
+					if (Data[Offset] == ']')
+					{
+						Offset++;
+						return MakeShared<FJsonValueArray>(Items);
+					}
+
+					bError = true;
+					return nullptr;
+				}
+			}
+
+			if (Char == '"')
+			{
+				FString Value;
+				if (!ParseString(Value))
+				{
+					bError = true;
+					return nullptr;
+				}
+				return MakeShared<FJsonValueString>(Value);
+			}
+
+			if (Char == '-' || (Char >= '0' && Char <= '9'))
+			{
+				double Value = 0;
+				if (!ParseNumber(Value))
+				{
+					bError = true;
+					return nullptr;
+				}
+				return MakeShared<FJsonValueNumber>(Value);
+			}
+
+			if (Char == 't')
+			{
+				return Expect("true", 4) ? MakeShared<FJsonValueBoolean>(true) : nullptr;
+			}
+
+			if (Char == 'f')
+			{
+				return Expect("false", 5) ? MakeShared<FJsonValueBoolean>(false) : nullptr;
+			}
+
+			if (Char == 'n')
+			{
+				return Expect("null", 4) ? MakeShared<FJsonValueNull>() : nullptr;
+			}
+
+			bError = true;
+			return nullptr;
+		}
+	};
+}
+
+TSharedPtr<FJsonObject> FglTFRuntimeParser::ParseJsonUTF8(const uint8* DataPtr, const int64 DataNum)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_ParseJsonUTF8, FColor::Magenta);
+
+	if (!DataPtr || DataNum <= 0)
+	{
+		return nullptr;
+	}
+
+	glTFRuntime::FJsonUTF8Parser JsonParser(DataPtr, DataNum);
+	return JsonParser.Parse();
+}
+
+TSharedPtr<FglTFRuntimeParser> FglTFRuntimeParser::FromUTF8(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FromUTF8, FColor::Magenta);
+
+	TSharedPtr<FJsonObject> JsonObject = ParseJsonUTF8(DataPtr, DataNum);
+	if (JsonObject)
+	{
+		return FromJsonObject(JsonObject.ToSharedRef(), LoaderConfig, InArchive);
+	}
+
+	// fallback to the slower (but more tolerant, e.g. UTF-16) path
+	if (DataNum > 0 && DataNum <= INT32_MAX)
+	{
+		FString JsonData;
+		FFileHelper::BufferToString(JsonData, DataPtr, static_cast<int32>(DataNum));
+		return FromString(JsonData, LoaderConfig, InArchive);
+	}
+
+	return nullptr;
+}
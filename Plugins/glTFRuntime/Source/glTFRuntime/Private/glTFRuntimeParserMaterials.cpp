@@ -7,6 +7,7 @@
 #include "IImageWrapper.h"
 #include "ImageUtils.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 2
 #include "MaterialDomain.h"
 #else
@@ -24,6 +25,14 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial_Internal(const int32 Index,
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadMaterial_Internal, FColor::Magenta);
 	FglTFRuntimeMaterial RuntimeMaterial;
 
+	// the decoded images are pinned only while the material textures are being loaded
+	TArray<int32> ImagesIndices;
+	AcquireMaterialImagesReferences(JsonMaterialObject, ImagesIndices);
+	ON_SCOPE_EXIT
+	{
+		ReleaseMaterialImagesReferences(ImagesIndices);
+	};
+
 	const FString Generator = GetGenerator();
 	bool bSpecularAutoDetected = false;
 	if (Generator.Contains("Blender") || Generator.Contains("Unreal Engine"))
@@ -457,7 +466,24 @@ UTexture2D* FglTFRuntimeParser::BuildTexture(UObject* Outer, const TArray<FglTFR
 
 	if (Mips[0].TextureIndex >= 0)
 	{
-		TexturesCache.Add(Mips[0].TextureIndex, Texture);
+		{
+			// a concurrent load of the same texture could have already published it, the first one wins
+			FWriteScopeLock Lock(ObjectsCacheLock);
+			if (!TexturesCache.Contains(Mips[0].TextureIndex))
+			{
+				TexturesCache.Add(Mips[0].TextureIndex, Texture);
+			}
+		}
+
+		if (bShareAssets)
+		{
+			FString SharedAssetKey;
+			{
+				FScopeLock Lock(&SharedAssetsKeysLock);
+				SharedTexturesPendingKeys.RemoveAndCopyValue(Mips[0].TextureIndex, SharedAssetKey);
+			}
+			AddSharedAsset(SharedAssetKey, Texture);
+		}
 	}
 
 	FillAssetUserData(Mips[0].TextureIndex, Texture);
@@ -1093,6 +1119,121 @@ bool FglTFRuntimeParser::LoadImage(const int32 ImageIndex, TArray64<uint8>& Unco
 	return LoadImageFromBlob(Bytes, JsonImageObject.ToSharedRef(), UncompressedBytes, Width, Height, PixelFormat, ImagesConfig);
 }
 
+void FglTFRuntimeParser::AcquireMaterialImagesReferences(TSharedRef<FJsonObject> JsonMaterialObject, TArray<int32>& ImagesIndices)
+{
+	TFunction<void(const TSharedRef<FJsonObject>)> GatherTexturesImages = [this, &GatherTexturesImages, &ImagesIndices](const TSharedRef<FJsonObject> JsonObject)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonObject->Values)
+			{
+				const TSharedPtr<FJsonObject>* JsonChildObject = nullptr;
+				if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(JsonChildObject))
+				{
+					continue;
+				}
+
+				int64 TextureIndex = INDEX_NONE;
+				if (!Pair.Key.EndsWith(TEXT("Texture")) || !(*JsonChildObject)->TryGetNumberField(TEXT("index"), TextureIndex))
+				{
+					GatherTexturesImages(JsonChildObject->ToSharedRef());
+					continue;
+				}
+
+				TSharedPtr<FJsonObject> JsonTextureObject = GetJsonObjectFromRootIndex("textures", TextureIndex);
+				if (!JsonTextureObject)
+				{
+					continue;
+				}
+
+				int64 ImageIndex = INDEX_NONE;
+				OnTextureImageIndex.Broadcast(AsShared(), JsonTextureObject.ToSharedRef(), ImageIndex);
+
+				if (ImageIndex > INDEX_NONE || JsonTextureObject->TryGetNumberField(TEXT("source"), ImageIndex))
+				{
+					ImagesIndices.Add(static_cast<int32>(ImageIndex));
+				}
+			}
+		};
+
+	GatherTexturesImages(JsonMaterialObject);
+
+	FScopeLock Lock(&DecodedImagesCacheLock);
+	for (const int32 ImageIndex : ImagesIndices)
+	{
+		ImagesRemainingReferences.FindOrAdd(ImageIndex)++;
+	}
+}
+
+void FglTFRuntimeParser::ReleaseMaterialImagesReferences(const TArray<int32>& ImagesIndices)
+{
+	FScopeLock Lock(&DecodedImagesCacheLock);
+	for (const int32 ImageIndex : ImagesIndices)
+	{
+		int32* RemainingReferences = ImagesRemainingReferences.Find(ImageIndex);
+		if (!RemainingReferences || *RemainingReferences <= 1)
+		{
+			ImagesRemainingReferences.Remove(ImageIndex);
+			DecodedImagesCache.Remove(ImageIndex);
+			continue;
+		}
+
+		(*RemainingReferences)--;
+	}
+}
+
+bool FglTFRuntimeParser::LoadImageFromBlobCached(const int32 ImageIndex, const TArray64<uint8>& Blob, TSharedRef<FJsonObject> JsonImageObject, TArray64<uint8>& UncompressedBytes, int32& Width, int32& Height, EPixelFormat& PixelFormat, const FglTFRuntimeImagesConfig& ImagesConfig)
+{
+	if (ImageIndex < 0)
+	{
+		return LoadImageFromBlob(Blob, JsonImageObject, UncompressedBytes, Width, Height, PixelFormat, ImagesConfig);
+	}
+
+	const FString DecodeKey = FString::Printf(TEXT("%d/%d/%d/%d"), ImagesConfig.bForceHDR ? 1 : 0, ImagesConfig.bVerticalFlip ? 1 : 0, ImagesConfig.bForceAutoDetect ? 1 : 0, static_cast<int32>(ImagesConfig.ForcePixelFormat));
+
+	TSharedPtr<const FglTFRuntimeDecodedImage> DecodedImage;
+	{
+		FScopeLock Lock(&DecodedImagesCacheLock);
+		if (const TSharedPtr<const FglTFRuntimeDecodedImage>* CachedImage = DecodedImagesCache.Find(ImageIndex))
+		{
+			if ((*CachedImage)->DecodeKey == DecodeKey)
+			{
+				DecodedImage = *CachedImage;
+			}
+		}
+	}
+
+	// the cached pixels are never modified, so they can be copied without holding the lock
+	if (DecodedImage)
+	{
+		UncompressedBytes = DecodedImage->Pixels;
+		Width = DecodedImage->Width;
+		Height = DecodedImage->Height;
+		PixelFormat = DecodedImage->PixelFormat;
+		return true;
+	}
+
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadImageFromBlobCached, FColor::Magenta);
+
+	if (!LoadImageFromBlob(Blob, JsonImageObject, UncompressedBytes, Width, Height, PixelFormat, ImagesConfig))
+	{
+		return false;
+	}
+
+	// keep it only if other texture slots of the materials being loaded could need it
+	FScopeLock Lock(&DecodedImagesCacheLock);
+	if (ImagesRemainingReferences.FindRef(ImageIndex) > 1 && !DecodedImagesCache.Contains(ImageIndex))
+	{
+		TSharedRef<FglTFRuntimeDecodedImage> NewDecodedImage = MakeShared<FglTFRuntimeDecodedImage>();
+		NewDecodedImage->DecodeKey = DecodeKey;
+		NewDecodedImage->Pixels = UncompressedBytes;
+		NewDecodedImage->Width = Width;
+		NewDecodedImage->Height = Height;
+		NewDecodedImage->PixelFormat = PixelFormat;
+		DecodedImagesCache.Add(ImageIndex, NewDecodedImage);
+	}
+
+	return true;
+}
+
 UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig, FglTFRuntimeTextureSampler& Sampler)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadTexture, FColor::Magenta);
@@ -1107,12 +1248,6 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 		return MaterialsConfig.TexturesOverrideMap[TextureIndex];
 	}
 
-	// first check cache
-	if (TexturesCache.Contains(TextureIndex))
-	{
-		return TexturesCache[TextureIndex];
-	}
-
 	const TArray<TSharedPtr<FJsonValue>>* JsonTextures;
 	// no images ?
 	if (!Root->TryGetArrayField(TEXT("textures"), JsonTextures))
@@ -1144,6 +1279,59 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 		return MaterialsConfig.ImagesOverrideMap[ImageIndex];
 	}
 
+	// first check cache (another texture could have already loaded the same image with the same sampler and color space)
+	{
+		int64 SamplerIndex = INDEX_NONE;
+		JsonTextureObject->TryGetNumberField(TEXT("sampler"), SamplerIndex);
+		const FString VariantKey = FString::Printf(TEXT("%lld/%lld/%d/%d"), ImageIndex, SamplerIndex, sRGB ? 1 : 0, static_cast<int32>(MaterialsConfig.ImagesConfig.Compression));
+
+		UTexture2D* CachedTexture = nullptr;
+		{
+			FWriteScopeLock Lock(ObjectsCacheLock);
+			if (!TexturesCache.Contains(TextureIndex))
+			{
+				if (const int32* VariantTextureIndex = TexturesVariantsCache.Find(VariantKey))
+				{
+					if (TexturesCache.Contains(*VariantTextureIndex))
+					{
+						CachedTexture = TexturesCache[*VariantTextureIndex];
+						TexturesCache.Add(TextureIndex, CachedTexture);
+					}
+				}
+				else
+				{
+					TexturesVariantsCache.Add(VariantKey, TextureIndex);
+				}
+			}
+			else
+			{
+				CachedTexture = TexturesCache[TextureIndex];
+			}
+		}
+
+		if (CachedTexture)
+		{
+			return CachedTexture;
+		}
+	}
+
+	if (bShareAssets)
+	{
+		const FString SharedAssetKey = GetSharedTextureKey(TextureIndex, sRGB, MaterialsConfig);
+		if (UTexture2D* SharedTexture = Cast<UTexture2D>(FindSharedAsset(SharedAssetKey)))
+		{
+			{
+				FWriteScopeLock Lock(ObjectsCacheLock);
+				TexturesCache.Add(TextureIndex, SharedTexture);
+			}
+			return SharedTexture;
+		}
+
+		// the texture will be registered by BuildTexture()
+		FScopeLock Lock(&SharedAssetsKeysLock);
+		SharedTexturesPendingKeys.Add(TextureIndex, SharedAssetKey);
+	}
+
 	TSharedPtr<FJsonObject> JsonImageObject;
 	TArray64<uint8> CompressedBytes;
 	if (!LoadImageBytes(ImageIndex, JsonImageObject, CompressedBytes))
@@ -1151,7 +1339,7 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 		return nullptr;
 	}
 
-	if (!LoadBlobToMips(TextureIndex, JsonTextureObject.ToSharedRef(), JsonImageObject.ToSharedRef(), CompressedBytes, Mips, sRGB, MaterialsConfig))
+	if (!LoadBlobToMips(TextureIndex, JsonTextureObject.ToSharedRef(), JsonImageObject.ToSharedRef(), CompressedBytes, Mips, sRGB, MaterialsConfig, ImageIndex))
 	{
 		return nullptr;
 	}
@@ -1224,7 +1412,7 @@ UTexture2D* FglTFRuntimeParser::LoadTexture(const int32 TextureIndex, TArray<Fgl
 	return nullptr;
 }
 
-bool FglTFRuntimeParser::LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJsonObject> JsonTextureObject, TSharedRef<FJsonObject> JsonImageObject, const TArray64<uint8>& Blob, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+bool FglTFRuntimeParser::LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJsonObject> JsonTextureObject, TSharedRef<FJsonObject> JsonImageObject, const TArray64<uint8>& Blob, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const int32 ImageIndex)
 {
 	if (MaterialsConfig.bLoadMipMaps)
 	{
@@ -1247,7 +1435,7 @@ bool FglTFRuntimeParser::LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJs
 		int32 Width = 0;
 		int32 Height = 0;
 		EPixelFormat PixelFormat;
-		if (!LoadImageFromBlob(Blob, JsonImageObject, UncompressedBytes, Width, Height, PixelFormat, MaterialsConfig.ImagesConfig))
+		if (!LoadImageFromBlobCached(ImageIndex, Blob, JsonImageObject, UncompressedBytes, Width, Height, PixelFormat, MaterialsConfig.ImagesConfig))
 		{
 			return false;
 		}
@@ -1358,13 +1546,17 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial(const int32 Index, const Fg
 	}
 
 	// first check cache
-	if (CanReadFromCache(MaterialsConfig.CacheMode) && MaterialsCache.Contains(Index))
+	if (CanReadFromCache(MaterialsConfig.CacheMode))
 	{
-		if (MaterialsNameCache.Contains(MaterialsCache[Index]))
+		FReadScopeLock Lock(ObjectsCacheLock);
+		if (MaterialsCache.Contains(Index))
 		{
-			MaterialName = MaterialsNameCache[MaterialsCache[Index]];
+			if (MaterialsNameCache.Contains(Index))
+			{
+				MaterialName = MaterialsNameCache[Index];
+			}
+			return MaterialsCache[Index];
 		}
-		return MaterialsCache[Index];
 	}
 
 	const TArray<TSharedPtr<FJsonValue>>* JsonMaterials;
@@ -1402,20 +1594,81 @@ UMaterialInterface* FglTFRuntimeParser::LoadMaterial(const int32 Index, const Fg
 		return MaterialsConfig.MaterialsOverrideByNameMap[MaterialName];
 	}
 
-	UMaterialInterface* Material = LoadMaterial_Internal(Index, MaterialName, JsonMaterialObject.ToSharedRef(), MaterialsConfig, bUseVertexColors, ForceBaseMaterial);
+	FString SharedAssetKey;
+	FString CanonicalKey;
+	UMaterialInterface* Material = nullptr;
+	bool bIsCanonicalDuplicate = false;
+
+	if (MaterialsConfig.bDeduplicateMaterials)
+	{
+		CanonicalKey = GetCanonicalMaterialKey(Index, MaterialName, MaterialsConfig, bUseVertexColors, ForceBaseMaterial);
+		if (!CanonicalKey.IsEmpty())
+		{
+			FReadScopeLock Lock(ObjectsCacheLock);
+			if (CanonicalMaterialsCache.Contains(CanonicalKey))
+			{
+				Material = CanonicalMaterialsCache[CanonicalKey];
+				bIsCanonicalDuplicate = true;
+			}
+		}
+	}
+
+	if (!Material && bShareAssets)
+	{
+		SharedAssetKey = CanonicalKey.IsEmpty() ? GetSharedMaterialKey(Index, MaterialsConfig, bUseVertexColors, ForceBaseMaterial) : CanonicalKey;
+		Material = Cast<UMaterialInterface>(FindSharedAsset(SharedAssetKey));
+	}
+
 	if (!Material)
 	{
-		AddError("LoadMaterial()", "Unable to load material");
-		return nullptr;
+		Material = LoadMaterial_Internal(Index, MaterialName, JsonMaterialObject.ToSharedRef(), MaterialsConfig, bUseVertexColors, ForceBaseMaterial);
+		if (!Material)
+		{
+			AddError("LoadMaterial()", "Unable to load material");
+			return nullptr;
+		}
+
+		AddSharedAsset(SharedAssetKey, Material);
+	}
+
+	if (!CanonicalKey.IsEmpty() && !bIsCanonicalDuplicate)
+	{
+		FWriteScopeLock Lock(ObjectsCacheLock);
+		// a concurrent load of an identical material could have already published it, the first one wins
+		if (CanonicalMaterialsCache.Contains(CanonicalKey))
+		{
+			Material = CanonicalMaterialsCache[CanonicalKey];
+			bIsCanonicalDuplicate = true;
+		}
+		else
+		{
+			CanonicalMaterialsCache.Add(CanonicalKey, Material);
+		}
 	}
 
 	if (CanWriteToCache(MaterialsConfig.CacheMode))
 	{
-		MaterialsNameCache.Add(Material, MaterialName);
-		MaterialsCache.Add(Index, Material);
+		FWriteScopeLock Lock(ObjectsCacheLock);
+		// a concurrent load of the same material could have already published it, the first one wins
+		if (CanReadFromCache(MaterialsConfig.CacheMode) && MaterialsCache.Contains(Index))
+		{
+			Material = MaterialsCache[Index];
+			if (MaterialsNameCache.Contains(Index))
+			{
+				MaterialName = MaterialsNameCache[Index];
+			}
+		}
+		else
+		{
+			MaterialsNameCache.Add(Index, MaterialName);
+			MaterialsCache.Add(Index, Material);
+		}
 	}
 
-	FillAssetUserData(Index, Material);
+	if (!bIsCanonicalDuplicate)
+	{
+		FillAssetUserData(Index, Material);
+	}
 
 	return Material;
 }
@@ -0,0 +1,1325 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+
+namespace glTFRuntime
+{
+	// Garland-Heckbert quadric (symmetric 3x3 matrix + vector + constant)
+	struct FQuadric
+	{
+		double A00 = 0;
+		double A11 = 0;
+		double A22 = 0;
+		double A01 = 0;
+		double A02 = 0;
+		double A12 = 0;
+		double B0 = 0;
+		double B1 = 0;
+		double B2 = 0;
+		double C = 0;
+
+		void AddPlane(const FVector& Normal, const double Distance, const double Weight)
+		{
+			A00 += Weight * Normal.X * Normal.X;
+			A11 += Weight * Normal.Y * Normal.Y;
+			A22 += Weight * Normal.Z * Normal.Z;
+			A01 += Weight * Normal.X * Normal.Y;
+			A02 += Weight * Normal.X * Normal.Z;
+			A12 += Weight * Normal.Y * Normal.Z;
+			B0 += Weight * Normal.X * Distance;
+			B1 += Weight * Normal.Y * Distance;
+			B2 += Weight * Normal.Z * Distance;
+			C += Weight * Distance * Distance;
+		}
+
+		void Add(const FQuadric& Other)
+		{
+			A00 += Other.A00;
+			A11 += Other.A11;
+			A22 += Other.A22;
+			A01 += Other.A01;
+			A02 += Other.A02;
+			A12 += Other.A12;
+			B0 += Other.B0;
+			B1 += Other.B1;
+			B2 += Other.B2;
+			C += Other.C;
+		}
+
+		double Evaluate(const FVector& Position) const
+		{
+			const double X = Position.X;
+			const double Y = Position.Y;
+			const double Z = Position.Z;
+			const double Error = A00 * X * X + A11 * Y * Y + A22 * Z * Z +
+				2 * (A01 * X * Y + A02 * X * Z + A12 * Y * Z) +
+				2 * (B0 * X + B1 * Y + B2 * Z) + C;
+			return FMath::Abs(Error);
+		}
+	};
+
+	struct FEdgeCollapse
+	{
+		uint32 From;
+		uint32 To;
+		double Cost;
+		// versions of the vertices when the collapse has been evaluated (stale collapses are skipped)
+		uint32 FromVersion;
+		uint32 ToVersion;
+	};
+
+	bool VertexAttributesMatch(const FglTFRuntimePrimitive& Primitive, const uint32 A, const uint32 B)
+	{
+		if (Primitive.Normals.IsValidIndex(A) && Primitive.Normals.IsValidIndex(B) && !Primitive.Normals[A].Equals(Primitive.Normals[B], 1e-3f))
+		{
+			return false;
+		}
+
+		if (Primitive.Tangents.IsValidIndex(A) && Primitive.Tangents.IsValidIndex(B) && !Primitive.Tangents[A].Equals(Primitive.Tangents[B], 1e-3f))
+		{
+			return false;
+		}
+
+		for (const TArray<FVector2D>& UV : Primitive.UVs)
+		{
+			if (UV.IsValidIndex(A) && UV.IsValidIndex(B) && !UV[A].Equals(UV[B], 1e-5f))
+			{
+				return false;
+			}
+		}
+
+		if (Primitive.Colors.IsValidIndex(A) && Primitive.Colors.IsValidIndex(B) && !Primitive.Colors[A].Equals(Primitive.Colors[B], 1e-3f))
+		{
+			return false;
+		}
+
+		for (const TArray<FglTFRuntimeUInt16Vector4>& Joints : Primitive.Joints)
+		{
+			if (Joints.IsValidIndex(A) && Joints.IsValidIndex(B))
+			{
+				if (Joints[A].X != Joints[B].X || Joints[A].Y != Joints[B].Y || Joints[A].Z != Joints[B].Z || Joints[A].W != Joints[B].W)
+				{
+					return false;
+				}
+			}
+		}
+
+		// weights are 16 bit fixed point values (tolerance is ~1e-3)
+		for (const TArray<FglTFRuntimeUInt16Vector4>& Weights : Primitive.Weights)
+		{
+			if (Weights.IsValidIndex(A) && Weights.IsValidIndex(B))
+			{
+				for (int32 Component = 0; Component < 4; Component++)
+				{
+					if (FMath::Abs(static_cast<int32>(Weights[A][Component]) - static_cast<int32>(Weights[B][Component])) > 64)
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		for (const FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			// missing deltas (sparse targets) are zero
+			if (MorphTarget.Positions.Num() > 0 && !MorphTarget.GetPositionDelta(A).Equals(MorphTarget.GetPositionDelta(B), 1e-4f))
+			{
+				return false;
+			}
+
+			if (MorphTarget.Normals.Num() > 0 && !MorphTarget.GetNormalDelta(A).Equals(MorphTarget.GetNormalDelta(B), 1e-3f))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	void GatherVertexStream(TArray<T>& Stream, const TArray<uint32>& NewToOld, const int32 VerticesNum)
+	{
+		if (Stream.Num() == 0)
+		{
+			return;
+		}
+
+		// incomplete streams are discarded (they would be filled with default values in the mesh builders)
+		if (Stream.Num() < VerticesNum)
+		{
+			Stream.Empty();
+			return;
+		}
+
+		TArray<T> NewStream;
+		NewStream.AddUninitialized(NewToOld.Num());
+		for (int32 NewIndex = 0; NewIndex < NewToOld.Num(); NewIndex++)
+		{
+			NewStream[NewIndex] = Stream[NewToOld[NewIndex]];
+		}
+		Stream = MoveTemp(NewStream);
+	}
+
+	void GatherMorphTarget(FglTFRuntimeMorphTarget& MorphTarget, const TArray<uint32>& NewToOld, const int32 VerticesNum)
+	{
+		if (!MorphTarget.IsSparse())
+		{
+			GatherVertexStream(MorphTarget.Positions, NewToOld, VerticesNum);
+			GatherVertexStream(MorphTarget.Normals, NewToOld, VerticesNum);
+			return;
+		}
+
+		// new vertices are visited in order, so the rebuilt sparse indices are still sorted
+		FglTFRuntimeMorphTarget NewMorphTarget;
+		NewMorphTarget.Name = MorphTarget.Name;
+		NewMorphTarget.bSparse = true;
+		for (int32 NewIndex = 0; NewIndex < NewToOld.Num(); NewIndex++)
+		{
+			const int32 DeltaIndex = MorphTarget.FindDeltaIndex(static_cast<int32>(NewToOld[NewIndex]));
+			if (DeltaIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			NewMorphTarget.Indices.Add(NewIndex);
+			if (MorphTarget.Positions.IsValidIndex(DeltaIndex))
+			{
+				NewMorphTarget.Positions.Add(MorphTarget.Positions[DeltaIndex]);
+			}
+			if (MorphTarget.Normals.IsValidIndex(DeltaIndex))
+			{
+				NewMorphTarget.Normals.Add(MorphTarget.Normals[DeltaIndex]);
+			}
+		}
+		MorphTarget = MoveTemp(NewMorphTarget);
+	}
+
+	// rebuild each vertex stream of the primitive (NewToOld maps each new vertex to the original one)
+	void GatherPrimitiveVertices(FglTFRuntimePrimitive& Primitive, const TArray<uint32>& NewToOld)
+	{
+		const int32 VerticesNum = Primitive.Positions.Num();
+
+		GatherVertexStream(Primitive.Positions, NewToOld, VerticesNum);
+		GatherVertexStream(Primitive.Normals, NewToOld, VerticesNum);
+		GatherVertexStream(Primitive.Tangents, NewToOld, VerticesNum);
+		GatherVertexStream(Primitive.Colors, NewToOld, VerticesNum);
+
+		for (TArray<FVector2D>& UV : Primitive.UVs)
+		{
+			GatherVertexStream(UV, NewToOld, VerticesNum);
+		}
+
+		for (TArray<FglTFRuntimeUInt16Vector4>& Joints : Primitive.Joints)
+		{
+			GatherVertexStream(Joints, NewToOld, VerticesNum);
+		}
+
+		for (TArray<FglTFRuntimeUInt16Vector4>& Weights : Primitive.Weights)
+		{
+			GatherVertexStream(Weights, NewToOld, VerticesNum);
+		}
+
+		for (FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			GatherMorphTarget(MorphTarget, NewToOld, VerticesNum);
+		}
+	}
+
+	// remove unreferenced vertices (the order of the vertices follows their first usage in the index buffer)
+	void CompactPrimitiveVertices(FglTFRuntimePrimitive& Primitive, TArray<uint32>* OutNewToOld = nullptr)
+	{
+		TArray<uint32> OldToNew;
+		OldToNew.Init(MAX_uint32, Primitive.Positions.Num());
+
+		TArray<uint32> NewToOld;
+		NewToOld.Reserve(Primitive.Positions.Num());
+
+		for (uint32& Index : Primitive.Indices)
+		{
+			if (OldToNew[Index] == MAX_uint32)
+			{
+				OldToNew[Index] = NewToOld.Add(Index);
+			}
+			Index = OldToNew[Index];
+		}
+
+		GatherPrimitiveVertices(Primitive, NewToOld);
+
+		if (OutNewToOld)
+		{
+			*OutNewToOld = MoveTemp(NewToOld);
+		}
+	}
+
+	// strips and fans are converted to triangle lists while loading
+	bool IsTrianglesPrimitive(const FglTFRuntimePrimitive& Primitive)
+	{
+		return Primitive.Mode >= 4 && Primitive.Mode <= 6;
+	}
+
+	struct FWeldingEpsilons
+	{
+		float Positions;
+		float Normals;
+		float UVs;
+		float Colors;
+	};
+
+	// a non positive epsilon means exact match
+	template<typename T>
+	bool VectorsMatch(const T& A, const T& B, const int32 Components, const float Epsilon)
+	{
+		for (int32 Component = 0; Component < Components; Component++)
+		{
+			if (Epsilon <= 0 ? A[Component] != B[Component] : FMath::Abs(A[Component] - B[Component]) > Epsilon)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// skin data is always compared exactly
+	bool VerticesMatchWithinEpsilons(const FglTFRuntimePrimitive& Primitive, const uint32 A, const uint32 B, const FWeldingEpsilons& Epsilons)
+	{
+		if (!VectorsMatch(Primitive.Positions[A], Primitive.Positions[B], 3, Epsilons.Positions))
+		{
+			return false;
+		}
+
+		if (Primitive.Normals.IsValidIndex(A) && Primitive.Normals.IsValidIndex(B) && !VectorsMatch(Primitive.Normals[A], Primitive.Normals[B], 3, Epsilons.Normals))
+		{
+			return false;
+		}
+
+		if (Primitive.Tangents.IsValidIndex(A) && Primitive.Tangents.IsValidIndex(B) && !VectorsMatch(Primitive.Tangents[A], Primitive.Tangents[B], 4, Epsilons.Normals))
+		{
+			return false;
+		}
+
+		for (const TArray<FVector2D>& UV : Primitive.UVs)
+		{
+			if (UV.IsValidIndex(A) && UV.IsValidIndex(B) && !VectorsMatch(UV[A], UV[B], 2, Epsilons.UVs))
+			{
+				return false;
+			}
+		}
+
+		if (Primitive.Colors.IsValidIndex(A) && Primitive.Colors.IsValidIndex(B) && !VectorsMatch(Primitive.Colors[A], Primitive.Colors[B], 4, Epsilons.Colors))
+		{
+			return false;
+		}
+
+		for (const TArray<FglTFRuntimeUInt16Vector4>& Joints : Primitive.Joints)
+		{
+			if (Joints.IsValidIndex(A) && Joints.IsValidIndex(B) && !VectorsMatch(Joints[A], Joints[B], 4, 0))
+			{
+				return false;
+			}
+		}
+
+		for (const TArray<FglTFRuntimeUInt16Vector4>& Weights : Primitive.Weights)
+		{
+			if (Weights.IsValidIndex(A) && Weights.IsValidIndex(B) && !VectorsMatch(Weights[A], Weights[B], 4, 0))
+			{
+				return false;
+			}
+		}
+
+		for (const FglTFRuntimeMorphTarget& MorphTarget : Primitive.MorphTargets)
+		{
+			if (MorphTarget.Positions.Num() > 0 && !VectorsMatch(MorphTarget.GetPositionDelta(A), MorphTarget.GetPositionDelta(B), 3, Epsilons.Positions))
+			{
+				return false;
+			}
+
+			if (MorphTarget.Normals.Num() > 0 && !VectorsMatch(MorphTarget.GetNormalDelta(A), MorphTarget.GetNormalDelta(B), 3, Epsilons.Normals))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	using FWeldingCell = TTuple<int64, int64, int64>;
+
+	int64 GetWeldingCellComponent(const double Value, const float Epsilon)
+	{
+		if (Epsilon <= 0)
+		{
+			// exact match (adding 0 normalizes negative zero)
+			const double NormalizedValue = Value + 0.0;
+			int64 Bits = 0;
+			FMemory::Memcpy(&Bits, &NormalizedValue, sizeof(double));
+			return Bits;
+		}
+		return static_cast<int64>(FMath::FloorToDouble(Value / Epsilon));
+	}
+
+	constexpr int32 VertexCacheSize = 32;
+
+	// Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" scoring
+	float GetVertexCacheScore(const int32 CachePosition, const int32 LiveTriangles)
+	{
+		if (LiveTriangles <= 0)
+		{
+			return -1.0f;
+		}
+
+		float Score = 0;
+		if (CachePosition >= 0)
+		{
+			// the last triangle vertices get a fixed score to avoid favouring strips
+			if (CachePosition < 3)
+			{
+				Score = 0.75f;
+			}
+			else
+			{
+				Score = FMath::Pow(1.0f - (CachePosition - 3) / static_cast<float>(VertexCacheSize - 3), 1.5f);
+			}
+		}
+
+		// boost vertices with few remaining triangles (avoids leaving isolated triangles behind)
+		Score += 2.0f * FMath::InvSqrt(static_cast<float>(LiveTriangles));
+
+		return Score;
+	}
+
+	void OptimizeVertexCache(TArray<uint32>& Indices, const int32 VerticesNum)
+	{
+		const int32 TrianglesNum = Indices.Num() / 3;
+		if (TrianglesNum < 2)
+		{
+			return;
+		}
+
+		// vertex -> live triangles adjacency (live triangles are always at the beginning of each vertex range)
+		TArray<int32> LiveTriangles;
+		LiveTriangles.AddZeroed(VerticesNum);
+		for (const uint32 Index : Indices)
+		{
+			LiveTriangles[Index]++;
+		}
+
+		TArray<int32> AdjacencyOffsets;
+		AdjacencyOffsets.AddUninitialized(VerticesNum);
+		int32 AdjacencyOffset = 0;
+		for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+		{
+			AdjacencyOffsets[VertexIndex] = AdjacencyOffset;
+			AdjacencyOffset += LiveTriangles[VertexIndex];
+		}
+
+		TArray<int32> AdjacencyTriangles;
+		AdjacencyTriangles.AddUninitialized(Indices.Num());
+		TArray<int32> AdjacencyFill = AdjacencyOffsets;
+		for (int32 Index = 0; Index < Indices.Num(); Index++)
+		{
+			AdjacencyTriangles[AdjacencyFill[Indices[Index]]++] = Index / 3;
+		}
+
+		TArray<int32> CachePositions;
+		CachePositions.Init(INDEX_NONE, VerticesNum);
+
+		TArray<float> VertexScores;
+		VertexScores.AddUninitialized(VerticesNum);
+		for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+		{
+			VertexScores[VertexIndex] = GetVertexCacheScore(INDEX_NONE, LiveTriangles[VertexIndex]);
+		}
+
+		TArray<float> TriangleScores;
+		TriangleScores.AddUninitialized(TrianglesNum);
+		for (int32 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex++)
+		{
+			TriangleScores[TriangleIndex] = VertexScores[Indices[TriangleIndex * 3]] + VertexScores[Indices[TriangleIndex * 3 + 1]] + VertexScores[Indices[TriangleIndex * 3 + 2]];
+		}
+
+		TArray<bool> EmittedTriangles;
+		EmittedTriangles.Init(false, TrianglesNum);
+
+		TArray<uint32> OptimizedIndices;
+		OptimizedIndices.Reserve(Indices.Num());
+
+		uint32 Cache[VertexCacheSize + 3];
+		int32 CacheNum = 0;
+		uint32 NewCache[VertexCacheSize + 3];
+
+		int32 BestTriangle = 0;
+		int32 InputCursor = 1;
+
+		while (BestTriangle != INDEX_NONE)
+		{
+			const uint32 A = Indices[BestTriangle * 3];
+			const uint32 B = Indices[BestTriangle * 3 + 1];
+			const uint32 C = Indices[BestTriangle * 3 + 2];
+
+			OptimizedIndices.Add(A);
+			OptimizedIndices.Add(B);
+			OptimizedIndices.Add(C);
+			EmittedTriangles[BestTriangle] = true;
+
+			for (const uint32 VertexIndex : { A, B, C })
+			{
+				int32* VertexTriangles = &AdjacencyTriangles[AdjacencyOffsets[VertexIndex]];
+				for (int32 LiveIndex = 0; LiveIndex < LiveTriangles[VertexIndex]; LiveIndex++)
+				{
+					if (VertexTriangles[LiveIndex] == BestTriangle)
+					{
+						VertexTriangles[LiveIndex] = VertexTriangles[LiveTriangles[VertexIndex] - 1];
+						LiveTriangles[VertexIndex]--;
+						break;
+					}
+				}
+			}
+
+			int32 NewCacheNum = 0;
+			NewCache[NewCacheNum++] = A;
+			NewCache[NewCacheNum++] = B;
+			NewCache[NewCacheNum++] = C;
+			for (int32 CacheIndex = 0; CacheIndex < CacheNum; CacheIndex++)
+			{
+				const uint32 VertexIndex = Cache[CacheIndex];
+				if (VertexIndex != A && VertexIndex != B && VertexIndex != C)
+				{
+					NewCache[NewCacheNum++] = VertexIndex;
+				}
+			}
+
+			// update scores of the cached (and just evicted) vertices and their triangles
+			for (int32 CacheIndex = 0; CacheIndex < NewCacheNum; CacheIndex++)
+			{
+				const uint32 VertexIndex = NewCache[CacheIndex];
+				CachePositions[VertexIndex] = CacheIndex < VertexCacheSize ? CacheIndex : INDEX_NONE;
+
+				const float NewScore = GetVertexCacheScore(CachePositions[VertexIndex], LiveTriangles[VertexIndex]);
+				const float DeltaScore = NewScore - VertexScores[VertexIndex];
+				VertexScores[VertexIndex] = NewScore;
+
+				const int32* VertexTriangles = &AdjacencyTriangles[AdjacencyOffsets[VertexIndex]];
+				for (int32 LiveIndex = 0; LiveIndex < LiveTriangles[VertexIndex]; LiveIndex++)
+				{
+					TriangleScores[VertexTriangles[LiveIndex]] += DeltaScore;
+				}
+			}
+
+			CacheNum = FMath::Min(NewCacheNum, VertexCacheSize);
+			FMemory::Memcpy(Cache, NewCache, CacheNum * sizeof(uint32));
+
+			// the next triangle is the best one using the cached vertices
+			BestTriangle = INDEX_NONE;
+			float BestScore = -1;
+			for (int32 CacheIndex = 0; CacheIndex < CacheNum; CacheIndex++)
+			{
+				const uint32 VertexIndex = Cache[CacheIndex];
+				const int32* VertexTriangles = &AdjacencyTriangles[AdjacencyOffsets[VertexIndex]];
+				for (int32 LiveIndex = 0; LiveIndex < LiveTriangles[VertexIndex]; LiveIndex++)
+				{
+					const int32 TriangleIndex = VertexTriangles[LiveIndex];
+					if (TriangleScores[TriangleIndex] > BestScore)
+					{
+						BestScore = TriangleScores[TriangleIndex];
+						BestTriangle = TriangleIndex;
+					}
+				}
+			}
+
+			// dead end, restart from the input order
+			if (BestTriangle == INDEX_NONE)
+			{
+				while (InputCursor < TrianglesNum && EmittedTriangles[InputCursor])
+				{
+					InputCursor++;
+				}
+
+				if (InputCursor < TrianglesNum)
+				{
+					BestTriangle = InputCursor;
+				}
+			}
+		}
+
+		Indices = MoveTemp(OptimizedIndices);
+	}
+
+	// Sander et al. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (hard boundaries only, so vertex cache efficiency is preserved)
+	void OptimizeOverdraw(TArray<uint32>& Indices, const TArray<FVector>& Positions)
+	{
+		constexpr uint32 OverdrawCacheSize = 16;
+
+		const int32 TrianglesNum = Indices.Num() / 3;
+		if (TrianglesNum < 2)
+		{
+			return;
+		}
+
+		// a new cluster starts whenever a triangle misses the cache for all of its vertices
+		TArray<int32> Clusters;
+		Clusters.Add(0);
+
+		TArray<uint32> CacheTimestamps;
+		CacheTimestamps.AddZeroed(Positions.Num());
+		uint32 Timestamp = OverdrawCacheSize + 1;
+
+		for (int32 TriangleIndex = 0; TriangleIndex < TrianglesNum; TriangleIndex++)
+		{
+			int32 CacheMisses = 0;
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 VertexIndex = Indices[TriangleIndex * 3 + Corner];
+				if (Timestamp - CacheTimestamps[VertexIndex] > OverdrawCacheSize)
+				{
+					CacheTimestamps[VertexIndex] = Timestamp++;
+					CacheMisses++;
+				}
+			}
+
+			if (TriangleIndex > 0 && CacheMisses == 3)
+			{
+				Clusters.Add(TriangleIndex);
+			}
+		}
+
+		if (Clusters.Num() < 2)
+		{
+			return;
+		}
+
+		FVector MeshCentroid = FVector::ZeroVector;
+		double MeshArea = 0;
+
+		TArray<FVector> ClustersCentroids;
+		ClustersCentroids.AddZeroed(Clusters.Num());
+		TArray<FVector> ClustersNormals;
+		ClustersNormals.AddZeroed(Clusters.Num());
+
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+		{
+			const int32 ClusterEnd = ClusterIndex + 1 < Clusters.Num() ? Clusters[ClusterIndex + 1] : TrianglesNum;
+			double ClusterArea = 0;
+			for (int32 TriangleIndex = Clusters[ClusterIndex]; TriangleIndex < ClusterEnd; TriangleIndex++)
+			{
+				const FVector& P0 = Positions[Indices[TriangleIndex * 3]];
+				const FVector& P1 = Positions[Indices[TriangleIndex * 3 + 1]];
+				const FVector& P2 = Positions[Indices[TriangleIndex * 3 + 2]];
+
+				const FVector Cross = FVector::CrossProduct(P1 - P0, P2 - P0);
+				const double Area = Cross.Size();
+				const FVector Centroid = (P0 + P1 + P2) / 3;
+
+				ClustersCentroids[ClusterIndex] += Centroid * Area;
+				ClustersNormals[ClusterIndex] += Cross;
+				ClusterArea += Area;
+			}
+
+			MeshCentroid += ClustersCentroids[ClusterIndex];
+			MeshArea += ClusterArea;
+
+			if (ClusterArea > 0)
+			{
+				ClustersCentroids[ClusterIndex] /= ClusterArea;
+			}
+			ClustersNormals[ClusterIndex].Normalize();
+		}
+
+		if (MeshArea > 0)
+		{
+			MeshCentroid /= MeshArea;
+		}
+
+		// clusters facing outside are drawn first (they are more likely to occlude the others)
+		TArray<int32> SortedClusters;
+		TArray<double> SortKeys;
+		SortedClusters.AddUninitialized(Clusters.Num());
+		SortKeys.AddUninitialized(Clusters.Num());
+		for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ClusterIndex++)
+		{
+			SortedClusters[ClusterIndex] = ClusterIndex;
+			SortKeys[ClusterIndex] = FVector::DotProduct(ClustersCentroids[ClusterIndex] - MeshCentroid, ClustersNormals[ClusterIndex]);
+		}
+
+		SortedClusters.StableSort([&SortKeys](const int32 A, const int32 B) { return SortKeys[A] > SortKeys[B]; });
+
+		TArray<uint32> SortedIndices;
+		SortedIndices.Reserve(Indices.Num());
+		for (const int32 ClusterIndex : SortedClusters)
+		{
+			const int32 ClusterEnd = ClusterIndex + 1 < Clusters.Num() ? Clusters[ClusterIndex + 1] : TrianglesNum;
+			SortedIndices.Append(&Indices[Clusters[ClusterIndex] * 3], (ClusterEnd - Clusters[ClusterIndex]) * 3);
+		}
+
+		Indices = MoveTemp(SortedIndices);
+	}
+}
+
+bool FglTFRuntimeParser::SimplifyPrimitive(const FglTFRuntimePrimitive& Primitive, const float TrianglesRatio, FglTFRuntimePrimitive& SimplifiedPrimitive)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_SimplifyPrimitive, FColor::Magenta);
+
+	const int32 VerticesNum = Primitive.Positions.Num();
+	const int32 SourceTrianglesNum = Primitive.Indices.Num() / 3;
+
+	if (!glTFRuntime::IsTrianglesPrimitive(Primitive) || VerticesNum < 3 || SourceTrianglesNum < 2 || Primitive.Indices.Num() % 3 != 0)
+	{
+		return false;
+	}
+
+	// OverrideBoneMap is keyed by index offsets, we cannot preserve it while removing triangles
+	if (Primitive.OverrideBoneMap.Num() > 1 || (Primitive.OverrideBoneMap.Num() == 1 && !Primitive.OverrideBoneMap.Contains(0)))
+	{
+		return false;
+	}
+
+	for (const uint32 Index : Primitive.Indices)
+	{
+		if (Index >= static_cast<uint32>(VerticesNum))
+		{
+			return false;
+		}
+	}
+
+	const int32 TargetTrianglesNum = FMath::Max(1, FMath::FloorToInt(SourceTrianglesNum * FMath::Clamp(TrianglesRatio, 0.0f, 1.0f)));
+	if (TargetTrianglesNum >= SourceTrianglesNum)
+	{
+		return false;
+	}
+
+	// vertices with the same position and attributes are merged (exploded meshes), vertices with the same position
+	// but different attributes (UV seams, hard edges...) are locked.
+	TArray<uint32> WedgeRemap;
+	WedgeRemap.AddUninitialized(VerticesNum);
+	TArray<uint32> NextWedge;
+	NextWedge.Init(MAX_uint32, VerticesNum);
+	TArray<uint32> PositionHeads;
+	PositionHeads.AddUninitialized(VerticesNum);
+
+	TMap<FVector, uint32> PositionsMap;
+	PositionsMap.Reserve(VerticesNum);
+	for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+	{
+		const uint32* PositionHead = PositionsMap.Find(Primitive.Positions[VertexIndex]);
+		if (!PositionHead)
+		{
+			PositionsMap.Add(Primitive.Positions[VertexIndex], VertexIndex);
+			PositionHeads[VertexIndex] = VertexIndex;
+			WedgeRemap[VertexIndex] = VertexIndex;
+			continue;
+		}
+
+		PositionHeads[VertexIndex] = *PositionHead;
+		WedgeRemap[VertexIndex] = MAX_uint32;
+		uint32 Wedge = *PositionHead;
+		while (Wedge != MAX_uint32)
+		{
+			if (glTFRuntime::VertexAttributesMatch(Primitive, Wedge, VertexIndex))
+			{
+				WedgeRemap[VertexIndex] = Wedge;
+				break;
+			}
+			Wedge = NextWedge[Wedge];
+		}
+
+		if (WedgeRemap[VertexIndex] == MAX_uint32)
+		{
+			WedgeRemap[VertexIndex] = VertexIndex;
+			NextWedge[VertexIndex] = NextWedge[*PositionHead];
+			NextWedge[*PositionHead] = VertexIndex;
+		}
+	}
+
+	TArray<uint32> Triangles;
+	Triangles.AddUninitialized(Primitive.Indices.Num());
+	for (int32 Index = 0; Index < Primitive.Indices.Num(); Index++)
+	{
+		Triangles[Index] = WedgeRemap[Primitive.Indices[Index]];
+	}
+
+	TArray<bool> LockedVertices;
+	LockedVertices.Init(false, VerticesNum);
+
+	for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+	{
+		if (WedgeRemap[VertexIndex] == VertexIndex && NextWedge[PositionHeads[VertexIndex]] != MAX_uint32)
+		{
+			LockedVertices[VertexIndex] = true;
+		}
+	}
+
+	// borders and non-manifold edges are locked too
+	TMap<uint64, int32> EdgesCounter;
+	EdgesCounter.Reserve(Triangles.Num());
+	for (int32 Index = 0; Index < Triangles.Num(); Index += 3)
+	{
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const uint32 A = Triangles[Index + Corner];
+			const uint32 B = Triangles[Index + (Corner + 1) % 3];
+			const uint64 EdgeKey = (static_cast<uint64>(FMath::Min(A, B)) << 32) | FMath::Max(A, B);
+			EdgesCounter.FindOrAdd(EdgeKey)++;
+		}
+	}
+
+	for (const TPair<uint64, int32>& Pair : EdgesCounter)
+	{
+		if (Pair.Value != 2)
+		{
+			LockedVertices[static_cast<uint32>(Pair.Key >> 32)] = true;
+			LockedVertices[static_cast<uint32>(Pair.Key & 0xFFFFFFFF)] = true;
+		}
+	}
+
+	TArray<glTFRuntime::FQuadric> Quadrics;
+	Quadrics.AddDefaulted(VerticesNum);
+	for (int32 Index = 0; Index < Triangles.Num(); Index += 3)
+	{
+		const FVector& P0 = Primitive.Positions[Triangles[Index]];
+		const FVector& P1 = Primitive.Positions[Triangles[Index + 1]];
+		const FVector& P2 = Primitive.Positions[Triangles[Index + 2]];
+
+		const FVector Cross = FVector::CrossProduct(P1 - P0, P2 - P0);
+		const double DoubleArea = Cross.Size();
+		if (DoubleArea <= 0)
+		{
+			continue;
+		}
+
+		const FVector Normal = Cross / DoubleArea;
+		const double Distance = -FVector::DotProduct(Normal, P0);
+
+		glTFRuntime::FQuadric Quadric;
+		Quadric.AddPlane(Normal, Distance, DoubleArea * 0.5);
+		Quadrics[Triangles[Index]].Add(Quadric);
+		Quadrics[Triangles[Index + 1]].Add(Quadric);
+		Quadrics[Triangles[Index + 2]].Add(Quadric);
+	}
+
+	const bool bCheckNormals = Primitive.Normals.Num() >= VerticesNum;
+	// do not collapse vertices whose normals diverge more than 60 degrees
+	constexpr float NormalsThreshold = 0.5f;
+	// reject collapses rotating adjacent triangles too much (or flipping them)
+	constexpr float FlipThreshold = 0.2f;
+
+	// vertex -> triangles adjacency (the triangles of a collapsed vertex are moved to the surviving one)
+	TArray<TArray<int32>> VertexTriangles;
+	VertexTriangles.AddDefaulted(VerticesNum);
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		VertexTriangles[Triangles[Index]].Add(Index / 3);
+	}
+
+	TArray<bool> DeadTriangles;
+	DeadTriangles.Init(false, Triangles.Num() / 3);
+	TArray<bool> CollapsedVertices;
+	CollapsedVertices.Init(false, VerticesNum);
+	// bumped whenever the quadric of a vertex changes
+	TArray<uint32> VertexVersions;
+	VertexVersions.Init(0, VerticesNum);
+
+	auto GetCollapseCost = [&](const uint32 From, const uint32 To) -> double
+		{
+			if (LockedVertices[From])
+			{
+				return -1;
+			}
+
+			if (bCheckNormals && FVector::DotProduct(Primitive.Normals[From], Primitive.Normals[To]) < NormalsThreshold)
+			{
+				return -1;
+			}
+
+			return Quadrics[From].Evaluate(Primitive.Positions[To]) + Quadrics[To].Evaluate(Primitive.Positions[To]);
+		};
+
+	auto CollapsePredicate = [](const glTFRuntime::FEdgeCollapse& A, const glTFRuntime::FEdgeCollapse& B) { return A.Cost < B.Cost; };
+
+	// min heap of the collapses, entries are never updated in place but invalidated by the vertices versions
+	TArray<glTFRuntime::FEdgeCollapse> Collapses;
+	auto PushCollapse = [&](const uint32 A, const uint32 B)
+		{
+			const double CostAB = GetCollapseCost(A, B);
+			const double CostBA = GetCollapseCost(B, A);
+			if (CostAB < 0 && CostBA < 0)
+			{
+				return;
+			}
+
+			glTFRuntime::FEdgeCollapse Collapse;
+			if (CostBA < 0 || (CostAB >= 0 && CostAB <= CostBA))
+			{
+				Collapse.From = A;
+				Collapse.To = B;
+				Collapse.Cost = CostAB;
+			}
+			else
+			{
+				Collapse.From = B;
+				Collapse.To = A;
+				Collapse.Cost = CostBA;
+			}
+			Collapse.FromVersion = VertexVersions[Collapse.From];
+			Collapse.ToVersion = VertexVersions[Collapse.To];
+			Collapses.HeapPush(Collapse, CollapsePredicate);
+		};
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index += 3)
+	{
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			const uint32 A = Triangles[Index + Corner];
+			const uint32 B = Triangles[Index + (Corner + 1) % 3];
+			// each manifold edge is shared by two triangles, consider it only once
+			if (A < B)
+			{
+				PushCollapse(A, B);
+			}
+		}
+	}
+
+	int32 TrianglesNum = Triangles.Num() / 3;
+	TArray<uint32> Neighbors;
+
+	while (TrianglesNum > TargetTrianglesNum && Collapses.Num() > 0)
+	{
+		glTFRuntime::FEdgeCollapse Collapse;
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+		Collapses.HeapPop(Collapse, CollapsePredicate, EAllowShrinking::No);
+#else
+		Collapses.HeapPop(Collapse, CollapsePredicate, false);
+#endif
+
+		if (CollapsedVertices[Collapse.From] || CollapsedVertices[Collapse.To] ||
+			VertexVersions[Collapse.From] != Collapse.FromVersion || VertexVersions[Collapse.To] != Collapse.ToVersion)
+		{
+			continue;
+		}
+
+		const FVector& ToPosition = Primitive.Positions[Collapse.To];
+
+		bool bValid = true;
+		int32 CollapsedTriangles = 0;
+		for (const int32 TriangleIndex : VertexTriangles[Collapse.From])
+		{
+			if (DeadTriangles[TriangleIndex])
+			{
+				continue;
+			}
+
+			const int32 TriangleBase = TriangleIndex * 3;
+			const uint32 V0 = Triangles[TriangleBase];
+			const uint32 V1 = Triangles[TriangleBase + 1];
+			const uint32 V2 = Triangles[TriangleBase + 2];
+
+			if (V0 == Collapse.To || V1 == Collapse.To || V2 == Collapse.To)
+			{
+				CollapsedTriangles++;
+				continue;
+			}
+
+			const FVector& P0 = Primitive.Positions[V0];
+			const FVector& P1 = Primitive.Positions[V1];
+			const FVector& P2 = Primitive.Positions[V2];
+
+			const FVector OldNormal = FVector::CrossProduct(P1 - P0, P2 - P0).GetSafeNormal();
+			const FVector NewNormal = FVector::CrossProduct(
+				(V1 == Collapse.From ? ToPosition : P1) - (V0 == Collapse.From ? ToPosition : P0),
+				(V2 == Collapse.From ? ToPosition : P2) - (V0 == Collapse.From ? ToPosition : P0)).GetSafeNormal();
+
+			if (FVector::DotProduct(OldNormal, NewNormal) < FlipThreshold)
+			{
+				bValid = false;
+				break;
+			}
+		}
+
+		// the edge could have been removed by a previous collapse
+		if (!bValid || CollapsedTriangles == 0)
+		{
+			continue;
+		}
+
+		for (const int32 TriangleIndex : VertexTriangles[Collapse.From])
+		{
+			if (DeadTriangles[TriangleIndex])
+			{
+				continue;
+			}
+
+			const int32 TriangleBase = TriangleIndex * 3;
+			bool bDegenerate = false;
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				if (Triangles[TriangleBase + Corner] == Collapse.To)
+				{
+					bDegenerate = true;
+				}
+			}
+
+			if (bDegenerate)
+			{
+				DeadTriangles[TriangleIndex] = true;
+				TrianglesNum--;
+				continue;
+			}
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				if (Triangles[TriangleBase + Corner] == Collapse.From)
+				{
+					Triangles[TriangleBase + Corner] = Collapse.To;
+				}
+			}
+			VertexTriangles[Collapse.To].Add(TriangleIndex);
+		}
+
+		CollapsedVertices[Collapse.From] = true;
+		VertexTriangles[Collapse.From].Empty();
+		Quadrics[Collapse.To].Add(Quadrics[Collapse.From]);
+		VertexVersions[Collapse.To]++;
+
+		VertexTriangles[Collapse.To].RemoveAll([&DeadTriangles](const int32 TriangleIndex) { return DeadTriangles[TriangleIndex]; });
+
+		// only the edges around the surviving vertex changed their cost
+		Neighbors.Reset();
+		for (const int32 TriangleIndex : VertexTriangles[Collapse.To])
+		{
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				const uint32 VertexIndex = Triangles[TriangleIndex * 3 + Corner];
+				if (VertexIndex != Collapse.To)
+				{
+					Neighbors.AddUnique(VertexIndex);
+				}
+			}
+		}
+
+		for (const uint32 Neighbor : Neighbors)
+		{
+			PushCollapse(FMath::Min(Collapse.To, Neighbor), FMath::Max(Collapse.To, Neighbor));
+		}
+	}
+
+	// remove the collapsed triangles
+	int32 WriteIndex = 0;
+	for (int32 Index = 0; Index < Triangles.Num(); Index += 3)
+	{
+		if (DeadTriangles[Index / 3])
+		{
+			continue;
+		}
+		Triangles[WriteIndex++] = Triangles[Index];
+		Triangles[WriteIndex++] = Triangles[Index + 1];
+		Triangles[WriteIndex++] = Triangles[Index + 2];
+	}
+	Triangles.SetNum(WriteIndex);
+
+	if (Triangles.Num() == 0 || Triangles.Num() >= Primitive.Indices.Num())
+	{
+		return false;
+	}
+
+	SimplifiedPrimitive = Primitive;
+	SimplifiedPrimitive.Indices = MoveTemp(Triangles);
+	glTFRuntime::CompactPrimitiveVertices(SimplifiedPrimitive);
+	// the additional buffer view describes the original topology
+	SimplifiedPrimitive.AdditionalBufferView = INDEX_NONE;
+	SimplifiedPrimitive.bHasIndices = SimplifiedPrimitive.Positions.Num() < SimplifiedPrimitive.Indices.Num();
+
+	return true;
+}
+
+void FglTFRuntimeParser::WeldPrimitiveVertices(FglTFRuntimePrimitive& Primitive, const float PositionsEpsilon, const float NormalsEpsilon, const float UVsEpsilon, const float ColorsEpsilon)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_WeldPrimitiveVertices, FColor::Magenta);
+
+	const int32 VerticesNum = Primitive.Positions.Num();
+
+	if (VerticesNum < 2)
+	{
+		return;
+	}
+
+	for (const uint32 Index : Primitive.Indices)
+	{
+		if (Index >= static_cast<uint32>(VerticesNum))
+		{
+			return;
+		}
+	}
+
+	const glTFRuntime::FWeldingEpsilons Epsilons = { PositionsEpsilon, NormalsEpsilon, UVsEpsilon, ColorsEpsilon };
+
+	// the grid cells are as big as the positions epsilon, so two positions within epsilon
+	// are always in the same or in adjacent cells (exact matching only checks the same cell)
+	TArray<glTFRuntime::FWeldingCell> Cells;
+	Cells.AddUninitialized(VerticesNum);
+	ParallelFor(VerticesNum, [&](const int32 VertexIndex)
+		{
+			const FVector& Position = Primitive.Positions[VertexIndex];
+			Cells[VertexIndex] = glTFRuntime::FWeldingCell(
+				glTFRuntime::GetWeldingCellComponent(Position.X, PositionsEpsilon),
+				glTFRuntime::GetWeldingCellComponent(Position.Y, PositionsEpsilon),
+				glTFRuntime::GetWeldingCellComponent(Position.Z, PositionsEpsilon));
+		});
+
+	const int32 NeighboursRange = PositionsEpsilon > 0 ? 1 : 0;
+
+	// vertices are visited in ascending order (the first one within tolerance is the representative),
+	// this is sequential as neighbour cells cross any partitioning of the grid
+	TMap<glTFRuntime::FWeldingCell, TArray<uint32>> Representatives;
+	Representatives.Reserve(VerticesNum);
+
+	TArray<uint32> WeldRemap;
+	WeldRemap.AddUninitialized(VerticesNum);
+
+	for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+	{
+		WeldRemap[VertexIndex] = VertexIndex;
+		bool bWelded = false;
+
+		const glTFRuntime::FWeldingCell& Cell = Cells[VertexIndex];
+		for (int64 X = -NeighboursRange; X <= NeighboursRange && !bWelded; X++)
+		{
+			for (int64 Y = -NeighboursRange; Y <= NeighboursRange && !bWelded; Y++)
+			{
+				for (int64 Z = -NeighboursRange; Z <= NeighboursRange && !bWelded; Z++)
+				{
+					const TArray<uint32>* CellRepresentatives = Representatives.Find(glTFRuntime::FWeldingCell(Cell.Get<0>() + X, Cell.Get<1>() + Y, Cell.Get<2>() + Z));
+					if (!CellRepresentatives)
+					{
+						continue;
+					}
+
+					for (const uint32 Candidate : *CellRepresentatives)
+					{
+						if (glTFRuntime::VerticesMatchWithinEpsilons(Primitive, Candidate, VertexIndex, Epsilons))
+						{
+							WeldRemap[VertexIndex] = Candidate;
+							bWelded = true;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		if (!bWelded)
+		{
+			Representatives.FindOrAdd(Cell).Add(VertexIndex);
+		}
+	}
+
+	TArray<uint32> OldToNew;
+	OldToNew.AddUninitialized(VerticesNum);
+	TArray<uint32> NewToOld;
+	NewToOld.Reserve(VerticesNum);
+	for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+	{
+		if (WeldRemap[VertexIndex] == static_cast<uint32>(VertexIndex))
+		{
+			OldToNew[VertexIndex] = NewToOld.Add(VertexIndex);
+		}
+		else
+		{
+			OldToNew[VertexIndex] = OldToNew[WeldRemap[VertexIndex]];
+		}
+	}
+
+	if (NewToOld.Num() == VerticesNum)
+	{
+		return;
+	}
+
+	ParallelFor(Primitive.Indices.Num(), [&](const int32 Index)
+		{
+			Primitive.Indices[Index] = OldToNew[Primitive.Indices[Index]];
+		});
+
+	glTFRuntime::GatherPrimitiveVertices(Primitive, NewToOld);
+	RemapAdditionalBufferView(Primitive, VerticesNum, NewToOld);
+
+	// welded primitives can now use the index buffer
+	if (Primitive.Positions.Num() < Primitive.Indices.Num())
+	{
+		Primitive.bHasIndices = true;
+	}
+}
+
+void FglTFRuntimeParser::OptimizePrimitive(FglTFRuntimePrimitive& Primitive)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_OptimizePrimitive, FColor::Magenta);
+
+	const int32 VerticesNum = Primitive.Positions.Num();
+
+	if (!glTFRuntime::IsTrianglesPrimitive(Primitive) || VerticesNum < 3 || Primitive.Indices.Num() < 6 || Primitive.Indices.Num() % 3 != 0)
+	{
+		return;
+	}
+
+	// OverrideBoneMap is keyed by index offsets, we cannot preserve it while moving triangles
+	if (Primitive.OverrideBoneMap.Num() > 1 || (Primitive.OverrideBoneMap.Num() == 1 && !Primitive.OverrideBoneMap.Contains(0)))
+	{
+		return;
+	}
+
+	for (const uint32 Index : Primitive.Indices)
+	{
+		if (Index >= static_cast<uint32>(VerticesNum))
+		{
+			return;
+		}
+	}
+
+	glTFRuntime::OptimizeVertexCache(Primitive.Indices, VerticesNum);
+	glTFRuntime::OptimizeOverdraw(Primitive.Indices, Primitive.Positions);
+	// vertices are now sorted by first usage
+	TArray<uint32> NewToOld;
+	glTFRuntime::CompactPrimitiveVertices(Primitive, &NewToOld);
+	RemapAdditionalBufferView(Primitive, VerticesNum, NewToOld);
+}
+
+void FglTFRuntimeParser::RemapAdditionalBufferView(FglTFRuntimePrimitive& Primitive, const int32 VerticesNum, const TArray<uint32>& NewToOld)
+{
+	if (Primitive.AdditionalBufferView <= INDEX_NONE || VerticesNum <= 0)
+	{
+		return;
+	}
+
+	TArray<TPair<FString, FglTFRuntimeBlob>> Blobs;
+	{
+		FReadScopeLock Lock(AdditionalBufferViewsLock);
+		const TMap<FString, TSharedPtr<FglTFRuntimeBlob>>* AdditionalBufferViews = AdditionalBufferViewsCache.Find(Primitive.AdditionalBufferView);
+		if (!AdditionalBufferViews)
+		{
+			return;
+		}
+
+		for (const TPair<FString, TSharedPtr<FglTFRuntimeBlob>>& Pair : *AdditionalBufferViews)
+		{
+			if (Pair.Value)
+			{
+				Blobs.Add(TPair<FString, FglTFRuntimeBlob>(Pair.Key, *Pair.Value));
+			}
+		}
+	}
+
+	int64 NewAdditionalBufferView = INDEX_NONE;
+	{
+		FWriteScopeLock Lock(AdditionalBufferViewsLock);
+		NewAdditionalBufferView = ++LastGeneratedAdditionalBufferView;
+	}
+
+	// the original buffer view is left untouched (it could be decoded again by other loaders),
+	// the processed primitive gets a new one with the per-vertex streams in the new order.
+	// Primitive.Indices is authoritative for the topology, so the indices stream is not carried over.
+	for (const TPair<FString, FglTFRuntimeBlob>& Pair : Blobs)
+	{
+		const FglTFRuntimeBlob& Blob = Pair.Value;
+		if (Pair.Key == TEXT("indices") || Blob.Num <= 0 || !Blob.Data || Blob.Num % VerticesNum != 0)
+		{
+			continue;
+		}
+
+		const int64 VertexSize = Blob.Num / VerticesNum;
+
+		TArray64<uint8> NewData;
+		NewData.AddUninitialized(NewToOld.Num() * VertexSize);
+		for (int32 NewIndex = 0; NewIndex < NewToOld.Num(); NewIndex++)
+		{
+			FMemory::Memcpy(NewData.GetData() + NewIndex * VertexSize, Blob.Data + NewToOld[NewIndex] * VertexSize, VertexSize);
+		}
+
+		AddAdditionalBufferViewData(NewAdditionalBufferView, Pair.Key, MoveTemp(NewData));
+	}
+
+	Primitive.AdditionalBufferView = NewAdditionalBufferView;
+}
+
+bool FglTFRuntimeParser::GenerateStaticMeshAutoLODs(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_GenerateStaticMeshAutoLODs, FColor::Magenta);
+
+	const FglTFRuntimeStaticMeshConfig& StaticMeshConfig = StaticMeshContext->StaticMeshConfig;
+
+	// author-provided LODs have the precedence
+	if (StaticMeshConfig.AutoLODsNum <= 0 || StaticMeshContext->LODs.Num() != 1)
+	{
+		return false;
+	}
+
+	// LODs[0] could point to a ContextLOD, so do not access it after calling AddContextLOD()
+	const FglTFRuntimeMeshLOD* SourceLOD = StaticMeshContext->LODs[0];
+	const int32 PrimitivesNum = SourceLOD->Primitives.Num();
+
+	int64 SourceTrianglesNum = 0;
+	for (const FglTFRuntimePrimitive& Primitive : SourceLOD->Primitives)
+	{
+		SourceTrianglesNum += Primitive.Indices.Num() / 3;
+	}
+
+	if (SourceTrianglesNum <= 0)
+	{
+		return false;
+	}
+
+	const int32 LODsNum = StaticMeshConfig.AutoLODsNum;
+	const float ReductionFactor = FMath::Clamp(StaticMeshConfig.AutoLODsReductionFactor, 0.01f, 0.99f);
+
+	TArray<FglTFRuntimeMeshLOD> GeneratedLODs;
+	GeneratedLODs.AddDefaulted(LODsNum);
+	for (FglTFRuntimeMeshLOD& GeneratedLOD : GeneratedLODs)
+	{
+		GeneratedLOD.Primitives.AddDefaulted(PrimitivesNum);
+		GeneratedLOD.AdditionalTransforms = SourceLOD->AdditionalTransforms;
+		GeneratedLOD.Skeleton = SourceLOD->Skeleton;
+		GeneratedLOD.bHasNormals = SourceLOD->bHasNormals;
+		GeneratedLOD.bHasTangents = SourceLOD->bHasTangents;
+		GeneratedLOD.bHasUV = SourceLOD->bHasUV;
+		GeneratedLOD.bHasVertexColors = SourceLOD->bHasVertexColors;
+	}
+
+	// each LOD is generated from LOD0 (instead of the previous LOD) for better quality and parallelism
+	ParallelFor(LODsNum * PrimitivesNum, [&](const int32 JobIndex)
+		{
+			const int32 LODIndex = JobIndex / PrimitivesNum;
+			const int32 PrimitiveIndex = JobIndex % PrimitivesNum;
+			const float TrianglesRatio = FMath::Pow(ReductionFactor, LODIndex + 1);
+
+			FglTFRuntimePrimitive& GeneratedPrimitive = GeneratedLODs[LODIndex].Primitives[PrimitiveIndex];
+			if (!SimplifyPrimitive(SourceLOD->Primitives[PrimitiveIndex], TrianglesRatio, GeneratedPrimitive))
+			{
+				GeneratedPrimitive = SourceLOD->Primitives[PrimitiveIndex];
+			}
+			else if (StaticMeshConfig.MaterialsConfig.bOptimizePrimitives)
+			{
+				OptimizePrimitive(GeneratedPrimitive);
+			}
+		});
+
+	int64 PreviousTrianglesNum = SourceTrianglesNum;
+	for (FglTFRuntimeMeshLOD& GeneratedLOD : GeneratedLODs)
+	{
+		int64 TrianglesNum = 0;
+		for (const FglTFRuntimePrimitive& Primitive : GeneratedLOD.Primitives)
+		{
+			TrianglesNum += Primitive.Indices.Num() / 3;
+		}
+
+		// stop the chain as soon as the simplifier is not able to reduce the mesh anymore
+		if (TrianglesNum >= PreviousTrianglesNum * 0.95)
+		{
+			break;
+		}
+
+		StaticMeshContext->AddContextLOD() = MoveTemp(GeneratedLOD);
+
+		// screen size follows the square root of the triangles ratio (triangles density is proportional to screen area)
+		const float ScreenSize = FMath::Sqrt(static_cast<float>(TrianglesNum) / SourceTrianglesNum) / StaticMeshConfig.LODScreenSizeMultiplier;
+		StaticMeshContext->LODScreenSize.Add(StaticMeshContext->LODs.Num() - 1, ScreenSize);
+
+		PreviousTrianglesNum = TrianglesNum;
+	}
+
+	return StaticMeshContext->LODs.Num() > 1;
+}
@@ -0,0 +1,93 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+
+void FglTFRuntimeParser::BuildSceneGraph()
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_BuildSceneGraph, FColor::Magenta);
+
+	const int32 NodesNum = AllNodesCache.Num();
+
+	SceneGraphParents.SetNumUninitialized(NodesNum);
+	SceneGraphDepths.SetNumUninitialized(NodesNum);
+	SceneGraphTopRoots.SetNumUninitialized(NodesNum);
+	SceneGraphTourBegin.SetNumUninitialized(NodesNum);
+	SceneGraphTourEnd.SetNumUninitialized(NodesNum);
+	SceneGraphLocalTransforms.SetNumUninitialized(NodesNum);
+	SceneGraphWorldTransforms.SetNumUninitialized(NodesNum);
+
+	for (int32 NodeIndex = 0; NodeIndex < NodesNum; NodeIndex++)
+	{
+		const FglTFRuntimeNode& Node = AllNodesCache[NodeIndex];
+		SceneGraphParents[NodeIndex] = AllNodesCache.IsValidIndex(Node.ParentIndex) ? Node.ParentIndex : INDEX_NONE;
+		SceneGraphDepths[NodeIndex] = INDEX_NONE;
+		SceneGraphTopRoots[NodeIndex] = INDEX_NONE;
+		SceneGraphTourBegin[NodeIndex] = INDEX_NONE;
+		SceneGraphTourEnd[NodeIndex] = INDEX_NONE;
+		SceneGraphLocalTransforms[NodeIndex] = Node.Transform;
+		// nodes unreachable from a root (cycles) keep their local transform
+		SceneGraphWorldTransforms[NodeIndex] = Node.Transform;
+	}
+
+	// single depth-first pass from every root: parents are always processed before their children,
+	// and every subtree maps to the contiguous range [TourBegin, TourEnd) (constant time ancestor checks)
+	TArray<TPair<int32, int32>> Stack;
+	int32 Tour = 0;
+
+	for (int32 RootIndex = 0; RootIndex < NodesNum; RootIndex++)
+	{
+		if (SceneGraphParents[RootIndex] != INDEX_NONE)
+		{
+			continue;
+		}
+
+		SceneGraphDepths[RootIndex] = 0;
+		SceneGraphTopRoots[RootIndex] = RootIndex;
+		SceneGraphTourBegin[RootIndex] = Tour++;
+		Stack.Add(TPair<int32, int32>(RootIndex, 0));
+
+		while (Stack.Num() > 0)
+		{
+			const int32 NodeIndex = Stack.Last().Key;
+			const TArray<int32>& ChildrenIndices = AllNodesCache[NodeIndex].ChildrenIndices;
+
+			if (Stack.Last().Value >= ChildrenIndices.Num())
+			{
+				SceneGraphTourEnd[NodeIndex] = Tour;
+				Stack.Pop();
+				continue;
+			}
+
+			const int32 ChildIndex = ChildrenIndices[Stack.Last().Value++];
+
+			// skip broken references and nodes claimed by another parent
+			if (!AllNodesCache.IsValidIndex(ChildIndex) || SceneGraphParents[ChildIndex] != NodeIndex || SceneGraphTourBegin[ChildIndex] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			SceneGraphDepths[ChildIndex] = SceneGraphDepths[NodeIndex] + 1;
+			SceneGraphTopRoots[ChildIndex] = RootIndex;
+			SceneGraphTourBegin[ChildIndex] = Tour++;
+			SceneGraphWorldTransforms[ChildIndex] = SceneGraphWorldTransforms[NodeIndex] * SceneGraphLocalTransforms[ChildIndex];
+			Stack.Add(TPair<int32, int32>(ChildIndex, 0));
+		}
+	}
+}
+
+bool FglTFRuntimeParser::SceneGraphIsAncestor(const int32 AncestorIndex, const int32 NodeIndex) const
+{
+	if (!SceneGraphTourBegin.IsValidIndex(AncestorIndex) || !SceneGraphTourBegin.IsValidIndex(NodeIndex))
+	{
+		return false;
+	}
+
+	const int32 AncestorTourBegin = SceneGraphTourBegin[AncestorIndex];
+	const int32 NodeTourBegin = SceneGraphTourBegin[NodeIndex];
+	if (AncestorTourBegin == INDEX_NONE || NodeTourBegin == INDEX_NONE)
+	{
+		return false;
+	}
+
+	return AncestorTourBegin < NodeTourBegin && NodeTourBegin < SceneGraphTourEnd[AncestorIndex];
+}
@@ -0,0 +1,488 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonSerializer.h"
+
+FCriticalSection FglTFRuntimeParser::SharedAssetsLock;
+TMap<FString, TWeakObjectPtr<UObject>> FglTFRuntimeParser::SharedAssets;
+TMap<TWeakObjectPtr<UStaticMesh>, TArray<TWeakObjectPtr<UStaticMeshComponent>>> FglTFRuntimeParser::SharedStaticMeshesCookingComponents;
+
+namespace glTFRuntime
+{
+	FString JsonObjectToString(TSharedRef<FJsonObject> JsonObject)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(JsonObject, JsonWriter);
+		return Json;
+	}
+
+	FString StructToString(UScriptStruct* Struct, const void* Value)
+	{
+		FString Text;
+		Struct->ExportText(Text, Value, nullptr, nullptr, PPF_None, nullptr);
+		return Text;
+	}
+
+	void GatherJsonNumberFields(TSharedPtr<FJsonValue> JsonValue, const FString& FieldName, TArray<int64>& Numbers)
+	{
+		if (!JsonValue)
+		{
+			return;
+		}
+
+		if (JsonValue->Type == EJson::Object)
+		{
+			TSharedPtr<FJsonObject> JsonObject = JsonValue->AsObject();
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonObject->Values)
+			{
+				if (Pair.Key == FieldName && Pair.Value && Pair.Value->Type == EJson::Number)
+				{
+					Numbers.Add(static_cast<int64>(Pair.Value->AsNumber()));
+				}
+				else
+				{
+					GatherJsonNumberFields(Pair.Value, FieldName, Numbers);
+				}
+			}
+		}
+		else if (JsonValue->Type == EJson::Array)
+		{
+			for (TSharedPtr<FJsonValue> JsonItem : JsonValue->AsArray())
+			{
+				GatherJsonNumberFields(JsonItem, FieldName, Numbers);
+			}
+		}
+	}
+
+	// texture slots reference the textures by their content (identical materials can use different, but equal, textures)
+	TSharedPtr<FJsonObject> CanonicalizeMaterialTextures(TSharedRef<FJsonObject> JsonObject, TFunctionRef<FString(const int64)> GetTextureContentKey)
+	{
+		TSharedRef<FJsonObject> JsonCanonicalObject = MakeShared<FJsonObject>();
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonObject->Values)
+		{
+			const TSharedPtr<FJsonObject>* JsonChildObject = nullptr;
+			if (!Pair.Value.IsValid() || !Pair.Value->TryGetObject(JsonChildObject))
+			{
+				JsonCanonicalObject->Values.Add(Pair.Key, Pair.Value);
+				continue;
+			}
+
+			int64 TextureIndex;
+			if (Pair.Key.EndsWith(TEXT("Texture")) && (*JsonChildObject)->TryGetNumberField(TEXT("index"), TextureIndex))
+			{
+				const FString TextureContentKey = GetTextureContentKey(TextureIndex);
+				if (TextureContentKey.IsEmpty())
+				{
+					return nullptr;
+				}
+
+				// texCoord (and the extensions, like KHR_texture_transform) are material parameters, so they are kept
+				TSharedRef<FJsonObject> JsonSlotObject = MakeShared<FJsonObject>();
+				JsonSlotObject->Values = (*JsonChildObject)->Values;
+				JsonSlotObject->RemoveField(TEXT("index"));
+				JsonSlotObject->SetStringField(TEXT("texture"), TextureContentKey);
+				JsonCanonicalObject->SetObjectField(Pair.Key, JsonSlotObject);
+			}
+			else
+			{
+				TSharedPtr<FJsonObject> JsonCanonicalChildObject = CanonicalizeMaterialTextures(JsonChildObject->ToSharedRef(), GetTextureContentKey);
+				if (!JsonCanonicalChildObject)
+				{
+					return nullptr;
+				}
+				JsonCanonicalObject->SetObjectField(Pair.Key, JsonCanonicalChildObject);
+			}
+		}
+		return JsonCanonicalObject;
+	}
+
+	FString HashString(const FString& Value)
+	{
+		uint8 Hash[FSHA1::DigestSize];
+		FSHA1::HashBuffer(*Value, Value.Len() * sizeof(TCHAR), Hash);
+		return BytesToHex(Hash, FSHA1::DigestSize);
+	}
+}
+
+UObject* FglTFRuntimeParser::FindSharedAsset(const FString& Key)
+{
+	if (Key.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	FScopeLock Lock(&SharedAssetsLock);
+	if (TWeakObjectPtr<UObject>* SharedAsset = SharedAssets.Find(Key))
+	{
+		return SharedAsset->Get();
+	}
+	return nullptr;
+}
+
+void FglTFRuntimeParser::AddSharedAsset(const FString& Key, UObject* Asset)
+{
+	if (Key.IsEmpty() || !Asset)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&SharedAssetsLock);
+
+	// purge the entries of already collected assets whenever the registry doubles its size
+	if (SharedAssets.Num() > 0 && FMath::IsPowerOfTwo(SharedAssets.Num()))
+	{
+		for (TMap<FString, TWeakObjectPtr<UObject>>::TIterator It(SharedAssets); It; ++It)
+		{
+			if (!It->Value.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	SharedAssets.Add(Key, Asset);
+}
+
+FString FglTFRuntimeParser::GetBufferViewContentKey(const int32 BufferViewIndex)
+{
+	const FString CacheKey = FString::Printf(TEXT("BufferView/%d"), BufferViewIndex);
+	{
+		FScopeLock Lock(&SharedAssetsKeysLock);
+		if (const FString* ContentKey = SharedAssetsContentKeysCache.Find(CacheKey))
+		{
+			return *ContentKey;
+		}
+	}
+
+	FglTFRuntimeBlob Blob;
+	int64 Stride = 0;
+	if (!GetBufferView(BufferViewIndex, Blob, Stride))
+	{
+		return "";
+	}
+
+	uint8 Hash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(Blob.Data, Blob.Num, Hash);
+	const FString ContentKey = FString::Printf(TEXT("%s/%lld"), *BytesToHex(Hash, FSHA1::DigestSize), Stride);
+
+	FScopeLock Lock(&SharedAssetsKeysLock);
+	SharedAssetsContentKeysCache.Add(CacheKey, ContentKey);
+	return ContentKey;
+}
+
+FString FglTFRuntimeParser::GetTextureContentKey(const int32 TextureIndex)
+{
+	const FString CacheKey = FString::Printf(TEXT("Texture/%d"), TextureIndex);
+	{
+		FScopeLock Lock(&SharedAssetsKeysLock);
+		if (const FString* ContentKey = SharedAssetsContentKeysCache.Find(CacheKey))
+		{
+			return *ContentKey;
+		}
+	}
+
+	TSharedPtr<FJsonObject> JsonTextureObject = GetJsonObjectFromRootIndex("textures", TextureIndex);
+	if (!JsonTextureObject)
+	{
+		return "";
+	}
+
+	int64 ImageIndex = INDEX_NONE;
+	OnTextureImageIndex.Broadcast(AsShared(), JsonTextureObject.ToSharedRef(), ImageIndex);
+
+	if (ImageIndex <= INDEX_NONE && !JsonTextureObject->TryGetNumberField(TEXT("source"), ImageIndex))
+	{
+		return "";
+	}
+
+	TSharedPtr<FJsonObject> JsonImageObject;
+	TArray64<uint8> CompressedBytes;
+	if (!LoadImageBytes(ImageIndex, JsonImageObject, CompressedBytes))
+	{
+		return "";
+	}
+
+	uint8 Hash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(CompressedBytes.GetData(), CompressedBytes.Num(), Hash);
+
+	FString ContentKey = BytesToHex(Hash, FSHA1::DigestSize) + glTFRuntime::JsonObjectToString(JsonTextureObject.ToSharedRef());
+
+	int64 SamplerIndex;
+	if (JsonTextureObject->TryGetNumberField(TEXT("sampler"), SamplerIndex))
+	{
+		TSharedPtr<FJsonObject> JsonSamplerObject = GetJsonObjectFromRootIndex("samplers", SamplerIndex);
+		if (JsonSamplerObject)
+		{
+			ContentKey += glTFRuntime::JsonObjectToString(JsonSamplerObject.ToSharedRef());
+		}
+	}
+
+	ContentKey = glTFRuntime::HashString(ContentKey);
+
+	FScopeLock Lock(&SharedAssetsKeysLock);
+	SharedAssetsContentKeysCache.Add(CacheKey, ContentKey);
+	return ContentKey;
+}
+
+FString FglTFRuntimeParser::GetMaterialContentKey(const int32 MaterialIndex)
+{
+	const FString CacheKey = FString::Printf(TEXT("Material/%d"), MaterialIndex);
+	{
+		FScopeLock Lock(&SharedAssetsKeysLock);
+		if (const FString* ContentKey = SharedAssetsContentKeysCache.Find(CacheKey))
+		{
+			return *ContentKey;
+		}
+	}
+
+	TSharedPtr<FJsonObject> JsonMaterialObject = GetJsonObjectFromRootIndex("materials", MaterialIndex);
+	if (!JsonMaterialObject)
+	{
+		return "";
+	}
+
+	FString ContentKey = glTFRuntime::JsonObjectToString(JsonMaterialObject.ToSharedRef());
+
+	// textures are referenced by index (textureInfo objects)
+	TArray<int64> TexturesIndices;
+	glTFRuntime::GatherJsonNumberFields(MakeShared<FJsonValueObject>(JsonMaterialObject), "index", TexturesIndices);
+	for (const int64 TextureIndex : TexturesIndices)
+	{
+		const FString TextureContentKey = GetTextureContentKey(TextureIndex);
+		if (TextureContentKey.IsEmpty())
+		{
+			return "";
+		}
+		ContentKey += "/" + TextureContentKey;
+	}
+
+	ContentKey = glTFRuntime::HashString(ContentKey);
+
+	FScopeLock Lock(&SharedAssetsKeysLock);
+	SharedAssetsContentKeysCache.Add(CacheKey, ContentKey);
+	return ContentKey;
+}
+
+FString FglTFRuntimeParser::GetMaterialsConfigKey(const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	return glTFRuntime::HashString(glTFRuntime::StructToString(FglTFRuntimeMaterialsConfig::StaticStruct(), &MaterialsConfig));
+}
+
+FString FglTFRuntimeParser::GetStaticMeshConfigKey(const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
+{
+	// per-instance fields do not change the generated asset
+	FglTFRuntimeStaticMeshConfig KeyStaticMeshConfig = StaticMeshConfig;
+	KeyStaticMeshConfig.Outer = nullptr;
+	KeyStaticMeshConfig.CacheMode = FglTFRuntimeStaticMeshConfig().CacheMode;
+	KeyStaticMeshConfig.MaterialsConfig.CacheMode = FglTFRuntimeMaterialsConfig().CacheMode;
+
+	return glTFRuntime::StructToString(FglTFRuntimeStaticMeshConfig::StaticStruct(), &KeyStaticMeshConfig);
+}
+
+void FglTFRuntimeParser::AddSharedStaticMeshCooking(UStaticMesh* StaticMesh)
+{
+	FScopeLock Lock(&SharedAssetsLock);
+	SharedStaticMeshesCookingComponents.FindOrAdd(StaticMesh);
+}
+
+TArray<TWeakObjectPtr<UStaticMeshComponent>> FglTFRuntimeParser::PopSharedStaticMeshCookingComponents(UStaticMesh* StaticMesh)
+{
+	FScopeLock Lock(&SharedAssetsLock);
+	TArray<TWeakObjectPtr<UStaticMeshComponent>> StaticMeshComponents;
+	SharedStaticMeshesCookingComponents.RemoveAndCopyValue(StaticMesh, StaticMeshComponents);
+	return StaticMeshComponents;
+}
+
+void FglTFRuntimeParser::AddSharedStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent)
+{
+	if (!StaticMeshComponent || !StaticMeshComponent->GetStaticMesh())
+	{
+		return;
+	}
+
+	// nothing to do if the mesh is not cooking (the physics state has been created with the cooked data)
+	FScopeLock Lock(&SharedAssetsLock);
+	if (TArray<TWeakObjectPtr<UStaticMeshComponent>>* StaticMeshComponents = SharedStaticMeshesCookingComponents.Find(StaticMeshComponent->GetStaticMesh()))
+	{
+		StaticMeshComponents->AddUnique(StaticMeshComponent);
+	}
+}
+
+bool FglTFRuntimeParser::CanShareStaticMesh(const FglTFRuntimeStaticMeshConfig& StaticMeshConfig) const
+{
+	return bShareAssets && !StaticMeshConfig.bBuildComplexCollision && StaticMeshConfig.CollisionComplexity != ECollisionTraceFlag::CTF_UseComplexAsSimple;
+}
+
+FString FglTFRuntimeParser::GetSharedStaticMeshKey(TSharedRef<FJsonObject> JsonMeshObject, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_GetSharedStaticMeshKey, FColor::Magenta);
+
+	if (!CanShareStaticMesh(StaticMeshConfig))
+	{
+		return "";
+	}
+
+	FString Key = glTFRuntime::JsonObjectToString(JsonMeshObject);
+	Key += SceneBasis.ToString() + FString::SanitizeFloat(SceneScale);
+	Key += GetStaticMeshConfigKey(StaticMeshConfig);
+
+	const TArray<TSharedPtr<FJsonValue>>* JsonPrimitives;
+	if (!JsonMeshObject->TryGetArrayField(TEXT("primitives"), JsonPrimitives))
+	{
+		return "";
+	}
+
+	for (TSharedPtr<FJsonValue> JsonPrimitive : *JsonPrimitives)
+	{
+		TSharedPtr<FJsonObject> JsonPrimitiveObject = JsonPrimitive->AsObject();
+		if (!JsonPrimitiveObject)
+		{
+			return "";
+		}
+
+		// attributes, indices and morph targets
+		TArray<int64> AccessorsIndices;
+		const TSharedPtr<FJsonObject>* JsonAttributesObject;
+		if (JsonPrimitiveObject->TryGetObjectField(TEXT("attributes"), JsonAttributesObject))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*JsonAttributesObject)->Values)
+			{
+				AccessorsIndices.Add(static_cast<int64>(Pair.Value->AsNumber()));
+			}
+		}
+
+		int64 IndicesAccessorIndex;
+		if (JsonPrimitiveObject->TryGetNumberField(TEXT("indices"), IndicesAccessorIndex))
+		{
+			AccessorsIndices.Add(IndicesAccessorIndex);
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* JsonTargets;
+		if (JsonPrimitiveObject->TryGetArrayField(TEXT("targets"), JsonTargets))
+		{
+			for (TSharedPtr<FJsonValue> JsonTarget : *JsonTargets)
+			{
+				TSharedPtr<FJsonObject> JsonTargetObject = JsonTarget->AsObject();
+				if (JsonTargetObject)
+				{
+					for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : JsonTargetObject->Values)
+					{
+						AccessorsIndices.Add(static_cast<int64>(Pair.Value->AsNumber()));
+					}
+				}
+			}
+		}
+
+		// buffer views referenced by the accessors (including sparse ones) and by the extensions (compressed primitives)
+		TArray<int64> BufferViewsIndices;
+		glTFRuntime::GatherJsonNumberFields(JsonPrimitive, "bufferView", BufferViewsIndices);
+
+		for (const int64 AccessorIndex : AccessorsIndices)
+		{
+			TSharedPtr<FJsonObject> JsonAccessorObject = GetJsonObjectFromRootIndex("accessors", AccessorIndex);
+			if (!JsonAccessorObject)
+			{
+				return "";
+			}
+			Key += glTFRuntime::JsonObjectToString(JsonAccessorObject.ToSharedRef());
+			glTFRuntime::GatherJsonNumberFields(MakeShared<FJsonValueObject>(JsonAccessorObject), "bufferView", BufferViewsIndices);
+		}
+
+		for (const int64 BufferViewIndex : BufferViewsIndices)
+		{
+			const FString BufferViewContentKey = GetBufferViewContentKey(BufferViewIndex);
+			if (BufferViewContentKey.IsEmpty())
+			{
+				return "";
+			}
+			Key += "/" + BufferViewContentKey;
+		}
+
+		// materials (including variants)
+		TArray<int64> MaterialsIndices;
+		glTFRuntime::GatherJsonNumberFields(JsonPrimitive, "material", MaterialsIndices);
+		for (const int64 MaterialIndex : MaterialsIndices)
+		{
+			const FString MaterialContentKey = GetMaterialContentKey(MaterialIndex);
+			if (MaterialContentKey.IsEmpty())
+			{
+				return "";
+			}
+			Key += "/" + MaterialContentKey;
+		}
+	}
+
+	return "StaticMesh/" + glTFRuntime::HashString(Key);
+}
+
+FString FglTFRuntimeParser::GetSharedMaterialKey(const int32 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors, UMaterialInterface* ForceBaseMaterial)
+{
+	const FString MaterialContentKey = GetMaterialContentKey(MaterialIndex);
+	if (MaterialContentKey.IsEmpty())
+	{
+		return "";
+	}
+
+	FString Key = MaterialContentKey + (bUseVertexColors ? "/VertexColors/" : "/") + GetPathNameSafe(ForceBaseMaterial);
+	Key += glTFRuntime::StructToString(FglTFRuntimeMaterialsConfig::StaticStruct(), &MaterialsConfig);
+
+	return "Material/" + glTFRuntime::HashString(Key);
+}
+
+FString FglTFRuntimeParser::GetCanonicalMaterialKey(const int32 MaterialIndex, const FString& MaterialName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors, UMaterialInterface* ForceBaseMaterial)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_GetCanonicalMaterialKey, FColor::Magenta);
+
+	TSharedPtr<FJsonObject> JsonMaterialObject = GetJsonObjectFromRootIndex("materials", MaterialIndex);
+	if (!JsonMaterialObject)
+	{
+		return "";
+	}
+
+	// name and extras do not affect the material instance
+	TSharedRef<FJsonObject> JsonMaterialCopyObject = MakeShared<FJsonObject>();
+	JsonMaterialCopyObject->Values = JsonMaterialObject->Values;
+	JsonMaterialCopyObject->RemoveField(TEXT("name"));
+	JsonMaterialCopyObject->RemoveField(TEXT("extras"));
+
+	// textures are identified by their content (image, texture and sampler), not by their index
+	TSharedPtr<FJsonObject> JsonCanonicalObject = glTFRuntime::CanonicalizeMaterialTextures(JsonMaterialCopyObject, [this](const int64 TextureIndex) { return GetTextureContentKey(TextureIndex); });
+	if (!JsonCanonicalObject)
+	{
+		return "";
+	}
+
+	FString Key = glTFRuntime::JsonObjectToString(JsonCanonicalObject.ToSharedRef());
+
+	// per-material overrides and asset user data must not leak to other materials
+	if (MaterialsConfig.MaterialsOverrideMap.Contains(MaterialIndex) || AssetUserDataClasses.Num() > 0)
+	{
+		Key += FString::Printf(TEXT("/Index/%d"), MaterialIndex);
+	}
+
+	if (MaterialsConfig.MaterialsOverrideByNameMap.Contains(MaterialName))
+	{
+		Key += "/Name/" + MaterialName;
+	}
+
+	Key += (bUseVertexColors ? "/VertexColors/" : "/") + GetPathNameSafe(ForceBaseMaterial);
+	Key += glTFRuntime::StructToString(FglTFRuntimeMaterialsConfig::StaticStruct(), &MaterialsConfig);
+
+	return "Material/" + glTFRuntime::HashString(Key);
+}
+
+FString FglTFRuntimeParser::GetSharedTextureKey(const int32 TextureIndex, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
+{
+	const FString TextureContentKey = GetTextureContentKey(TextureIndex);
+	if (TextureContentKey.IsEmpty())
+	{
+		return "";
+	}
+
+	FString Key = TextureContentKey + (sRGB ? "/sRGB/" : "/");
+	Key += glTFRuntime::StructToString(FglTFRuntimeMaterialsConfig::StaticStruct(), &MaterialsConfig);
+
+	return "Texture/" + glTFRuntime::HashString(Key);
+}
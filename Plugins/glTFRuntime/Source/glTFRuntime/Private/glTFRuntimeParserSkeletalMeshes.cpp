@@ -35,6 +35,7 @@
 #include "glTFAnimBoneCompressionCodec.h"
 #include "glTFAnimCurveCompressionCodec.h"
 #include "Model.h"
+#include "Algo/Sort.h"
 #include "Animation/MorphTarget.h"
 #include "Animation/AnimCurveTypes.h"
 #include "PhysicsEngine/PhysicsAsset.h"
@@ -212,6 +213,131 @@ void FglTFRuntimeParser::CopySkeletonRotationsFrom(FReferenceSkeleton& RefSkelet
 	}
 }
 
+namespace glTFRuntime
+{
+	// convert the (already normalized) 16 bit weights of every vertex of the primitive straight into skin weight infos
+	void BuildSkinWeights(const FglTFRuntimePrimitive& Primitive, const TMap<int32, FName>& BoneMap, const FReferenceSkeleton& RefSkeleton, const int32 MaxBoneInfluences, const bool bIgnoreMissingBones, TArray<FSkinWeightInfo>& SkinWeights, int32& MissingJoint)
+	{
+		constexpr int32 UnmappedJoint = MIN_int32;
+
+		// joints are resolved to bones only once (joints are 16 bit, bigger keys can never be referenced)
+		int32 MaxJoint = INDEX_NONE;
+		for (const TPair<int32, FName>& Pair : BoneMap)
+		{
+			if (Pair.Key <= MAX_uint16)
+			{
+				MaxJoint = FMath::Max(MaxJoint, Pair.Key);
+			}
+		}
+
+		// OverrideBoneMap keys can be big offsets, use a lookup table only when it is dense enough
+		const bool bDenseJoints = MaxJoint < BoneMap.Num() * 4 + 256;
+
+		TArray<int32> JointsToBones;
+		TMap<int32, int32> SparseJointsToBones;
+		if (bDenseJoints)
+		{
+			JointsToBones.Init(UnmappedJoint, MaxJoint + 1);
+		}
+		for (const TPair<int32, FName>& Pair : BoneMap)
+		{
+			if (Pair.Key >= 0 && Pair.Key <= MaxJoint)
+			{
+				const int32 BoneIndex = RefSkeleton.FindBoneIndex(Pair.Value);
+				if (bDenseJoints)
+				{
+					JointsToBones[Pair.Key] = BoneIndex;
+				}
+				else
+				{
+					SparseJointsToBones.Add(Pair.Key, BoneIndex);
+				}
+			}
+		}
+
+		auto GetJointBone = [&](const int32 Joint) -> int32
+			{
+				if (bDenseJoints)
+				{
+					return JointsToBones.IsValidIndex(Joint) ? JointsToBones[Joint] : UnmappedJoint;
+				}
+				const int32* BoneIndex = SparseJointsToBones.Find(Joint);
+				return BoneIndex ? *BoneIndex : UnmappedJoint;
+			};
+
+		const int32 NumVertices = Primitive.Positions.Num();
+		const int32 JointsNum = FMath::Min3(Primitive.Joints.Num(), Primitive.Weights.Num(), MaxBoneInfluences / 4);
+
+		SkinWeights.SetNumZeroed(NumVertices);
+
+		constexpr int32 ChunkSize = 4096;
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumVertices, ChunkSize);
+
+		TArray<int32> ChunksMissingJoint;
+		ChunksMissingJoint.Init(INDEX_NONE, NumChunks);
+
+		ParallelFor(NumChunks, [&](const int32 ChunkIndex)
+			{
+				const int32 FirstVertex = ChunkIndex * ChunkSize;
+				const int32 LastVertex = FMath::Min(FirstVertex + ChunkSize, NumVertices);
+				for (int32 VertexIndex = FirstVertex; VertexIndex < LastVertex; VertexIndex++)
+				{
+					FSkinWeightInfo& SkinWeight = SkinWeights[VertexIndex];
+					uint32 TotalWeight = 0;
+					for (int32 JointsIndex = 0; JointsIndex < JointsNum; JointsIndex++)
+					{
+						if (!Primitive.Joints[JointsIndex].IsValidIndex(VertexIndex) || !Primitive.Weights[JointsIndex].IsValidIndex(VertexIndex))
+						{
+							continue;
+						}
+
+						const FglTFRuntimeUInt16Vector4& Joints = Primitive.Joints[JointsIndex][VertexIndex];
+						const FglTFRuntimeUInt16Vector4& Weights = Primitive.Weights[JointsIndex][VertexIndex];
+						for (int32 j = 0; j < 4; j++)
+						{
+							const int32 BoneIndex = GetJointBone(Joints[j]);
+							if (BoneIndex == UnmappedJoint)
+							{
+								if (!bIgnoreMissingBones)
+								{
+									ChunksMissingJoint[ChunkIndex] = Joints[j];
+									return;
+								}
+								continue;
+							}
+
+							uint32 QuantizedWeight = (static_cast<uint32>(Weights[j]) * MAX_BONE_INFLUENCE_WEIGHT + (MAX_uint16 / 2)) / MAX_uint16;
+							if (QuantizedWeight + TotalWeight > MAX_BONE_INFLUENCE_WEIGHT)
+							{
+								QuantizedWeight = MAX_BONE_INFLUENCE_WEIGHT - TotalWeight;
+							}
+
+							SkinWeight.InfluenceWeights[JointsIndex * 4 + j] = static_cast<BONE_INFLUENCE_TYPE>(QuantizedWeight);
+							SkinWeight.InfluenceBones[JointsIndex * 4 + j] = BoneIndex;
+
+							TotalWeight += QuantizedWeight;
+						}
+					}
+
+					// fix weight
+					if (TotalWeight < MAX_BONE_INFLUENCE_WEIGHT)
+					{
+						SkinWeight.InfluenceWeights[0] += MAX_BONE_INFLUENCE_WEIGHT - TotalWeight;
+					}
+				}
+			});
+
+		for (const int32 ChunkMissingJoint : ChunksMissingJoint)
+		{
+			if (ChunkMissingJoint > INDEX_NONE)
+			{
+				MissingJoint = ChunkMissingJoint;
+				return;
+			}
+		}
+	}
+}
+
 USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRuntimeSkeletalMeshContext, ESPMode::ThreadSafe> SkeletalMeshContext)
 {
 	if (!SkeletalMeshContext->SkeletalMesh)
@@ -447,6 +573,20 @@ USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRu
 			TMap<int32, TArray<int32>> OverlappingVertices;
 			MeshSection.DuplicatedVerticesBuffer.Init(MeshSection.NumVertices, OverlappingVertices);
 
+			// skin weights are resolved once per vertex (instead of once per index)
+			const bool bSkinned = (!SkeletalMeshContext->SkeletalMeshConfig.bIgnoreSkin && SkeletalMeshContext->SkinIndex > INDEX_NONE) || LOD->Skeleton.Num() > 0;
+			TArray<FSkinWeightInfo> PrimitiveSkinWeights;
+			if (bSkinned)
+			{
+				int32 MissingJoint = INDEX_NONE;
+				glTFRuntime::BuildSkinWeights(Primitive, Primitive.OverrideBoneMap.Num() > 0 ? Primitive.OverrideBoneMap : MainBoneMap, RefSkeleton, MeshSection.MaxBoneInfluences, SkeletalMeshContext->SkeletalMeshConfig.bIgnoreMissingBones, PrimitiveSkinWeights, MissingJoint);
+				if (MissingJoint > INDEX_NONE)
+				{
+					AddError("LoadSkeletalMesh_Internal()", FString::Printf(TEXT("Unable to find map for bone %d"), MissingJoint));
+					return nullptr;
+				}
+			}
+
 			// this is used for non-skinned asset loaded as skinned ones
 			int32 OverrideIndexToCheck = 0;
 
@@ -537,54 +677,9 @@ USkeletalMesh* FglTFRuntimeParser::CreateSkeletalMeshFromLODs(TSharedRef<FglTFRu
 				TMap<int32, FName>& BoneMapInUse = Primitive.OverrideBoneMap.Num() > 0 ? Primitive.OverrideBoneMap : MainBoneMap;
 				TMap<int32, int32>& BonesCacheInUse = Primitive.OverrideBoneMap.Num() > 0 ? Primitive.BonesCache : MainBonesCache;
 
-				if ((!SkeletalMeshContext->SkeletalMeshConfig.bIgnoreSkin && SkeletalMeshContext->SkinIndex > INDEX_NONE) || LOD->Skeleton.Num() > 0)
+				if (bSkinned)
 				{
-					uint32 TotalWeight = 0;
-					const int32 JointsNum = FMath::Min(Primitive.Joints.Num(), MeshSection.MaxBoneInfluences / 4);
-					for (int32 JointsIndex = 0; JointsIndex < JointsNum; JointsIndex++)
-					{
-						const FglTFRuntimeUInt16Vector4& Joints = Primitive.Joints[JointsIndex][Index];
-						const FVector4& Weights = Primitive.Weights[JointsIndex][Index];
-						for (int32 j = 0; j < 4; j++)
-						{
-							if (BoneMapInUse.Contains(Joints[j]))
-							{
-								int32 BoneIndex = INDEX_NONE;
-								if (BonesCacheInUse.Contains(Joints[j]))
-								{
-									BoneIndex = BonesCacheInUse[Joints[j]];
-								}
-								else
-								{
-									BoneIndex = RefSkeleton.FindBoneIndex(BoneMapInUse[Joints[j]]);
-									BonesCacheInUse.Add(Joints[j], BoneIndex);
-								}
-
-								BONE_INFLUENCE_TYPE QuantizedWeight = FMath::Clamp((BONE_INFLUENCE_TYPE)(Weights[j] * ((double)MAX_BONE_INFLUENCE_WEIGHT)), (BONE_INFLUENCE_TYPE)0x00, (BONE_INFLUENCE_TYPE)MAX_BONE_INFLUENCE_WEIGHT);
-
-								if (QuantizedWeight + TotalWeight > MAX_BONE_INFLUENCE_WEIGHT)
-								{
-									QuantizedWeight = MAX_BONE_INFLUENCE_WEIGHT - TotalWeight;
-								}
-
-								InWeights[TotalVertexIndex].InfluenceWeights[JointsIndex * 4 + j] = QuantizedWeight;
-								InWeights[TotalVertexIndex].InfluenceBones[JointsIndex * 4 + j] = BoneIndex;
-
-								TotalWeight += QuantizedWeight;
-							}
-							else if (!SkeletalMeshContext->SkeletalMeshConfig.bIgnoreMissingBones)
-							{
-								AddError("LoadSkeletalMesh_Internal()", FString::Printf(TEXT("Unable to find map for bone %u"), Joints[j]));
-								return nullptr;
-							}
-						}
-					}
-
-					// fix weight
-					if (TotalWeight < MAX_BONE_INFLUENCE_WEIGHT)
-					{
-						InWeights[TotalVertexIndex].InfluenceWeights[0] += MAX_BONE_INFLUENCE_WEIGHT - TotalWeight;
-					}
+					InWeights[TotalVertexIndex] = PrimitiveSkinWeights[Index];
 				}
 				else if (SkeletalMeshContext->SkeletalMeshConfig.SkeletonConfig.bFallbackToNodesTree)
 				{
@@ -927,6 +1022,38 @@ USkeletalMesh* FglTFRuntimeParser::FinalizeSkeletalMeshWithLODs(TSharedRef<FglTF
 
 				FglTFRuntimePrimitive& Primitive = SkeletalMeshContext->LODs[LODIndex]->Primitives[PrimitiveIndex];
 
+				// map each vertex to the section vertices (one per index) using it, so only the stored deltas need to be visited
+				TArray<int32> VertexUsagesOffsets;
+				TArray<int32> VertexUsages;
+				if (Primitive.MorphTargets.Num() > 0)
+				{
+					const int32 VerticesNum = Primitive.Positions.Num();
+					VertexUsagesOffsets.SetNumZeroed(VerticesNum + 1);
+					for (const uint32 VertexIndex : Primitive.Indices)
+					{
+						if (VertexIndex < static_cast<uint32>(VerticesNum))
+						{
+							VertexUsagesOffsets[VertexIndex + 1]++;
+						}
+					}
+
+					for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+					{
+						VertexUsagesOffsets[VertexIndex + 1] += VertexUsagesOffsets[VertexIndex];
+					}
+
+					VertexUsages.SetNumUninitialized(VertexUsagesOffsets[VerticesNum]);
+					TArray<int32> VertexUsagesCursors(VertexUsagesOffsets.GetData(), VerticesNum);
+					for (int32 Index = 0; Index < Primitive.Indices.Num(); Index++)
+					{
+						const uint32 VertexIndex = Primitive.Indices[Index];
+						if (VertexIndex < static_cast<uint32>(VerticesNum))
+						{
+							VertexUsages[VertexUsagesCursors[VertexIndex]++] = Index;
+						}
+					}
+				}
+
 				for (FglTFRuntimeMorphTarget& MorphTargetData : Primitive.MorphTargets)
 				{
 					bool bSkip = true;
@@ -934,43 +1061,49 @@ USkeletalMesh* FglTFRuntimeParser::FinalizeSkeletalMeshWithLODs(TSharedRef<FglTF
 					MorphTargetLODModel.NumBaseMeshVerts = Primitive.Indices.Num();
 					MorphTargetLODModel.SectionIndices.Add(PrimitiveIndex);
 
-					for (int32 Index = 0; Index < Primitive.Indices.Num(); Index++)
+					// only the non-zero deltas are emitted
+					const int32 DeltasNum = MorphTargetData.IsSparse() ? MorphTargetData.Indices.Num() : MorphTargetData.Positions.Num();
+					for (int32 DeltaIndex = 0; DeltaIndex < DeltasNum; DeltaIndex++)
 					{
-						FMorphTargetDelta Delta;
-						int32 VertexIndex = Primitive.Indices[Index];
-						if (VertexIndex < MorphTargetData.Positions.Num())
+						const int32 VertexIndex = MorphTargetData.IsSparse() ? MorphTargetData.Indices[DeltaIndex] : DeltaIndex;
+						if (!MorphTargetData.Positions.IsValidIndex(DeltaIndex) || VertexIndex < 0 || VertexIndex >= VertexUsagesOffsets.Num() - 1)
 						{
-#if ENGINE_MAJOR_VERSION > 4
-							Delta.PositionDelta = FVector3f(MorphTargetData.Positions[VertexIndex]);
-#else
-							Delta.PositionDelta = MorphTargetData.Positions[VertexIndex];
-#endif
+							continue;
 						}
-						else
-						{
+
 #if ENGINE_MAJOR_VERSION > 4
-							Delta.PositionDelta = FVector3f::ZeroVector;
+						const FVector3f PositionDelta = FVector3f(MorphTargetData.Positions[DeltaIndex]);
 #else
-							Delta.PositionDelta = FVector::ZeroVector;
+						const FVector PositionDelta = MorphTargetData.Positions[DeltaIndex];
 #endif
+						if (PositionDelta.IsZero())
+						{
+							continue;
 						}
 
-						if (!Delta.PositionDelta.IsNearlyZero())
+						if (!PositionDelta.IsNearlyZero())
 						{
 							bSkip = false;
 						}
 
-						Delta.SourceIdx = BaseIndex + Index;
+						for (int32 UsageIndex = VertexUsagesOffsets[VertexIndex]; UsageIndex < VertexUsagesOffsets[VertexIndex + 1]; UsageIndex++)
+						{
+							FMorphTargetDelta Delta;
+							Delta.PositionDelta = PositionDelta;
+							Delta.SourceIdx = BaseIndex + VertexUsages[UsageIndex];
 #if ENGINE_MAJOR_VERSION > 4
-						Delta.TangentZDelta = FVector3f::ZeroVector;
+							Delta.TangentZDelta = FVector3f::ZeroVector;
 #else
-						Delta.TangentZDelta = FVector::ZeroVector;
+							Delta.TangentZDelta = FVector::ZeroVector;
 #endif
-						MorphTargetLODModel.Vertices.Add(Delta);
+							MorphTargetLODModel.Vertices.Add(Delta);
+						}
+					}
+
+					Algo::SortBy(MorphTargetLODModel.Vertices, &FMorphTargetDelta::SourceIdx);
 #if ENGINE_MAJOR_VERSION > 4
-						MorphTargetLODModel.NumVertices = MorphTargetLODModel.Vertices.Num();
+					MorphTargetLODModel.NumVertices = MorphTargetLODModel.Vertices.Num();
 #endif
-					}
 
 					if (SkeletalMeshContext->SkeletalMeshConfig.bIgnoreEmptyMorphTargets && bSkip)
 					{
@@ -1141,12 +1274,22 @@ USkeletalMesh* FglTFRuntimeParser::FinalizeSkeletalMeshWithLODs(TSharedRef<FglTF
 	}
 	else
 	{
-		if (CanReadFromCache(SkeletalMeshContext->SkeletalMeshConfig.SkeletonConfig.CacheMode) && SkeletalMeshContext->SkinIndex > -1 && SkeletonsCache.Contains(SkeletalMeshContext->SkinIndex))
+		USkeleton* CachedSkeleton = nullptr;
+		if (CanReadFromCache(SkeletalMeshContext->SkeletalMeshConfig.SkeletonConfig.CacheMode) && SkeletalMeshContext->SkinIndex > -1)
+		{
+			FReadScopeLock Lock(ObjectsCacheLock);
+			if (SkeletonsCache.Contains(SkeletalMeshContext->SkinIndex))
+			{
+				CachedSkeleton = SkeletonsCache[SkeletalMeshContext->SkinIndex];
+			}
+		}
+
+		if (CachedSkeleton)
 		{
 #if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
-			SkeletalMeshContext->SkeletalMesh->SetSkeleton(SkeletonsCache[SkeletalMeshContext->SkinIndex]);
+			SkeletalMeshContext->SkeletalMesh->SetSkeleton(CachedSkeleton);
 #else
-			SkeletalMeshContext->SkeletalMesh->Skeleton = SkeletonsCache[SkeletalMeshContext->SkinIndex];
+			SkeletalMeshContext->SkeletalMesh->Skeleton = CachedSkeleton;
 #endif
 		}
 		else
@@ -1161,6 +1304,7 @@ USkeletalMesh* FglTFRuntimeParser::FinalizeSkeletalMeshWithLODs(TSharedRef<FglTF
 
 			if (CanWriteToCache(SkeletalMeshContext->SkeletalMeshConfig.SkeletonConfig.CacheMode) && SkeletalMeshContext->SkinIndex > -1)
 			{
+				FWriteScopeLock Lock(ObjectsCacheLock);
 				SkeletonsCache.Add(SkeletalMeshContext->SkinIndex, SkeletalMeshContext->GetSkeleton());
 			}
 
@@ -1911,6 +2055,8 @@ UAnimSequence* FglTFRuntimeParser::LoadNodeSkeletalAnimation(USkeletalMesh* Skel
 		return nullptr;
 	}
 
+	FglTFRuntimeAnimationBoneMap BoneMap;
+
 	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < JsonAnimations->Num(); JsonAnimationIndex++)
 	{
 		TSharedPtr<FJsonObject> JsonAnimationObject = (*JsonAnimations)[JsonAnimationIndex]->AsObject();
@@ -1919,7 +2065,7 @@ UAnimSequence* FglTFRuntimeParser::LoadNodeSkeletalAnimation(USkeletalMesh* Skel
 			return nullptr;
 		}
 		float Duration;
-		TMap<FString, FRawAnimSequenceTrack> Tracks;
+		FglTFRuntimeBoneTracks Tracks;
 		TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
 		bool bAnimationFound = false;
 		if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [&Joints, &bAnimationFound, NodeIndex](const FglTFRuntimeNode& Node) -> bool
@@ -1929,7 +2075,7 @@ UAnimSequence* FglTFRuntimeParser::LoadNodeSkeletalAnimation(USkeletalMesh* Skel
 					bAnimationFound = (Node.Index == NodeIndex) || Joints.Contains(Node.Index);
 				}
 				return true;
-			}))
+			}, BoneMap))
 		{
 			return nullptr;
 		}
@@ -1995,6 +2141,8 @@ TMap<FString, UAnimSequence*> FglTFRuntimeParser::LoadNodeSkeletalAnimationsMap(
 		return SkeletalAnimationsMap;
 	}
 
+	FglTFRuntimeAnimationBoneMap BoneMap;
+
 	for (int32 JsonAnimationIndex = 0; JsonAnimationIndex < JsonAnimations->Num(); JsonAnimationIndex++)
 	{
 		TSharedPtr<FJsonObject> JsonAnimationObject = (*JsonAnimations)[JsonAnimationIndex]->AsObject();
@@ -2010,7 +2158,7 @@ TMap<FString, UAnimSequence*> FglTFRuntimeParser::LoadNodeSkeletalAnimationsMap(
 		}
 
 		float Duration;
-		TMap<FString, FRawAnimSequenceTrack> Tracks;
+		FglTFRuntimeBoneTracks Tracks;
 		TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
 		bool bAnimationFound = false;
 		if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [&Joints, &bAnimationFound, NodeIndex](const FglTFRuntimeNode& Node) -> bool
@@ -2020,7 +2168,7 @@ TMap<FString, UAnimSequence*> FglTFRuntimeParser::LoadNodeSkeletalAnimationsMap(
 					bAnimationFound = (Node.Index == NodeIndex) || Joints.Contains(Node.Index);
 				}
 				return true;
-			}))
+			}, BoneMap))
 		{
 			continue;
 		}
@@ -2057,6 +2205,19 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimationFromTracksAndMorphTarget
 }
 
 UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimationFromTracksAndMorphTargets(USkeleton* Skeleton, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, const float Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	FglTFRuntimeBoneTracks BoneTracks;
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	for (const TPair<FString, FRawAnimSequenceTrack>& Pair : Tracks)
+	{
+		const int32 TrackIndex = BoneTracks.FindOrAdd(RefSkeleton.FindBoneIndex(*Pair.Key), Pair.Key);
+		BoneTracks.Tracks[TrackIndex] = Pair.Value;
+	}
+
+	return LoadSkeletalAnimationFromBoneTracks(Skeleton, BoneTracks, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+}
+
+UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimationFromBoneTracks(USkeleton* Skeleton, FglTFRuntimeBoneTracks& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, const float Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
 {
 	int32 NumFrames = FMath::Max<int32>(Duration * SkeletalAnimationConfig.FramesPerSecond, 1);
 	UAnimSequence* AnimSequence = NewObject<UAnimSequence>(GetTransientPackage(), NAME_None, RF_Public);
@@ -2140,40 +2301,44 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimationFromTracksAndMorphTarget
 #endif
 #endif
 
+	const FReferenceSkeleton& RefSkeleton = AnimSequence->GetSkeleton()->GetReferenceSkeleton();
+
 	bool bHasTracks = false;
-	for (TPair<FString, FRawAnimSequenceTrack>& Pair : Tracks)
+	for (int32 TrackIndex = 0; TrackIndex < Tracks.Num(); TrackIndex++)
 	{
-		const FName BoneName = FName(Pair.Key);
-
-		if (!SanitizeBoneTrack(AnimSequence->GetSkeleton()->GetReferenceSkeleton(), Pair.Key, NumFrames, Pair.Value, SkeletalAnimationConfig))
+		const int32 BoneIndex = Tracks.BoneIndices[TrackIndex];
+		if (BoneIndex <= INDEX_NONE || BoneIndex >= RefSkeleton.GetNum())
 		{
-			return nullptr;
+			AddError("SanitizeBoneTrack()", FString::Printf(TEXT("Unable to find bone %s"), *Tracks.Names[TrackIndex]));
+			continue;
 		}
 
-		const int32 BoneIndex = AnimSequence->GetSkeleton()->GetReferenceSkeleton().FindBoneIndex(BoneName);
-		if (BoneIndex <= INDEX_NONE)
+		FRawAnimSequenceTrack& Track = Tracks.Tracks[TrackIndex];
+		if (!SanitizeBoneTrack(RefSkeleton, BoneIndex, NumFrames, Track, SkeletalAnimationConfig))
 		{
-			continue;
+			return nullptr;
 		}
 
+		const FName BoneName = RefSkeleton.GetBoneName(BoneIndex);
+
 #if WITH_EDITOR
 #if ENGINE_MAJOR_VERSION >= 5
 #if ENGINE_MINOR_VERSION >= 2
 		AnimSequence->GetController().AddBoneCurve(BoneName, false);
-		AnimSequence->GetController().SetBoneTrackKeys(BoneName, Pair.Value.PosKeys, Pair.Value.RotKeys, Pair.Value.ScaleKeys, false);
+		AnimSequence->GetController().SetBoneTrackKeys(BoneName, Track.PosKeys, Track.RotKeys, Track.ScaleKeys, false);
 #else
 		TArray<FBoneAnimationTrack>& BoneTracks = const_cast<TArray<FBoneAnimationTrack>&>(AnimSequence->GetDataModel()->GetBoneAnimationTracks());
 		FBoneAnimationTrack BoneTrack;
 		BoneTrack.Name = BoneName;
 		BoneTrack.BoneTreeIndex = BoneIndex;
-		BoneTrack.InternalTrackData = Pair.Value;
+		BoneTrack.InternalTrackData = Track;
 		BoneTracks.Add(BoneTrack);
 #endif
 #else
-		AnimSequence->AddNewRawTrack(BoneName, &Pair.Value);
+		AnimSequence->AddNewRawTrack(BoneName, &Track);
 #endif
 #else
-		CompressionCodec->Tracks[BoneIndex] = Pair.Value;
+		CompressionCodec->Tracks[BoneIndex] = MoveTemp(Track);
 #endif
 		bHasTracks = true;
 	}
@@ -2182,9 +2347,9 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimationFromTracksAndMorphTarget
 	{
 		for (int32 BoneIndex = 0; BoneIndex < BonesPoses.Num(); BoneIndex++)
 		{
-			const FString BoneName = AnimSequence->GetSkeleton()->GetReferenceSkeleton().GetBoneName(BoneIndex).ToString();
-			if (!Tracks.Contains(BoneName))
+			if (Tracks.Find(BoneIndex, FString()) <= INDEX_NONE)
 			{
+				const FString BoneName = RefSkeleton.GetBoneName(BoneIndex).ToString();
 				FRawAnimSequenceTrack NewTrack;
 				FglTFRuntimeNode BoneNode;
 				if (LoadNodeByName(BoneName, BoneNode))
@@ -2388,11 +2553,16 @@ bool FglTFRuntimeParser::LoadAnimationAsTracksAndMorphTargets(const int32 Animat
 		return false;
 	}
 
-	if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }))
+	// no skeleton here, so tracks are only keyed by name
+	FglTFRuntimeBoneTracks BoneTracks;
+	FglTFRuntimeAnimationBoneMap BoneMap;
+	if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), BoneTracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }, BoneMap))
 	{
 		return false;
 	}
 
+	Tracks.Append(BoneTracks.ToTracksMap());
+
 	return true;
 }
 
@@ -2445,16 +2615,40 @@ UAnimSequence* FglTFRuntimeParser::LoadSkeletalAnimation(USkeletalMesh* Skeletal
 		return nullptr;
 	}
 
-	TMap<FString, FRawAnimSequenceTrack> Tracks;
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
+	USkeleton* Skeleton = SkeletalMesh->GetSkeleton();
+#else
+	USkeleton* Skeleton = SkeletalMesh->Skeleton;
+#endif
+	if (!Skeleton)
+	{
+		AddError("LoadSkeletalAnimation()", "SkeletalMesh has no Skeleton");
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> JsonAnimationObject = GetJsonObjectFromRootIndex("animations", AnimationIndex);
+	if (!JsonAnimationObject)
+	{
+		AddError("LoadSkeletalAnimation()", FString::Printf(TEXT("Unable to find animation %d"), AnimationIndex));
+		return nullptr;
+	}
+
+	// tracks are directly keyed by the bone indices of the skeleton
+	FglTFRuntimeBoneTracks Tracks;
+	FglTFRuntimeAnimationBoneMap BoneMap(&Skeleton->GetReferenceSkeleton());
 	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
 	float Duration = 0;
 
-	if (!LoadAnimationAsTracksAndMorphTargets(AnimationIndex, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig))
+	if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }, BoneMap))
 	{
 		return nullptr;
 	}
 
-	UAnimSequence* AnimSequence = LoadSkeletalAnimationFromTracksAndMorphTargets(SkeletalMesh, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+	UAnimSequence* AnimSequence = LoadSkeletalAnimationFromBoneTracks(Skeleton, Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig);
+	if (AnimSequence)
+	{
+		AnimSequence->SetPreviewMesh(SkeletalMesh);
+	}
 
 	FillAssetUserData(AnimationIndex, AnimSequence);
 
@@ -2468,8 +2662,19 @@ UAnimSequence* FglTFRuntimeParser::LoadAndMergeSkeletalAnimations(USkeletalMesh*
 		return nullptr;
 	}
 
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
+	USkeleton* Skeleton = SkeletalMesh->GetSkeleton();
+#else
+	USkeleton* Skeleton = SkeletalMesh->Skeleton;
+#endif
+	if (!Skeleton)
+	{
+		AddError("LoadAndMergeSkeletalAnimations()", "SkeletalMesh has no Skeleton");
+		return nullptr;
+	}
+
 	float MergedDuration = 0;
-	TMap<FString, FRawAnimSequenceTrack> MergedTracks;
+	FglTFRuntimeBoneTracks MergedTracks;
 	TMap<FName, TArray<TPair<float, float>>> MergedMorphTargetCurves;
 
 	TArray<int32> ReorganizedAnimationIndices = AnimationIndices;
@@ -2484,38 +2689,32 @@ UAnimSequence* FglTFRuntimeParser::LoadAndMergeSkeletalAnimations(USkeletalMesh*
 		}
 	}
 
-	for (const int32 AnimationIndex : ReorganizedAnimationIndices)
+	// clips are decoded in parallel, merging is done in order
+	TArray<FglTFRuntimeSkeletalAnimationClip> Clips;
+	if (!LoadSkeletalAnimationClips(Skeleton->GetReferenceSkeleton(), ReorganizedAnimationIndices, SkeletalAnimationConfig, Clips))
 	{
-		TSharedPtr<FJsonObject> JsonAnimationObject = GetJsonObjectFromRootIndex("animations", AnimationIndex);
-		if (!JsonAnimationObject)
-		{
-			AddError("LoadAndMergeSkeletalAnimations()", FString::Printf(TEXT("Unable to find animation %d"), AnimationIndex));
-			return nullptr;
-		}
-
-		float Duration;
-		TMap<FString, FRawAnimSequenceTrack> Tracks;
+		return nullptr;
+	}
 
-		TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
-		if (!LoadSkeletalAnimation_Internal(JsonAnimationObject.ToSharedRef(), Tracks, MorphTargetCurves, Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }))
+	for (const FglTFRuntimeSkeletalAnimationClip& Clip : Clips)
+	{
+		if (!Clip.bValid)
 		{
 			return nullptr;
 		}
 
+		const float Duration = Clip.Duration;
+		const FglTFRuntimeBoneTracks& Tracks = Clip.Tracks;
+		const TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves = Clip.MorphTargetCurves;
+
 		// combine Tracks (just appending)
-		for (const TPair<FString, FRawAnimSequenceTrack>& Track : Tracks)
+		for (int32 TrackIndex = 0; TrackIndex < Tracks.Num(); TrackIndex++)
 		{
-			if (MergedTracks.Contains(Track.Key))
-			{
-				// append new data
-				MergedTracks[Track.Key].PosKeys.Append(Track.Value.PosKeys);
-				MergedTracks[Track.Key].RotKeys.Append(Track.Value.RotKeys);
-				MergedTracks[Track.Key].ScaleKeys.Append(Track.Value.ScaleKeys);
-			}
-			else
-			{
-				MergedTracks.Add(Track.Key, Track.Value);
-			}
+			const FRawAnimSequenceTrack& Track = Tracks.Tracks[TrackIndex];
+			FRawAnimSequenceTrack& MergedTrack = MergedTracks.Tracks[MergedTracks.FindOrAdd(Tracks.BoneIndices[TrackIndex], Tracks.Names[TrackIndex])];
+			MergedTrack.PosKeys.Append(Track.PosKeys);
+			MergedTrack.RotKeys.Append(Track.RotKeys);
+			MergedTrack.ScaleKeys.Append(Track.ScaleKeys);
 		}
 
 		// combine MorphTargets (needs time recomputing)
@@ -2537,7 +2736,253 @@ UAnimSequence* FglTFRuntimeParser::LoadAndMergeSkeletalAnimations(USkeletalMesh*
 		MergedDuration += Duration;
 	}
 
-	return LoadSkeletalAnimationFromTracksAndMorphTargets(SkeletalMesh, MergedTracks, MergedMorphTargetCurves, MergedDuration, SkeletalAnimationConfig);
+	UAnimSequence* AnimSequence = LoadSkeletalAnimationFromBoneTracks(Skeleton, MergedTracks, MergedMorphTargetCurves, MergedDuration, SkeletalAnimationConfig);
+	if (AnimSequence)
+	{
+		AnimSequence->SetPreviewMesh(SkeletalMesh);
+	}
+	return AnimSequence;
+}
+
+bool FglTFRuntimeParser::LoadSkeletalAnimationClips(const FReferenceSkeleton& RefSkeleton, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TArray<FglTFRuntimeSkeletalAnimationClip>& Clips)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadSkeletalAnimationClips, FColor::Magenta);
+
+	if (!bAllNodesCached && !LoadNodes())
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* JsonAnimations;
+	if (!Root->TryGetArrayField(TEXT("animations"), JsonAnimations))
+	{
+		AddError("LoadSkeletalAnimationClips()", "No animations defined in the asset");
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonObject>> JsonAnimationObjects;
+	Clips.Empty(AnimationIndices.Num());
+	for (const int32 AnimationIndex : AnimationIndices)
+	{
+		TSharedPtr<FJsonObject> JsonAnimationObject = JsonAnimations->IsValidIndex(AnimationIndex) ? (*JsonAnimations)[AnimationIndex]->AsObject() : nullptr;
+		if (!JsonAnimationObject)
+		{
+			AddError("LoadSkeletalAnimationClips()", FString::Printf(TEXT("Unable to find animation %d"), AnimationIndex));
+			return false;
+		}
+
+		JsonAnimationObjects.Add(JsonAnimationObject);
+		FglTFRuntimeSkeletalAnimationClip& Clip = Clips.AddDefaulted_GetRef();
+		Clip.AnimationIndex = AnimationIndex;
+	}
+
+	// resolve all of the nodes upfront, so that the workers only read the bone map
+	FglTFRuntimeAnimationBoneMap BoneMap(&RefSkeleton);
+	bool bBoneMapReadOnly = true;
+	if (SkeletalAnimationConfig.OverrideTrackNameFromExtension.Num() == 0 && !SkeletalAnimationConfig.CurveRemapper.Remapper.IsBound())
+	{
+		BoneMap.Init(FMath::Max(AllNodesCache.Num(), NodesDescs.Num()));
+		for (const FglTFRuntimeNode& Node : AllNodesCache)
+		{
+			FString TrackName;
+			int32 BoneIndex;
+			ResolveAnimationTrack(Node, "", SkeletalAnimationConfig, BoneMap, TrackName, BoneIndex);
+		}
+		// unresolved nodes would be written by the workers
+		bBoneMapReadOnly = BoneMap.NodeResolved.Num() > 0 && BoneMap.NodeResolved.Find(false) == INDEX_NONE;
+	}
+
+	// sampler inputs used more than once (mocap clips generally share the same timeline) are decoded only once
+	TMap<int64, TSharedPtr<FJsonObject>> InputSamplers;
+	TArray<int64> SharedInputs;
+	for (const TSharedPtr<FJsonObject>& JsonAnimationObject : JsonAnimationObjects)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* JsonSamplers;
+		if (!JsonAnimationObject->TryGetArrayField(TEXT("samplers"), JsonSamplers))
+		{
+			continue;
+		}
+
+		for (const TSharedPtr<FJsonValue>& JsonSampler : *JsonSamplers)
+		{
+			TSharedPtr<FJsonObject> JsonSamplerObject = JsonSampler->AsObject();
+			int64 InputIndex;
+			if (!JsonSamplerObject || !JsonSamplerObject->TryGetNumberField(TEXT("input"), InputIndex))
+			{
+				continue;
+			}
+
+			if (InputSamplers.Contains(InputIndex))
+			{
+				SharedInputs.AddUnique(InputIndex);
+			}
+			else
+			{
+				InputSamplers.Add(InputIndex, JsonSamplerObject);
+			}
+		}
+	}
+
+	TArray<TArray<float>> SharedInputsTimelines;
+	SharedInputsTimelines.SetNum(SharedInputs.Num());
+	TArray<bool> SharedInputsValid;
+	SharedInputsValid.SetNumZeroed(SharedInputs.Num());
+
+	ParallelFor(SharedInputs.Num(), [&](const int32 SharedInputIndex)
+		{
+			SharedInputsValid[SharedInputIndex] = BuildFromAccessorField(InputSamplers[SharedInputs[SharedInputIndex]].ToSharedRef(), "input", SharedInputsTimelines[SharedInputIndex], { 5126 }, INDEX_NONE, false, nullptr);
+		});
+
+	TMap<int64, TArray<float>> SharedTimelines;
+	for (int32 SharedInputIndex = 0; SharedInputIndex < SharedInputs.Num(); SharedInputIndex++)
+	{
+		// invalid inputs are left to the per-sampler path (for reporting the error)
+		if (SharedInputsValid[SharedInputIndex])
+		{
+			SharedTimelines.Add(SharedInputs[SharedInputIndex], MoveTemp(SharedInputsTimelines[SharedInputIndex]));
+		}
+	}
+
+	// remappers could be blueprint functions, so in such a case clips are decoded sequentially on the game thread
+	const bool bHasRemappers = SkeletalAnimationConfig.CurveRemapper.Remapper.IsBound() ||
+		SkeletalAnimationConfig.FrameRotationRemapper.Remapper.IsBound() ||
+		SkeletalAnimationConfig.FrameTranslationRemapper.Remapper.IsBound() ||
+		SkeletalAnimationConfig.FrameMorphTargetWeightRemapper.Remapper.IsBound();
+
+	auto DecodeClips = [&]()
+		{
+			ParallelFor(Clips.Num(), [&](const int32 ClipIndex)
+				{
+					FglTFRuntimeSkeletalAnimationClip& Clip = Clips[ClipIndex];
+					Clip.bValid = LoadSkeletalAnimation_Internal(JsonAnimationObjects[ClipIndex].ToSharedRef(), Clip.Tracks, Clip.MorphTargetCurves, Clip.Duration, SkeletalAnimationConfig, [](const FglTFRuntimeNode& Node) -> bool { return true; }, BoneMap, &SharedTimelines);
+				}, bHasRemappers || !bBoneMapReadOnly);
+		};
+
+	if (bHasRemappers && !IsInGameThread())
+	{
+		FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady(DecodeClips, TStatId(), nullptr, ENamedThreads::GameThread);
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+	}
+	else
+	{
+		DecodeClips();
+	}
+
+	return true;
+}
+
+TArray<UAnimSequence*> FglTFRuntimeParser::CreateSkeletalAnimationsFromClips(USkeletalMesh* SkeletalMesh, TArray<FglTFRuntimeSkeletalAnimationClip>& Clips, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_CreateSkeletalAnimationsFromClips, FColor::Magenta);
+
+	TArray<UAnimSequence*> AnimSequences;
+
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
+	USkeleton* Skeleton = SkeletalMesh->GetSkeleton();
+#else
+	USkeleton* Skeleton = SkeletalMesh->Skeleton;
+#endif
+
+	for (FglTFRuntimeSkeletalAnimationClip& Clip : Clips)
+	{
+		UAnimSequence* AnimSequence = nullptr;
+		if (Clip.bValid && Skeleton)
+		{
+			AnimSequence = LoadSkeletalAnimationFromBoneTracks(Skeleton, Clip.Tracks, Clip.MorphTargetCurves, Clip.Duration, SkeletalAnimationConfig);
+			if (AnimSequence)
+			{
+				AnimSequence->SetPreviewMesh(SkeletalMesh);
+				FillAssetUserData(Clip.AnimationIndex, AnimSequence);
+			}
+		}
+		AnimSequences.Add(AnimSequence);
+	}
+
+	return AnimSequences;
+}
+
+TArray<UAnimSequence*> FglTFRuntimeParser::LoadSkeletalAnimations(USkeletalMesh* SkeletalMesh, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	TArray<UAnimSequence*> AnimSequences;
+
+	if (!SkeletalMesh)
+	{
+		return AnimSequences;
+	}
+
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
+	USkeleton* Skeleton = SkeletalMesh->GetSkeleton();
+#else
+	USkeleton* Skeleton = SkeletalMesh->Skeleton;
+#endif
+	if (!Skeleton)
+	{
+		AddError("LoadSkeletalAnimations()", "SkeletalMesh has no Skeleton");
+		return AnimSequences;
+	}
+
+	TArray<int32> SelectedAnimationIndices = AnimationIndices;
+	if (SelectedAnimationIndices.Num() == 0)
+	{
+		for (int32 AnimationIndex = 0; AnimationIndex < GetNumAnimations(); AnimationIndex++)
+		{
+			SelectedAnimationIndices.Add(AnimationIndex);
+		}
+	}
+
+	TArray<FglTFRuntimeSkeletalAnimationClip> Clips;
+	if (!LoadSkeletalAnimationClips(Skeleton->GetReferenceSkeleton(), SelectedAnimationIndices, SkeletalAnimationConfig, Clips))
+	{
+		return AnimSequences;
+	}
+
+	return CreateSkeletalAnimationsFromClips(SkeletalMesh, Clips, SkeletalAnimationConfig);
+}
+
+void FglTFRuntimeParser::LoadSkeletalAnimationsAsync(USkeletalMesh* SkeletalMesh, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationsAsync& AsyncCallback, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
+	USkeleton* Skeleton = SkeletalMesh ? SkeletalMesh->GetSkeleton() : nullptr;
+#else
+	USkeleton* Skeleton = SkeletalMesh ? SkeletalMesh->Skeleton : nullptr;
+#endif
+	if (!Skeleton)
+	{
+		AddError("LoadSkeletalAnimationsAsync()", "Invalid SkeletalMesh or Skeleton");
+		AsyncCallback.ExecuteIfBound(TArray<UAnimSequence*>());
+		return;
+	}
+
+	TArray<int32> SelectedAnimationIndices = AnimationIndices;
+	if (SelectedAnimationIndices.Num() == 0)
+	{
+		for (int32 AnimationIndex = 0; AnimationIndex < GetNumAnimations(); AnimationIndex++)
+		{
+			SelectedAnimationIndices.Add(AnimationIndex);
+		}
+	}
+
+	// the workers only access a copy of the reference skeleton
+	TWeakObjectPtr<USkeletalMesh> WeakSkeletalMesh = SkeletalMesh;
+	FReferenceSkeleton RefSkeleton = Skeleton->GetReferenceSkeleton();
+
+	Async(EAsyncExecution::Thread, [this, WeakSkeletalMesh, RefSkeleton, SelectedAnimationIndices, AsyncCallback, SkeletalAnimationConfig]()
+		{
+			TArray<FglTFRuntimeSkeletalAnimationClip> Clips;
+			LoadSkeletalAnimationClips(RefSkeleton, SelectedAnimationIndices, SkeletalAnimationConfig, Clips);
+
+			// all of the UAnimSequences are created in a single game thread task
+			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&]()
+				{
+					TArray<UAnimSequence*> AnimSequences;
+					if (WeakSkeletalMesh.IsValid())
+					{
+						AnimSequences = CreateSkeletalAnimationsFromClips(WeakSkeletalMesh.Get(), Clips, SkeletalAnimationConfig);
+					}
+					AsyncCallback.ExecuteIfBound(AnimSequences);
+				}, TStatId(), nullptr, ENamedThreads::GameThread);
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+		});
 }
 
 UAnimSequence* FglTFRuntimeParser::CreateAnimationFromPose(USkeletalMesh* SkeletalMesh, const int32 SkinIndex, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
@@ -3239,7 +3684,61 @@ FglTFRuntimePoseTracksMap FglTFRuntimeParser::FixupAnimationTracks(const FglTFRu
 	return OutputTracks;
 }
 
-bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter)
+bool FglTFRuntimeParser::ResolveAnimationTrack(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, FglTFRuntimeAnimationBoneMap& BoneMap, FString& TrackName, int32& BoneIndex)
+{
+	// names coming from extensions or from a (path aware) remapper cannot be cached by node
+	const bool bCacheable = Node.Index > INDEX_NONE && SkeletalAnimationConfig.OverrideTrackNameFromExtension.Num() == 0 && !SkeletalAnimationConfig.CurveRemapper.Remapper.IsBound();
+	if (bCacheable && BoneMap.NodeResolved.Num() == 0)
+	{
+		BoneMap.Init(FMath::Max(Node.Index + 1, NodesDescs.Num()));
+	}
+
+	const bool bCached = bCacheable && Node.Index < BoneMap.NodeResolved.Num();
+	if (bCached && BoneMap.NodeResolved[Node.Index])
+	{
+		TrackName = BoneMap.NodeTrackNames[Node.Index];
+		BoneIndex = BoneMap.NodeBoneIndices[Node.Index];
+		return !BoneMap.NodeDiscarded[Node.Index];
+	}
+
+	TrackName = Node.Name;
+	BoneIndex = INDEX_NONE;
+
+	if (SkeletalAnimationConfig.CurvesNameMap.Contains(TrackName))
+	{
+		TrackName = SkeletalAnimationConfig.CurvesNameMap[TrackName];
+	}
+
+	bool bDiscarded = false;
+	if (SkeletalAnimationConfig.CurveRemapper.Remapper.IsBound())
+	{
+		TrackName = SkeletalAnimationConfig.CurveRemapper.Remapper.Execute(Node.Index, TrackName, Path, SkeletalAnimationConfig.CurveRemapper.Context);
+		// discard empty tracks
+		bDiscarded = TrackName.IsEmpty();
+	}
+
+	if (!bDiscarded && SkeletalAnimationConfig.RemoveTracks.Contains(TrackName))
+	{
+		bDiscarded = true;
+	}
+
+	if (!bDiscarded && BoneMap.RefSkeleton)
+	{
+		BoneIndex = BoneMap.RefSkeleton->FindBoneIndex(*TrackName);
+	}
+
+	if (bCached)
+	{
+		BoneMap.NodeTrackNames[Node.Index] = TrackName;
+		BoneMap.NodeBoneIndices[Node.Index] = BoneIndex;
+		BoneMap.NodeResolved[Node.Index] = true;
+		BoneMap.NodeDiscarded[Node.Index] = bDiscarded;
+	}
+
+	return !bDiscarded;
+}
+
+bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, FglTFRuntimeBoneTracks& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter, FglTFRuntimeAnimationBoneMap& BoneMap, const TMap<int64, TArray<float>>* SharedTimelines)
 {
 	TArray<FTransform> AnimWorldTransforms;
 	TArray<FTransform> RetargetWorldTransforms;
@@ -3407,30 +3906,22 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 			return FTransform(WorldRetargetMatrix * WorldRetargetParentPoseTransform.ToMatrixWithScale().Inverse());
 		};
 
+	const bool bRetarget = SkeletalAnimationConfig.RetargetTo || SkeletalAnimationConfig.RetargetToSkeletalMesh;
+
 	auto Callback = [&](const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)
 		{
-			FString TrackName = Node.Name;
-
-			if (SkeletalAnimationConfig.CurvesNameMap.Contains(TrackName))
-			{
-				TrackName = SkeletalAnimationConfig.CurvesNameMap[TrackName];
-			}
-
-			if (SkeletalAnimationConfig.CurveRemapper.Remapper.IsBound())
-			{
-				TrackName = SkeletalAnimationConfig.CurveRemapper.Remapper.Execute(Node.Index, TrackName, Path, SkeletalAnimationConfig.CurveRemapper.Context);
-				// discard empty tracks
-				if (TrackName.IsEmpty())
-				{
-					return;
-				}
-			}
-
-			if (SkeletalAnimationConfig.RemoveTracks.Contains(TrackName))
+			FString TrackName;
+			int32 BoneIndex;
+			if (!ResolveAnimationTrack(Node, Path, SkeletalAnimationConfig, BoneMap, TrackName, BoneIndex))
 			{
 				return;
 			}
 
+			// lookups are done once per channel (not once per frame)
+			const int32 RetargetBoneIndex = bRetarget ? RetargetRefSkeleton.FindBoneIndex(*TrackName) : INDEX_NONE;
+			const int32 AnimBoneIndex = AnimWorldTransforms.Num() > 0 ? AnimRefSkeleton.FindBoneIndex(*Node.Name) : INDEX_NONE;
+			const FTransform* TransformPose = SkeletalAnimationConfig.TransformPose.Find(TrackName);
+
 			int32 NumFrames = FMath::Max<int32>(Duration * SkeletalAnimationConfig.FramesPerSecond, 1);
 
 			float FrameDelta = 1.f / SkeletalAnimationConfig.FramesPerSecond;
@@ -3443,12 +3934,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 					return;
 				}
 
-				if (!Tracks.Contains(TrackName))
-				{
-					Tracks.Add(TrackName, FRawAnimSequenceTrack());
-				}
-
-				FRawAnimSequenceTrack& Track = Tracks[TrackName];
+				FRawAnimSequenceTrack& Track = Tracks.Tracks[Tracks.FindOrAdd(BoneIndex, TrackName)];
 
 				const int32 RotKeysFirstIndex = Track.RotKeys.Num();
 
@@ -3493,15 +3979,13 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 							AnimQuat = FQuat::Slerp(FirstQuat, SecondQuat, Alpha);
 						}
 
-						if (SkeletalAnimationConfig.RetargetTo || SkeletalAnimationConfig.RetargetToSkeletalMesh)
+						if (bRetarget)
 						{
-							const int32 RetargetBoneIndex = RetargetRefSkeleton.FindBoneIndex(*TrackName);
 							if (RetargetBoneIndex > INDEX_NONE)
 							{
 								const int32 RetargetParentBoneIndex = RetargetRefSkeleton.GetParentIndex(RetargetBoneIndex);
 								if (AnimWorldTransforms.Num() > 0)
 								{
-									const int32 AnimBoneIndex = AnimRefSkeleton.FindBoneIndex(*Node.Name);
 									if (AnimBoneIndex > INDEX_NONE)
 									{
 										const int32 AnimParentBoneIndex = AnimRefSkeleton.GetParentIndex(AnimBoneIndex);
@@ -3526,9 +4010,9 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 							}
 						}
 
-						if (SkeletalAnimationConfig.TransformPose.Contains(TrackName))
+						if (TransformPose)
 						{
-							AnimQuat = SkeletalAnimationConfig.TransformPose[TrackName].TransformRotation(AnimQuat);
+							AnimQuat = TransformPose->TransformRotation(AnimQuat);
 						}
 
 #if ENGINE_MAJOR_VERSION > 4
@@ -3559,12 +4043,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 					return;
 				}
 
-				if (!Tracks.Contains(TrackName))
-				{
-					Tracks.Add(TrackName, FRawAnimSequenceTrack());
-				}
-
-				FRawAnimSequenceTrack& Track = Tracks[TrackName];
+				FRawAnimSequenceTrack& Track = Tracks.Tracks[Tracks.FindOrAdd(BoneIndex, TrackName)];
 
 				const int32 PosKeysFirstIndex = Track.PosKeys.Num();
 
@@ -3592,16 +4071,14 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 							AnimLocation = SceneBasis.TransformPosition(FMath::Lerp(First, Second, Alpha)) * SceneScale;
 						}
 
-						if (SkeletalAnimationConfig.RetargetTo || SkeletalAnimationConfig.RetargetToSkeletalMesh)
+						if (bRetarget)
 						{
-							const int32 RetargetBoneIndex = RetargetRefSkeleton.FindBoneIndex(*TrackName);
 							if (RetargetBoneIndex > INDEX_NONE)
 							{
 								const int32 RetargetParentBoneIndex = RetargetRefSkeleton.GetParentIndex(RetargetBoneIndex);
 
 								if (AnimWorldTransforms.Num() > 0)
 								{
-									const int32 AnimBoneIndex = AnimRefSkeleton.FindBoneIndex(*Node.Name);
 									if (AnimBoneIndex > INDEX_NONE)
 									{
 										const int32 AnimParentBoneIndex = AnimRefSkeleton.GetParentIndex(AnimBoneIndex);
@@ -3632,9 +4109,9 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 							}
 						}
 
-						if (SkeletalAnimationConfig.TransformPose.Contains(TrackName))
+						if (TransformPose)
 						{
-							AnimLocation = SkeletalAnimationConfig.TransformPose[TrackName].TransformPosition(AnimLocation);
+							AnimLocation = TransformPose->TransformPosition(AnimLocation);
 						}
 
 #if ENGINE_MAJOR_VERSION > 4
@@ -3664,12 +4141,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 					return;
 				}
 
-				if (!Tracks.Contains(TrackName))
-				{
-					Tracks.Add(TrackName, FRawAnimSequenceTrack());
-				}
-
-				FRawAnimSequenceTrack& Track = Tracks[TrackName];
+				FRawAnimSequenceTrack& Track = Tracks.Tracks[Tracks.FindOrAdd(BoneIndex, TrackName)];
 
 				const int32 ScaleKeysFirstIndex = Track.ScaleKeys.Num();
 
@@ -3735,7 +4207,7 @@ bool FglTFRuntimeParser::LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject>
 		};
 
 	FString IgnoredName;
-	return LoadAnimation_Internal(JsonAnimationObject, Duration, IgnoredName, Callback, Filter, SkeletalAnimationConfig.OverrideTrackNameFromExtension);
+	return LoadAnimation_Internal(JsonAnimationObject, Duration, IgnoredName, Callback, Filter, SkeletalAnimationConfig.OverrideTrackNameFromExtension, SharedTimelines);
 }
 
 void FglTFRuntimeParser::LoadSkinnedMeshRecursiveAsRuntimeLODAsync(const FString& NodeName, int32& SkinIndex, const TArray<FString>& ExcludeNodes, const FglTFRuntimeMeshLODAsync& AsyncCallback, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const FglTFRuntimeSkeletonConfig& SkeletonConfig, const EglTFRuntimeRecursiveMode TransformApplyRecursiveMode)
@@ -4207,54 +4679,92 @@ const FBox& FglTFRuntimeSkeletalMeshContext::GetBoneBox(const int32 BoneIndex)
 {
 	// unfortunately we need access to SkinWeightVertexBuffer.GetBoneIndex (and it is not available in 4.25)
 #if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
-	if (PerBoneBoundingBoxCache.Contains(BoneIndex))
+	// the boxes of all of the bones are computed at the first request
+	if (PerBoneBoundingBoxCache.Num() == 0)
 	{
-		return PerBoneBoundingBoxCache[BoneIndex];
+		BuildBoneBoxes();
 	}
 
+	if (const FBox* CachedBox = PerBoneBoundingBoxCache.Find(BoneIndex))
+	{
+		return *CachedBox;
+	}
+#endif
+	// dummy logic
 	FBox& Box = PerBoneBoundingBoxCache.Add(BoneIndex);
 	Box.Init();
+	return Box;
+}
+
+void FglTFRuntimeSkeletalMeshContext::BuildBoneBoxes()
+{
+#if ENGINE_MAJOR_VERSION >= 5 || ENGINE_MINOR_VERSION >= 26
+	SCOPED_NAMED_EVENT(FglTFRuntimeSkeletalMeshContext_BuildBoneBoxes, FColor::Magenta);
+
+	const int32 NumBones = GetNumBones();
+	if (NumBones <= 0)
+	{
+		return;
+	}
 
 	const FSkeletalMeshLODRenderData& LOD0 = SkeletalMesh->GetResourceForRendering()->LODRenderData[0];
 	const uint32 NumVertices = LOD0.GetNumVertices();
-	for (uint32 Index = 0; Index < NumVertices; Index++)
-	{
-		const uint32 VertexIndex = LOD0.MultiSizeIndexContainer.GetIndexBuffer()->Get(Index);
+	const uint32 MaxBoneInfluences = LOD0.SkinWeightVertexBuffer.GetMaxBoneInfluences();
+	const auto& RefBasesInvMatrix = SkeletalMesh->GetRefBasesInvMatrix();
 
-		const uint32 MaxBoneInfluences = LOD0.SkinWeightVertexBuffer.GetMaxBoneInfluences();
+	// every vertex is assigned to its most influent bone, each chunk accumulates its own boxes (merged later)
+	constexpr uint32 ChunkSize = 16384;
+	const int32 NumChunks = static_cast<int32>(FMath::DivideAndRoundUp(NumVertices, ChunkSize));
 
-		int32 BestBoneIndex = INDEX_NONE;
-		uint16 BestWeight = 0;
-		for (uint32 InfluenceIndex = 0; InfluenceIndex < MaxBoneInfluences; InfluenceIndex++)
+	TArray<FBox> ChunksBoxes;
+	ChunksBoxes.AddUninitialized(NumChunks * NumBones);
+
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex)
 		{
-			const uint32 VertexBoneIndex = LOD0.SkinWeightVertexBuffer.GetBoneIndex(VertexIndex, InfluenceIndex);
-			const uint16 VertexBoneWeight = LOD0.SkinWeightVertexBuffer.GetBoneWeight(VertexIndex, InfluenceIndex);
-			if (VertexBoneWeight > BestWeight)
+			FBox* Boxes = ChunksBoxes.GetData() + ChunkIndex * NumBones;
+			for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
 			{
-				BestBoneIndex = VertexBoneIndex;
-				BestWeight = VertexBoneWeight;
+				Boxes[BoneIndex].Init();
 			}
-		}
 
-		if (BestBoneIndex == BoneIndex)
+			const uint32 FirstVertex = ChunkIndex * ChunkSize;
+			const uint32 LastVertex = FMath::Min(FirstVertex + ChunkSize, NumVertices);
+			for (uint32 VertexIndex = FirstVertex; VertexIndex < LastVertex; VertexIndex++)
+			{
+				int32 BestBoneIndex = INDEX_NONE;
+				uint16 BestWeight = 0;
+				for (uint32 InfluenceIndex = 0; InfluenceIndex < MaxBoneInfluences; InfluenceIndex++)
+				{
+					const uint16 VertexBoneWeight = LOD0.SkinWeightVertexBuffer.GetBoneWeight(VertexIndex, InfluenceIndex);
+					if (VertexBoneWeight > BestWeight)
+					{
+						BestBoneIndex = LOD0.SkinWeightVertexBuffer.GetBoneIndex(VertexIndex, InfluenceIndex);
+						BestWeight = VertexBoneWeight;
+					}
+				}
+
+				if (BestBoneIndex >= 0 && BestBoneIndex < NumBones)
+				{
+					Boxes[BestBoneIndex] += FVector(RefBasesInvMatrix[BestBoneIndex].TransformPosition(LOD0.StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex)));
+				}
+			}
+		});
+
+	PerBoneBoundingBoxCache.Reserve(NumBones);
+	for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		FBox& Box = PerBoneBoundingBoxCache.Add(BoneIndex);
+		Box.Init();
+		for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
 		{
-			Box += FVector(SkeletalMesh->GetRefBasesInvMatrix()[BoneIndex].TransformPosition(LOD0.StaticVertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex)));
+			Box += ChunksBoxes[ChunkIndex * NumBones + BoneIndex];
 		}
 	}
-
-	return PerBoneBoundingBoxCache[BoneIndex];
-#else
-	// dummy logic
-	FBox& Box = PerBoneBoundingBoxCache.Add(BoneIndex);
-	Box.Init();
-	return PerBoneBoundingBoxCache[BoneIndex];
 #endif
 }
 
 bool FglTFRuntimeParser::SanitizeBoneTrack(const FReferenceSkeleton& RefSkeleton, const FString& BoneName, const int32 NumFrames, FRawAnimSequenceTrack& Track, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
 {
-	const TArray<FTransform> BonesPoses = RefSkeleton.GetRefBonePose();
-
 	const int32 BoneIndex = RefSkeleton.FindBoneIndex(*BoneName);
 	if (BoneIndex == INDEX_NONE)
 	{
@@ -4262,7 +4772,12 @@ bool FglTFRuntimeParser::SanitizeBoneTrack(const FReferenceSkeleton& RefSkeleton
 		return true;
 	}
 
-	const FTransform BoneTransform = BonesPoses[BoneIndex];
+	return SanitizeBoneTrack(RefSkeleton, BoneIndex, NumFrames, Track, SkeletalAnimationConfig);
+}
+
+bool FglTFRuntimeParser::SanitizeBoneTrack(const FReferenceSkeleton& RefSkeleton, const int32 BoneIndex, const int32 NumFrames, FRawAnimSequenceTrack& Track, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig)
+{
+	const FTransform BoneTransform = RefSkeleton.GetRefBonePose()[BoneIndex];
 
 	// positions
 	if (Track.PosKeys.Num() == 0)
@@ -6,6 +6,7 @@
 #include "StaticMeshOperations.h"
 #include "Engine/StaticMeshSocket.h"
 #include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
 #if WITH_EDITOR
 #include "Editor/EditorEngine.h"
 #endif
@@ -22,12 +23,66 @@
 #endif
 #endif
 
+namespace glTFRuntime
+{
+	void FillStaticMeshLODResources(UStaticMesh* StaticMesh, FStaticMeshLODResources& LODResources, const TArray<FStaticMeshBuildVertex>& StaticMeshBuildVertices, const TArray<uint32>& LODIndices, const int32 NumUVs, const bool bHighPrecisionUVs, const bool bHighPrecisionTangentBasis, const bool bHasVertexColors)
+	{
+		const int64 PositionsSize = StaticMeshBuildVertices.Num() * sizeof(FStaticMeshBuildVertex);
+		// special (slower) logic for huge meshes (data size > 2GB)
+		if (PositionsSize > MAX_int32)
+		{
+#if ENGINE_MAJOR_VERSION >= 5
+			TArray<FVector3f> Positions;
+#else
+			TArray<FVector> Positions;
+#endif
+			Positions.AddUninitialized(StaticMeshBuildVertices.Num());
+			for (int32 BuildVertexIndex = 0; BuildVertexIndex < StaticMeshBuildVertices.Num(); BuildVertexIndex++)
+			{
+				Positions[BuildVertexIndex] = StaticMeshBuildVertices[BuildVertexIndex].Position;
+			}
+			LODResources.VertexBuffers.PositionVertexBuffer.Init(Positions, StaticMesh->bAllowCPUAccess);
+		}
+		else
+		{
+			LODResources.VertexBuffers.PositionVertexBuffer.Init(StaticMeshBuildVertices, StaticMesh->bAllowCPUAccess);
+		}
+
+		LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(bHighPrecisionUVs);
+		LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseHighPrecisionTangentBasis(bHighPrecisionTangentBasis);
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 3
+		LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(0, NumUVs, StaticMesh->bAllowCPUAccess);
+		LODResources.VertexBuffers.StaticMeshVertexBuffer.AppendVertices(StaticMeshBuildVertices.GetData(), StaticMeshBuildVertices.Num());
+#else
+		LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(StaticMeshBuildVertices, NumUVs, StaticMesh->bAllowCPUAccess);
+#endif
+
+		if (bHasVertexColors)
+		{
+			LODResources.VertexBuffers.ColorVertexBuffer.Init(StaticMeshBuildVertices, StaticMesh->bAllowCPUAccess);
+		}
+		LODResources.bHasColorVertexData = bHasVertexColors;
+		if (StaticMesh->bAllowCPUAccess)
+		{
+			LODResources.IndexBuffer = FRawStaticIndexBuffer(true);
+		}
+		LODResources.IndexBuffer.SetIndices(LODIndices, StaticMeshBuildVertices.Num() > MAX_uint16 ? EIndexBufferStride::Force32Bit : EIndexBufferStride::Force16Bit);
+
+		LODResources.BuffersSize = LODResources.IndexBuffer.GetAllocatedSize() +
+			LODResources.VertexBuffers.PositionVertexBuffer.GetStride() * LODResources.VertexBuffers.PositionVertexBuffer.GetNumVertices() +
+			LODResources.VertexBuffers.StaticMeshVertexBuffer.GetResourceSize() +
+			LODResources.VertexBuffers.ColorVertexBuffer.GetAllocatedSize();
+	}
+}
+
 FglTFRuntimeStaticMeshContext::FglTFRuntimeStaticMeshContext(TSharedRef<FglTFRuntimeParser> InParser, const int32 InMeshIndex, const FglTFRuntimeStaticMeshConfig& InStaticMeshConfig) :
 	Parser(InParser),
 	StaticMeshConfig(InStaticMeshConfig),
 	MeshIndex(InMeshIndex)
 {
-	StaticMesh = NewObject<UStaticMesh>(StaticMeshConfig.Outer ? StaticMeshConfig.Outer : GetTransientPackage(), NAME_None, RF_Public);
+	// shared meshes outlive the caller's component, so never parent them to it
+	UObject* StaticMeshOuter = (StaticMeshConfig.Outer && !InParser->CanShareStaticMesh(StaticMeshConfig)) ? StaticMeshConfig.Outer : GetTransientPackage();
+	StaticMesh = NewObject<UStaticMesh>(StaticMeshOuter, NAME_None, RF_Public);
 #if PLATFORM_ANDROID || PLATFORM_IOS
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
 	StaticMesh->bAllowCPUAccess = StaticMeshConfig.bAllowCPUAccess;
@@ -64,9 +119,19 @@ FglTFRuntimeStaticMeshContext::FglTFRuntimeStaticMeshContext(TSharedRef<FglTFRun
 void FglTFRuntimeParser::LoadStaticMeshAsync(const int32 MeshIndex, const FglTFRuntimeStaticMeshAsync& AsyncCallback, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
 {
 	// first check cache
-	if (CanReadFromCache(StaticMeshConfig.CacheMode) && StaticMeshesCache.Contains(MeshIndex))
+	UStaticMesh* CachedStaticMesh = nullptr;
+	if (CanReadFromCache(StaticMeshConfig.CacheMode))
+	{
+		FReadScopeLock Lock(ObjectsCacheLock);
+		if (StaticMeshesCache.Contains(MeshIndex))
+		{
+			CachedStaticMesh = StaticMeshesCache[MeshIndex];
+		}
+	}
+
+	if (CachedStaticMesh)
 	{
-		UStaticMesh* StaticMesh = StaticMeshesCache[MeshIndex];
+		UStaticMesh* StaticMesh = CachedStaticMesh;
 		FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([StaticMesh, AsyncCallback]()
 			{
 				AsyncCallback.ExecuteIfBound(StaticMesh);
@@ -78,29 +143,51 @@ void FglTFRuntimeParser::LoadStaticMeshAsync(const int32 MeshIndex, const FglTFR
 
 	Async(EAsyncExecution::Thread, [this, StaticMeshContext, MeshIndex, AsyncCallback]()
 		{
+			FString SharedAssetKey;
+			bool bSharedStaticMesh = false;
 			TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
-			if (JsonMeshObject)
+			if (JsonMeshObject && CanShareStaticMesh(StaticMeshContext->StaticMeshConfig))
 			{
-				FglTFRuntimeMeshLOD* LOD = nullptr;
-				if (LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshContext->StaticMeshConfig.MaterialsConfig))
+				SharedAssetKey = GetSharedStaticMeshKey(JsonMeshObject.ToSharedRef(), StaticMeshContext->StaticMeshConfig);
+				if (UStaticMesh* SharedStaticMesh = Cast<UStaticMesh>(FindSharedAsset(SharedAssetKey)))
 				{
-					StaticMeshContext->LODs.Add(LOD);
+					// the context keeps it referenced from now on
+					StaticMeshContext->StaticMesh = SharedStaticMesh;
+					bSharedStaticMesh = true;
+				}
+			}
 
-					StaticMeshContext->StaticMesh = LoadStaticMesh_Internal(StaticMeshContext);
+			if (JsonMeshObject && !bSharedStaticMesh)
+			{
+				if (!LoadStaticMeshFromDerivedDataCache(StaticMeshContext))
+				{
+					FglTFRuntimeMeshLOD* LOD = nullptr;
+					if (LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshContext->StaticMeshConfig.MaterialsConfig))
+					{
+						StaticMeshContext->LODs.Add(LOD);
+
+						StaticMeshContext->StaticMesh = LoadStaticMesh_Internal(StaticMeshContext);
+						if (StaticMeshContext->StaticMesh)
+						{
+							WriteStaticMeshToDerivedDataCache(StaticMeshContext);
+						}
+					}
 				}
 			}
 
-			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([MeshIndex, StaticMeshContext, AsyncCallback]()
+			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([MeshIndex, StaticMeshContext, AsyncCallback, SharedAssetKey, bSharedStaticMesh]()
 				{
-					if (StaticMeshContext->StaticMesh)
+					if (StaticMeshContext->StaticMesh && !bSharedStaticMesh)
 					{
 						StaticMeshContext->StaticMesh = StaticMeshContext->Parser->FinalizeStaticMesh(StaticMeshContext);
+						AddSharedAsset(SharedAssetKey, StaticMeshContext->StaticMesh);
 					}
 
 					if (StaticMeshContext->StaticMesh)
 					{
 						if (StaticMeshContext->Parser->CanWriteToCache(StaticMeshContext->StaticMeshConfig.CacheMode))
 						{
+							FWriteScopeLock Lock(StaticMeshContext->Parser->ObjectsCacheLock);
 							StaticMeshContext->Parser->StaticMeshesCache.Add(MeshIndex, StaticMeshContext->StaticMesh);
 						}
 					}
@@ -121,6 +208,11 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 
 	OnPreCreatedStaticMesh.Broadcast(StaticMeshContext);
 
+	if (StaticMeshContext->StaticMeshConfig.AutoLODsNum > 0)
+	{
+		GenerateStaticMeshAutoLODs(StaticMeshContext);
+	}
+
 	UStaticMesh* StaticMesh = StaticMeshContext->StaticMesh;
 	FStaticMeshRenderData* RenderData = StaticMeshContext->RenderData;
 	const FglTFRuntimeStaticMeshConfig& StaticMeshConfig = StaticMeshContext->StaticMeshConfig;
@@ -221,6 +313,24 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 			if (Primitive.bHasMaterial || !SectionMaterialMap.Contains(SectionIndex))
 			{
 				MaterialIndex = StaticMeshContext->StaticMaterials.Add(StaticMaterial);
+				if (StaticMeshContext->DerivedData.IsValid())
+				{
+					FglTFRuntimeStaticMeshDerivedDataMaterial& DerivedDataMaterial = StaticMeshContext->DerivedData->Materials.AddDefaulted_GetRef();
+					DerivedDataMaterial.SlotName = MaterialName.ToString();
+					DerivedDataMaterial.MaterialIndex = Primitive.MaterialIndex;
+					DerivedDataMaterial.bUseVertexColors = Primitive.Colors.Num() > 0;
+					if (Primitive.MaterialIndex == INDEX_NONE && Primitive.Material != UMaterial::GetDefaultMaterial(MD_Surface))
+					{
+						if (!Primitive.bHasMaterial && Primitive.Colors.Num() > 0)
+						{
+							DerivedDataMaterial.bVertexColorOnly = true;
+						}
+						else
+						{
+							StaticMeshContext->DerivedData->bCacheable = false;
+						}
+					}
+				}
 				if (!SectionMaterialMap.Contains(SectionIndex))
 				{
 					SectionMaterialMap.Add(SectionIndex, MaterialIndex);
@@ -733,52 +843,27 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 			}
 		}
 
-		const int64 PositionsSize = StaticMeshBuildVertices.Num() * sizeof(FStaticMeshBuildVertex);
-		// special (slower) logic for huge meshes (data size > 2GB)
-		if (PositionsSize > MAX_int32)
+		glTFRuntime::FillStaticMeshLODResources(StaticMesh, LODResources, StaticMeshBuildVertices, LODIndices, NumUVs, bHighPrecisionUVs || StaticMeshConfig.bUseHighPrecisionUVs, StaticMeshConfig.bUseHighPrecisionTangentBasis, bHasVertexColors);
+
+		if (StaticMeshContext->DerivedData.IsValid())
 		{
-#if ENGINE_MAJOR_VERSION >= 5
-			TArray<FVector3f> Positions;
-#else
-			TArray<FVector> Positions;
-#endif
-			Positions.AddUninitialized(StaticMeshBuildVertices.Num());
-			for (int32 BuildVertexIndex = 0; BuildVertexIndex < StaticMeshBuildVertices.Num(); BuildVertexIndex++)
+			FglTFRuntimeStaticMeshDerivedDataLOD& DerivedDataLOD = StaticMeshContext->DerivedData->LODs.AddDefaulted_GetRef();
+			DerivedDataLOD.VerticesNum = StaticMeshBuildVertices.Num();
+			DerivedDataLOD.Vertices.Append(reinterpret_cast<const uint8*>(StaticMeshBuildVertices.GetData()), static_cast<int64>(StaticMeshBuildVertices.Num()) * sizeof(FStaticMeshBuildVertex));
+			DerivedDataLOD.Indices = LODIndices;
+			for (const FStaticMeshSection& Section : Sections)
 			{
-				Positions[BuildVertexIndex] = StaticMeshBuildVertices[BuildVertexIndex].Position;
+				FglTFRuntimeStaticMeshDerivedDataSection& DerivedDataSection = DerivedDataLOD.Sections.AddDefaulted_GetRef();
+				DerivedDataSection.FirstIndex = Section.FirstIndex;
+				DerivedDataSection.NumTriangles = Section.NumTriangles;
+				DerivedDataSection.MaterialIndex = Section.MaterialIndex;
+				DerivedDataSection.bCastShadow = Section.bCastShadow;
 			}
-			LODResources.VertexBuffers.PositionVertexBuffer.Init(Positions, StaticMesh->bAllowCPUAccess);
-		}
-		else
-		{
-			LODResources.VertexBuffers.PositionVertexBuffer.Init(StaticMeshBuildVertices, StaticMesh->bAllowCPUAccess);
+			DerivedDataLOD.NumUVs = NumUVs;
+			DerivedDataLOD.bHighPrecisionUVs = bHighPrecisionUVs || StaticMeshConfig.bUseHighPrecisionUVs;
+			DerivedDataLOD.bHasVertexColors = bHasVertexColors;
 		}
 
-		LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(bHighPrecisionUVs || StaticMeshConfig.bUseHighPrecisionUVs);
-		LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseHighPrecisionTangentBasis(StaticMeshConfig.bUseHighPrecisionTangentBasis);
-#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 3
-		LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(0, NumUVs, StaticMesh->bAllowCPUAccess);
-		LODResources.VertexBuffers.StaticMeshVertexBuffer.AppendVertices(StaticMeshBuildVertices.GetData(), StaticMeshBuildVertices.Num());
-#else
-		LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(StaticMeshBuildVertices, NumUVs, StaticMesh->bAllowCPUAccess);
-#endif
-
-		if (bHasVertexColors)
-		{
-			LODResources.VertexBuffers.ColorVertexBuffer.Init(StaticMeshBuildVertices, StaticMesh->bAllowCPUAccess);
-		}
-		LODResources.bHasColorVertexData = bHasVertexColors;
-		if (StaticMesh->bAllowCPUAccess)
-		{
-			LODResources.IndexBuffer = FRawStaticIndexBuffer(true);
-		}
-		LODResources.IndexBuffer.SetIndices(LODIndices, StaticMeshBuildVertices.Num() > MAX_uint16 ? EIndexBufferStride::Force32Bit : EIndexBufferStride::Force16Bit);
-
-		LODResources.BuffersSize = LODResources.IndexBuffer.GetAllocatedSize() +
-			LODResources.VertexBuffers.PositionVertexBuffer.GetStride() * LODResources.VertexBuffers.PositionVertexBuffer.GetNumVertices() +
-			LODResources.VertexBuffers.StaticMeshVertexBuffer.GetResourceSize() +
-			LODResources.VertexBuffers.ColorVertexBuffer.GetAllocatedSize();
-
 #if WITH_EDITOR
 		if (StaticMeshConfig.bGenerateStaticMeshDescription)
 		{
@@ -922,11 +1007,119 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh_Internal(TSharedRef<FglTFRuntime
 		}
 	}
 
+	BuildStaticMeshConvexDecomposition(StaticMeshContext);
+
 	OnPostCreatedStaticMesh.Broadcast(StaticMeshContext);
 
 	return StaticMesh;
 }
 
+UStaticMesh* FglTFRuntimeParser::LoadStaticMeshFromDerivedData_Internal(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext, const FglTFRuntimeStaticMeshDerivedData& DerivedData)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadStaticMeshFromDerivedData_Internal, FColor::Magenta);
+
+	UStaticMesh* StaticMesh = StaticMeshContext->StaticMesh;
+	FStaticMeshRenderData* RenderData = StaticMeshContext->RenderData;
+	const FglTFRuntimeStaticMeshConfig& StaticMeshConfig = StaticMeshContext->StaticMeshConfig;
+
+	if (DerivedData.LODs.Num() < 1)
+	{
+		return nullptr;
+	}
+
+	// validate everything before touching the context (a corrupted cache must never reach the render data)
+	for (const FglTFRuntimeStaticMeshDerivedDataLOD& DerivedDataLOD : DerivedData.LODs)
+	{
+		if (DerivedDataLOD.VerticesNum < 0 || DerivedDataLOD.Vertices.Num() != static_cast<int64>(DerivedDataLOD.VerticesNum) * sizeof(FStaticMeshBuildVertex))
+		{
+			return nullptr;
+		}
+
+		for (const FglTFRuntimeStaticMeshDerivedDataSection& DerivedDataSection : DerivedDataLOD.Sections)
+		{
+			if (!DerivedData.Materials.IsValidIndex(DerivedDataSection.MaterialIndex) || static_cast<uint64>(DerivedDataSection.FirstIndex) + static_cast<uint64>(DerivedDataSection.NumTriangles) * 3 > static_cast<uint64>(DerivedDataLOD.Indices.Num()))
+			{
+				return nullptr;
+			}
+		}
+
+		for (const uint32 Index : DerivedDataLOD.Indices)
+		{
+			if (Index >= static_cast<uint32>(DerivedDataLOD.VerticesNum))
+			{
+				return nullptr;
+			}
+		}
+	}
+
+	TArray<FStaticMaterial> StaticMaterials;
+	for (const FglTFRuntimeStaticMeshDerivedDataMaterial& DerivedDataMaterial : DerivedData.Materials)
+	{
+		UMaterialInterface* Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		if (DerivedDataMaterial.MaterialIndex != INDEX_NONE)
+		{
+			FString MaterialName;
+			Material = LoadMaterial(DerivedDataMaterial.MaterialIndex, StaticMeshConfig.MaterialsConfig, DerivedDataMaterial.bUseVertexColors, MaterialName, nullptr);
+			if (!Material)
+			{
+				return nullptr;
+			}
+		}
+		else if (DerivedDataMaterial.bVertexColorOnly)
+		{
+			Material = BuildVertexColorOnlyMaterial(StaticMeshConfig.MaterialsConfig, false);
+		}
+
+		FStaticMaterial StaticMaterial(Material, FName(*DerivedDataMaterial.SlotName));
+		StaticMaterial.UVChannelData.bInitialized = true;
+		StaticMaterials.Add(StaticMaterial);
+	}
+
+	StaticMeshContext->StaticMaterials.Append(StaticMaterials);
+
+	RenderData->AllocateLODResources(DerivedData.LODs.Num());
+
+	for (int32 LODIndex = 0; LODIndex < DerivedData.LODs.Num(); LODIndex++)
+	{
+		const FglTFRuntimeStaticMeshDerivedDataLOD& DerivedDataLOD = DerivedData.LODs[LODIndex];
+		FStaticMeshLODResources& LODResources = RenderData->LODResources[LODIndex];
+
+		for (const FglTFRuntimeStaticMeshDerivedDataSection& DerivedDataSection : DerivedDataLOD.Sections)
+		{
+			FStaticMeshSection& Section = LODResources.Sections.AddDefaulted_GetRef();
+			Section.FirstIndex = DerivedDataSection.FirstIndex;
+			Section.NumTriangles = DerivedDataSection.NumTriangles;
+			Section.MaterialIndex = DerivedDataSection.MaterialIndex;
+			Section.bEnableCollision = true;
+			Section.bCastShadow = DerivedDataSection.bCastShadow;
+
+#if WITH_EDITOR
+			FMeshSectionInfoMap& SectionInfoMap = StaticMesh->GetSectionInfoMap();
+			FMeshSectionInfo MeshSectionInfo;
+			MeshSectionInfo.MaterialIndex = Section.MaterialIndex;
+			MeshSectionInfo.bCastShadow = Section.bCastShadow;
+			MeshSectionInfo.bEnableCollision = Section.bEnableCollision;
+			SectionInfoMap.Set(LODIndex, LODResources.Sections.Num() - 1, MeshSectionInfo);
+#endif
+		}
+
+		TArray<FStaticMeshBuildVertex> StaticMeshBuildVertices;
+		StaticMeshBuildVertices.AddUninitialized(DerivedDataLOD.VerticesNum);
+		FMemory::Memcpy(StaticMeshBuildVertices.GetData(), DerivedDataLOD.Vertices.GetData(), DerivedDataLOD.Vertices.Num());
+
+		glTFRuntime::FillStaticMeshLODResources(StaticMesh, LODResources, StaticMeshBuildVertices, DerivedDataLOD.Indices, DerivedDataLOD.NumUVs, DerivedDataLOD.bHighPrecisionUVs, StaticMeshConfig.bUseHighPrecisionTangentBasis, DerivedDataLOD.bHasVertexColors);
+	}
+
+	StaticMeshContext->BoundingBoxAndSphere = DerivedData.BoundingBoxAndSphere;
+	StaticMeshContext->LOD0PivotDelta = DerivedData.LOD0PivotDelta;
+	StaticMeshContext->LODScreenSize.Append(DerivedData.LODScreenSize);
+	StaticMeshContext->AdditionalSockets.Append(DerivedData.AdditionalSockets);
+
+	BuildStaticMeshConvexDecomposition(StaticMeshContext);
+
+	return StaticMesh;
+}
+
 UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext)
 {
 	SCOPED_NAMED_EVENT(FglTFRuntimeParser_FinalizeStaticMesh, FColor::Magenta);
@@ -965,6 +1158,15 @@ UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStati
 		ScreenSize -= DeltaScreenSize;
 	}
 
+	// apply LODs ScreenSize from generators
+	for (const TPair<int32, float>& Pair : StaticMeshContext->LODScreenSize)
+	{
+		if (Pair.Key >= 0 && Pair.Key < RenderData->LODResources.Num())
+		{
+			RenderData->ScreenSize[Pair.Key].Default = Pair.Value;
+		}
+	}
+
 	// Override LODs ScreenSize
 	for (const TPair<int32, float>& Pair : StaticMeshConfig.LODScreenSize)
 	{
@@ -990,7 +1192,8 @@ UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStati
 
 	BodySetup->bHasCookedCollisionData = false;
 
-	BodySetup->bNeverNeedsCookedCollisionData = !StaticMeshConfig.bBuildComplexCollision;
+	// convex elements need cooking too
+	BodySetup->bNeverNeedsCookedCollisionData = !StaticMeshConfig.bBuildComplexCollision && StaticMeshContext->ConvexHulls.Num() == 0;
 
 	BodySetup->bMeshCollideAll = false;
 
@@ -998,7 +1201,8 @@ UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStati
 
 	BodySetup->InvalidatePhysicsData();
 
-	if (StaticMeshConfig.bBuildSimpleCollision)
+	// the convex decomposition replaces the bounding box
+	if (StaticMeshConfig.bBuildSimpleCollision && StaticMeshContext->ConvexHulls.Num() == 0)
 	{
 		FKBoxElem BoxElem;
 		BoxElem.Center = RenderData->Bounds.Origin;
@@ -1027,19 +1231,70 @@ UStaticMesh* FglTFRuntimeParser::FinalizeStaticMesh(TSharedRef<FglTFRuntimeStati
 		BodySetup->AggGeom.SphereElems.Add(SphereElem);
 	}
 
-	if (StaticMeshConfig.bBuildComplexCollision || StaticMeshConfig.CollisionComplexity == ECollisionTraceFlag::CTF_UseComplexAsSimple)
+	for (const TArray<FVector>& ConvexHull : StaticMeshContext->ConvexHulls)
+	{
+		FKConvexElem ConvexElem;
+		ConvexElem.VertexData = ConvexHull;
+		ConvexElem.UpdateElemBox();
+		BodySetup->AggGeom.ConvexElems.Add(ConvexElem);
+	}
+
+	bool bAsyncPhysicsCooking = false;
+
+	const bool bBuildComplexCollision = StaticMeshConfig.bBuildComplexCollision || StaticMeshConfig.CollisionComplexity == ECollisionTraceFlag::CTF_UseComplexAsSimple;
+	if (bBuildComplexCollision || StaticMeshContext->ConvexHulls.Num() > 0)
 	{
-		if (!StaticMesh->bAllowCPUAccess || !StaticMeshConfig.Outer || !StaticMesh->GetWorld() || !StaticMesh->GetWorld()->IsGameWorld())
+		if (bBuildComplexCollision && (!StaticMesh->bAllowCPUAccess || !StaticMeshConfig.Outer || !StaticMesh->GetWorld() || !StaticMesh->GetWorld()->IsGameWorld()))
 		{
 			AddError("FinalizeStaticMesh", "Unable to generate Complex collision without CpuAccess and a valid StaticMesh Outer (consider setting it to the related StaticMeshComponent)");
 		}
-		BodySetup->CreatePhysicsMeshes();
+
+		if (StaticMeshConfig.bAsyncPhysicsCooking)
+		{
+			bAsyncPhysicsCooking = true;
+			TWeakObjectPtr<UStaticMesh> WeakStaticMesh = StaticMesh;
+			if (!Cast<UActorComponent>(StaticMesh->GetOuter()))
+			{
+				AddSharedStaticMeshCooking(StaticMesh);
+			}
+			// the cooked data is attached on the game thread, recreate the physics state only after that
+			BodySetup->CreatePhysicsMeshesAsync(FOnAsyncPhysicsCookFinished::CreateLambda([WeakStaticMesh](bool bSuccess)
+				{
+					if (!WeakStaticMesh.IsValid())
+					{
+						return;
+					}
+
+					if (UActorComponent* ActorComponent = Cast<UActorComponent>(WeakStaticMesh->GetOuter()))
+					{
+						ActorComponent->RecreatePhysicsState();
+					}
+					else
+					{
+						// shared meshes are not owned by a component, refresh the registered users
+						for (const TWeakObjectPtr<UStaticMeshComponent>& StaticMeshComponent : PopSharedStaticMeshCookingComponents(WeakStaticMesh.Get()))
+						{
+							if (StaticMeshComponent.IsValid() && StaticMeshComponent->GetStaticMesh() == WeakStaticMesh.Get())
+							{
+								StaticMeshComponent->RecreatePhysicsState();
+							}
+						}
+					}
+				}));
+		}
+		else
+		{
+			BodySetup->CreatePhysicsMeshes();
+		}
 	}
 
 	// recreate physics state (if possible)
-	if (UActorComponent* ActorComponent = Cast<UActorComponent>(StaticMesh->GetOuter()))
+	if (!bAsyncPhysicsCooking)
 	{
-		ActorComponent->RecreatePhysicsState();
+		if (UActorComponent* ActorComponent = Cast<UActorComponent>(StaticMesh->GetOuter()))
+		{
+			ActorComponent->RecreatePhysicsState();
+		}
 	}
 
 	for (const TPair<FString, FTransform>& Pair : StaticMeshConfig.Sockets)
@@ -1115,23 +1370,37 @@ bool FglTFRuntimeParser::LoadStaticMeshes(TArray<UStaticMesh*>& StaticMeshes, co
 
 bool FglTFRuntimeParser::LoadMeshIntoMeshLOD(TSharedRef<FJsonObject> JsonMeshObject, FglTFRuntimeMeshLOD*& LOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig)
 {
-	if (LODsCache.Contains(JsonMeshObject))
+	const TPair<TSharedRef<FJsonObject>, FString> CacheKey(JsonMeshObject, GetMaterialsConfigKey(MaterialsConfig));
+
 	{
-		LOD = &LODsCache[JsonMeshObject];
-		return true;
+		FReadScopeLock Lock(LODsCacheLock);
+		if (const TSharedPtr<FglTFRuntimeMeshLOD>* CachedLOD = LODsCache.Find(CacheKey))
+		{
+			LOD = CachedLOD->Get();
+			return true;
+		}
 	}
 
+	// primitives are loaded without holding the lock (materials could require the game thread)
 	TArray<FglTFRuntimePrimitive> Primitives;
 	if (!LoadPrimitives(JsonMeshObject, Primitives, MaterialsConfig, true))
 	{
 		return false;
 	}
 
-	FglTFRuntimeMeshLOD NewLOD;
-	NewLOD.Primitives = MoveTemp(Primitives);
+	FWriteScopeLock Lock(LODsCacheLock);
+	// another thread could have loaded the same mesh in the meantime, the first one wins
+	if (const TSharedPtr<FglTFRuntimeMeshLOD>* CachedLOD = LODsCache.Find(CacheKey))
+	{
+		LOD = CachedLOD->Get();
+		return true;
+	}
+
+	TSharedPtr<FglTFRuntimeMeshLOD> NewLOD = MakeShared<FglTFRuntimeMeshLOD>();
+	NewLOD->Primitives = MoveTemp(Primitives);
 
-	FglTFRuntimeMeshLOD& CachedLOD = LODsCache.Add(JsonMeshObject, MoveTemp(NewLOD));
-	LOD = &CachedLOD;
+	LODsCache.Add(CacheKey, NewLOD);
+	LOD = NewLOD.Get();
 	return true;
 }
 
@@ -1144,23 +1413,49 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh(const int32 MeshIndex, const Fgl
 		return nullptr;
 	}
 
-	if (CanReadFromCache(StaticMeshConfig.CacheMode) && StaticMeshesCache.Contains(MeshIndex))
+	if (CanReadFromCache(StaticMeshConfig.CacheMode))
 	{
-		return StaticMeshesCache[MeshIndex];
+		FReadScopeLock Lock(ObjectsCacheLock);
+		if (StaticMeshesCache.Contains(MeshIndex))
+		{
+			return StaticMeshesCache[MeshIndex];
+		}
 	}
 
-	TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext = MakeShared<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe>(AsShared(), MeshIndex, StaticMeshConfig);
-	FglTFRuntimeMeshLOD* LOD = nullptr;
-	if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+	FString SharedAssetKey;
+	if (CanShareStaticMesh(StaticMeshConfig))
 	{
-		return nullptr;
+		SharedAssetKey = GetSharedStaticMeshKey(JsonMeshObject.ToSharedRef(), StaticMeshConfig);
+		if (UStaticMesh* SharedStaticMesh = Cast<UStaticMesh>(FindSharedAsset(SharedAssetKey)))
+		{
+			if (CanWriteToCache(StaticMeshConfig.CacheMode))
+			{
+				FWriteScopeLock Lock(ObjectsCacheLock);
+				StaticMeshesCache.Add(MeshIndex, SharedStaticMesh);
+			}
+			return SharedStaticMesh;
+		}
 	}
-	StaticMeshContext->LODs.Add(LOD);
 
-	UStaticMesh* StaticMesh = LoadStaticMesh_Internal(StaticMeshContext);
+	TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext = MakeShared<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe>(AsShared(), MeshIndex, StaticMeshConfig);
+
+	UStaticMesh* StaticMesh = LoadStaticMeshFromDerivedDataCache(StaticMeshContext);
 	if (!StaticMesh)
 	{
-		return nullptr;
+		FglTFRuntimeMeshLOD* LOD = nullptr;
+		if (!LoadMeshIntoMeshLOD(JsonMeshObject.ToSharedRef(), LOD, StaticMeshConfig.MaterialsConfig))
+		{
+			return nullptr;
+		}
+		StaticMeshContext->LODs.Add(LOD);
+
+		StaticMesh = LoadStaticMesh_Internal(StaticMeshContext);
+		if (!StaticMesh)
+		{
+			return nullptr;
+		}
+
+		WriteStaticMeshToDerivedDataCache(StaticMeshContext);
 	}
 
 	StaticMesh = FinalizeStaticMesh(StaticMeshContext);
@@ -1171,9 +1466,12 @@ UStaticMesh* FglTFRuntimeParser::LoadStaticMesh(const int32 MeshIndex, const Fgl
 
 	if (CanWriteToCache(StaticMeshConfig.CacheMode))
 	{
+		FWriteScopeLock Lock(ObjectsCacheLock);
 		StaticMeshesCache.Add(MeshIndex, StaticMesh);
 	}
 
+	AddSharedAsset(SharedAssetKey, StaticMesh);
+
 	return StaticMesh;
 }
 
@@ -1307,6 +1605,57 @@ bool FglTFRuntimeParser::LoadStaticMeshIntoProceduralMeshComponent(const int32 M
 		return false;
 	}
 
+	TArray<FProcMeshSection> Sections;
+	TArray<UMaterialInterface*> SectionsMaterials;
+	if (!LoadMeshIntoProceduralMeshSections(MeshIndex, Sections, SectionsMaterials, ProceduralMeshConfig))
+	{
+		return false;
+	}
+
+	CommitProceduralMeshSections(ProceduralMeshComponent, Sections, SectionsMaterials, ProceduralMeshConfig);
+
+	return true;
+}
+
+void FglTFRuntimeParser::LoadStaticMeshIntoProceduralMeshComponentAsync(const int32 MeshIndex, UProceduralMeshComponent* ProceduralMeshComponent, const FglTFRuntimeProceduralMeshComponentAsync& AsyncCallback, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig)
+{
+	if (!ProceduralMeshComponent)
+	{
+		AsyncCallback.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	TWeakObjectPtr<UProceduralMeshComponent> WeakProceduralMeshComponent = ProceduralMeshComponent;
+	// the parser must survive until the sections are committed
+	TSharedRef<FglTFRuntimeParser> Parser = AsShared();
+
+	Async(EAsyncExecution::Thread, [Parser, MeshIndex, WeakProceduralMeshComponent, AsyncCallback, ProceduralMeshConfig]()
+		{
+			TArray<FProcMeshSection> Sections;
+			TArray<UMaterialInterface*> SectionsMaterials;
+			const bool bSuccess = Parser->LoadMeshIntoProceduralMeshSections(MeshIndex, Sections, SectionsMaterials, ProceduralMeshConfig);
+
+			// the worker waits for the task, so the sections can be safely referenced
+			FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([Parser, bSuccess, &Sections, &SectionsMaterials, WeakProceduralMeshComponent, AsyncCallback, ProceduralMeshConfig]()
+				{
+					UProceduralMeshComponent* ProceduralMeshComponent = WeakProceduralMeshComponent.Get();
+					if (!bSuccess || !ProceduralMeshComponent)
+					{
+						AsyncCallback.ExecuteIfBound(nullptr);
+						return;
+					}
+
+					Parser->CommitProceduralMeshSections(ProceduralMeshComponent, Sections, SectionsMaterials, ProceduralMeshConfig);
+					AsyncCallback.ExecuteIfBound(ProceduralMeshComponent);
+				}, TStatId(), nullptr, ENamedThreads::GameThread);
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+		});
+}
+
+bool FglTFRuntimeParser::LoadMeshIntoProceduralMeshSections(const int32 MeshIndex, TArray<FProcMeshSection>& Sections, TArray<UMaterialInterface*>& SectionsMaterials, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadMeshIntoProceduralMeshSections, FColor::Magenta);
+
 	TSharedPtr<FJsonObject> JsonMeshObject = GetJsonObjectFromRootIndex("meshes", MeshIndex);
 	if (!JsonMeshObject)
 	{
@@ -1319,40 +1668,90 @@ bool FglTFRuntimeParser::LoadStaticMeshIntoProceduralMeshComponent(const int32 M
 		return false;
 	}
 
-	ProceduralMeshComponent->bUseComplexAsSimpleCollision = ProceduralMeshConfig.bUseComplexAsSimpleCollision;
+	Sections.AddDefaulted(Primitives.Num());
+	SectionsMaterials.Reserve(Primitives.Num());
 
-	int32 SectionIndex = ProceduralMeshComponent->GetNumSections();
-	for (FglTFRuntimePrimitive& Primitive : Primitives)
+	for (int32 PrimitiveIndex = 0; PrimitiveIndex < Primitives.Num(); PrimitiveIndex++)
 	{
-		TArray<FVector2D> UV;
-		if (Primitive.UVs.Num() > 0)
-		{
-			UV = Primitive.UVs[0];
-		}
-		TArray<int32> Triangles;
-		Triangles.AddUninitialized(Primitive.Indices.Num());
-		for (int32 Index = 0; Index < Primitive.Indices.Num(); Index++)
-		{
-			Triangles[Index] = Primitive.Indices[Index];
-		}
-		TArray<FLinearColor> Colors;
-		Colors.AddUninitialized(Primitive.Colors.Num());
-		for (int32 Index = 0; Index < Primitive.Colors.Num(); Index++)
+		FglTFRuntimePrimitive& Primitive = Primitives[PrimitiveIndex];
+		FProcMeshSection& Section = Sections[PrimitiveIndex];
+
+		const int32 NumVertices = Primitive.Positions.Num();
+		const bool bHasNormals = Primitive.Normals.Num() == NumVertices;
+		const bool bHasTangents = Primitive.Tangents.Num() == NumVertices;
+		const bool bHasColors = Primitive.Colors.Num() == NumVertices;
+		const int32 NumUVs = FMath::Min(Primitive.UVs.Num(), 4);
+
+		// vertices are built in place (no intermediate per-attribute arrays)
+		Section.ProcVertexBuffer.AddUninitialized(NumVertices);
+		ParallelFor(NumVertices, [&](const int32 VertexIndex)
+			{
+				FProcMeshVertex& Vertex = Section.ProcVertexBuffer[VertexIndex];
+				Vertex.Position = Primitive.Positions[VertexIndex];
+				Vertex.Normal = bHasNormals ? Primitive.Normals[VertexIndex] : FVector(0, 0, 1);
+				Vertex.Tangent = bHasTangents ? FProcMeshTangent(FVector(Primitive.Tangents[VertexIndex]), false) : FProcMeshTangent();
+				Vertex.Color = bHasColors ? FLinearColor(Primitive.Colors[VertexIndex]).ToFColor(false) : FColor(255, 255, 255);
+				FVector2D* UVs[4] = { &Vertex.UV0, &Vertex.UV1, &Vertex.UV2, &Vertex.UV3 };
+				for (int32 UVIndex = 0; UVIndex < 4; UVIndex++)
+				{
+					*UVs[UVIndex] = UVIndex < NumUVs && Primitive.UVs[UVIndex].IsValidIndex(VertexIndex) ? Primitive.UVs[UVIndex][VertexIndex] : FVector2D::ZeroVector;
+				}
+			}, NumVertices < 4096);
+
+		Section.SectionLocalBox = FBox(Primitive.Positions);
+
+		// indices are moved, not copied
+		Section.ProcIndexBuffer = MoveTemp(Primitive.Indices);
+		Section.ProcIndexBuffer.SetNum((Section.ProcIndexBuffer.Num() / 3) * 3);
+		for (uint32& Index : Section.ProcIndexBuffer)
 		{
-			Colors[Index] = FLinearColor(Primitive.Colors[Index]);
+			Index = FMath::Min<uint32>(Index, NumVertices > 0 ? NumVertices - 1 : 0);
 		}
-		TArray<FProcMeshTangent> Tangents;
-		Tangents.AddUninitialized(Primitive.Tangents.Num());
-		for (int32 Index = 0; Index < Primitive.Tangents.Num(); Index++)
+
+		Section.bEnableCollision = ProceduralMeshConfig.bBuildSimpleCollision;
+
+		SectionsMaterials.Add(Primitive.Material);
+	}
+
+	return true;
+}
+
+void FglTFRuntimeParser::CommitProceduralMeshSections(UProceduralMeshComponent* ProceduralMeshComponent, TArray<FProcMeshSection>& Sections, const TArray<UMaterialInterface*>& SectionsMaterials, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_CommitProceduralMeshSections, FColor::Magenta);
+
+	ProceduralMeshComponent->bUseComplexAsSimpleCollision = ProceduralMeshConfig.bUseComplexAsSimpleCollision;
+	ProceduralMeshComponent->bUseAsyncCooking = ProceduralMeshConfig.bUseAsyncCooking;
+
+	if (Sections.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 FirstSectionIndex = ProceduralMeshComponent->GetNumSections();
+	const int32 LastSectionIndex = FirstSectionIndex + Sections.Num() - 1;
+
+	// bounds, collision and render state can only be refreshed by SetProcMeshSection() (the component keeps
+	// its refresh functions private), so all of the buffers but the last one are moved in place and the last
+	// section is committed with a single SetProcMeshSection() call once every other section is ready
+	if (Sections.Num() > 1)
+	{
+		// growing with empty sections (no collision) costs no cooking and no render data
+		ProceduralMeshComponent->SetProcMeshSection(LastSectionIndex - 1, FProcMeshSection());
+		for (int32 SectionIndex = 0; SectionIndex < Sections.Num() - 1; SectionIndex++)
 		{
-			Tangents[Index] = FProcMeshTangent(Primitive.Tangents[Index], false);
+			*ProceduralMeshComponent->GetProcMeshSection(FirstSectionIndex + SectionIndex) = MoveTemp(Sections[SectionIndex]);
 		}
-		ProceduralMeshComponent->CreateMeshSection_LinearColor(SectionIndex, Primitive.Positions, Triangles, Primitive.Normals, UV, Colors, Tangents, ProceduralMeshConfig.bBuildSimpleCollision);
-		ProceduralMeshComponent->SetMaterial(SectionIndex, Primitive.Material);
-		SectionIndex++;
 	}
 
-	return true;
+	for (int32 SectionIndex = 0; SectionIndex < Sections.Num(); SectionIndex++)
+	{
+		ProceduralMeshComponent->SetMaterial(FirstSectionIndex + SectionIndex, SectionsMaterials[SectionIndex]);
+	}
+
+	ProceduralMeshComponent->SetProcMeshSection(LastSectionIndex, Sections.Last());
+
+	Sections.Empty();
 }
 
 UStaticMesh* FglTFRuntimeParser::LoadStaticMeshByName(const FString Name, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig)
@@ -0,0 +1,464 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeParser.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace glTFRuntime
+{
+	// per-vertex influences (flattened, VertexInfluencesOffsets has NumVertices + 1 items)
+	struct FVertexAnimationInfluences
+	{
+		TArray<int32> VertexInfluencesOffsets;
+		TArray<int32> Bones;
+		TArray<float> Weights;
+	};
+}
+
+bool FglTFRuntimeParser::BakeVertexAnimation(const int32 MeshIndex, const int32 SkinIndex, const TArray<int32>& AnimationIndices, const FglTFRuntimeVertexAnimationConfig& VertexAnimationConfig, FglTFRuntimeVertexAnimationData& VertexAnimationData)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_BakeVertexAnimation, FColor::Magenta);
+
+	if (!LoadMeshAsRuntimeLOD(MeshIndex, VertexAnimationData.RuntimeLOD, VertexAnimationConfig.StaticMeshConfig.MaterialsConfig))
+	{
+		AddError("BakeVertexAnimation()", FString::Printf(TEXT("Unable to load Mesh with index %d"), MeshIndex));
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonSkinObject = GetJsonObjectFromRootIndex("skins", SkinIndex);
+	if (!JsonSkinObject)
+	{
+		AddError("BakeVertexAnimation()", FString::Printf(TEXT("Unable to find Skin with index %d"), SkinIndex));
+		return false;
+	}
+
+	// the same reference skeleton (and joints map) built for skeletal meshes
+	FReferenceSkeleton RefSkeleton;
+	TMap<int32, FName> MainBoneMap;
+	if (!FillReferenceSkeleton(JsonSkinObject.ToSharedRef(), RefSkeleton, MainBoneMap, VertexAnimationConfig.SkeletonConfig))
+	{
+		AddError("BakeVertexAnimation()", "Unable to fill RefSkeleton.");
+		return false;
+	}
+
+	const int32 NumBones = RefSkeleton.GetNum();
+	const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+
+	TArray<FMatrix> InvRefBasesMatrices;
+	{
+		TArray<FTransform> RefComponentPose;
+		RefComponentPose.AddUninitialized(NumBones);
+		InvRefBasesMatrices.AddUninitialized(NumBones);
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+			RefComponentPose[BoneIndex] = ParentIndex > INDEX_NONE ? RefBonePose[BoneIndex] * RefComponentPose[ParentIndex] : RefBonePose[BoneIndex];
+			InvRefBasesMatrices[BoneIndex] = RefComponentPose[BoneIndex].ToMatrixWithScale().Inverse();
+		}
+	}
+
+	// vertices of all of the primitives are baked contiguously
+	glTFRuntime::FVertexAnimationInfluences Influences;
+	VertexAnimationData.RestPositions.Empty();
+	TArray<FVector> RestNormals;
+	Influences.VertexInfluencesOffsets.Add(0);
+
+	for (const FglTFRuntimePrimitive& Primitive : VertexAnimationData.RuntimeLOD.Primitives)
+	{
+		const TMap<int32, FName>& BoneMapInUse = Primitive.OverrideBoneMap.Num() > 0 ? Primitive.OverrideBoneMap : MainBoneMap;
+		TMap<int32, int32> JointsToBones;
+		for (const TPair<int32, FName>& Pair : BoneMapInUse)
+		{
+			JointsToBones.Add(Pair.Key, RefSkeleton.FindBoneIndex(Pair.Value));
+		}
+
+		for (int32 VertexIndex = 0; VertexIndex < Primitive.Positions.Num(); VertexIndex++)
+		{
+			VertexAnimationData.RestPositions.Add(Primitive.Positions[VertexIndex]);
+			RestNormals.Add(Primitive.Normals.IsValidIndex(VertexIndex) ? Primitive.Normals[VertexIndex] : FVector::ZeroVector);
+
+			float TotalWeight = 0;
+			const int32 FirstInfluence = Influences.Bones.Num();
+			for (int32 JointsIndex = 0; JointsIndex < FMath::Min(Primitive.Joints.Num(), Primitive.Weights.Num()); JointsIndex++)
+			{
+				if (!Primitive.Joints[JointsIndex].IsValidIndex(VertexIndex) || !Primitive.Weights[JointsIndex].IsValidIndex(VertexIndex))
+				{
+					continue;
+				}
+
+				const FglTFRuntimeUInt16Vector4& Joints = Primitive.Joints[JointsIndex][VertexIndex];
+				const FglTFRuntimeUInt16Vector4& Weights = Primitive.Weights[JointsIndex][VertexIndex];
+				for (int32 j = 0; j < 4; j++)
+				{
+					if (Weights[j] == 0)
+					{
+						continue;
+					}
+
+					const int32* BoneIndex = JointsToBones.Find(Joints[j]);
+					if (!BoneIndex || *BoneIndex <= INDEX_NONE)
+					{
+						if (!VertexAnimationConfig.bIgnoreMissingBones)
+						{
+							AddError("BakeVertexAnimation()", FString::Printf(TEXT("Unable to find map for bone %u"), Joints[j]));
+							return false;
+						}
+						continue;
+					}
+
+					const float Weight = static_cast<float>(Weights[j]) / MAX_uint16;
+					Influences.Bones.Add(*BoneIndex);
+					Influences.Weights.Add(Weight);
+					TotalWeight += Weight;
+				}
+			}
+
+			if (TotalWeight > 0)
+			{
+				for (int32 InfluenceIndex = FirstInfluence; InfluenceIndex < Influences.Weights.Num(); InfluenceIndex++)
+				{
+					Influences.Weights[InfluenceIndex] /= TotalWeight;
+				}
+			}
+
+			Influences.VertexInfluencesOffsets.Add(Influences.Bones.Num());
+		}
+	}
+
+	VertexAnimationData.NumVertices = VertexAnimationData.RestPositions.Num();
+	if (VertexAnimationData.NumVertices == 0)
+	{
+		AddError("BakeVertexAnimation()", "Mesh has no vertices");
+		return false;
+	}
+
+	VertexAnimationData.RestBounds = FBox(VertexAnimationData.RestPositions);
+
+	// animations are sampled with the same logic of skeletal animations
+	const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig = VertexAnimationConfig.SkeletalAnimationConfig;
+	TArray<int32> SelectedAnimationIndices = AnimationIndices;
+	if (SelectedAnimationIndices.Num() == 0)
+	{
+		for (int32 AnimationIndex = 0; AnimationIndex < GetNumAnimations(); AnimationIndex++)
+		{
+			SelectedAnimationIndices.Add(AnimationIndex);
+		}
+	}
+
+	TArray<FglTFRuntimeSkeletalAnimationClip> AnimationClips;
+	if (!LoadSkeletalAnimationClips(RefSkeleton, SelectedAnimationIndices, SkeletalAnimationConfig, AnimationClips))
+	{
+		return false;
+	}
+
+	VertexAnimationData.Clips.Empty();
+	VertexAnimationData.NumFrames = 0;
+	for (FglTFRuntimeSkeletalAnimationClip& AnimationClip : AnimationClips)
+	{
+		if (!AnimationClip.bValid)
+		{
+			AddError("BakeVertexAnimation()", FString::Printf(TEXT("Unable to load animation %d"), AnimationClip.AnimationIndex));
+			return false;
+		}
+
+		FglTFRuntimeVertexAnimationClip& Clip = VertexAnimationData.Clips.AddDefaulted_GetRef();
+		Clip.AnimationIndex = AnimationClip.AnimationIndex;
+		Clip.Duration = AnimationClip.Duration;
+		Clip.FirstFrame = VertexAnimationData.NumFrames;
+		Clip.NumFrames = FMath::Max<int32>(AnimationClip.Duration * SkeletalAnimationConfig.FramesPerSecond, 1);
+
+		TSharedPtr<FJsonObject> JsonAnimationObject = GetJsonObjectFromRootIndex("animations", AnimationClip.AnimationIndex);
+		if (JsonAnimationObject)
+		{
+			JsonAnimationObject->TryGetStringField(TEXT("name"), Clip.Name);
+		}
+
+		for (int32 TrackIndex = 0; TrackIndex < AnimationClip.Tracks.Num(); TrackIndex++)
+		{
+			if (AnimationClip.Tracks.BoneIndices[TrackIndex] > INDEX_NONE)
+			{
+				SanitizeBoneTrack(RefSkeleton, AnimationClip.Tracks.BoneIndices[TrackIndex], Clip.NumFrames, AnimationClip.Tracks.Tracks[TrackIndex], SkeletalAnimationConfig);
+			}
+		}
+
+		VertexAnimationData.NumFrames += Clip.NumFrames;
+	}
+
+	const int32 NumVertices = VertexAnimationData.NumVertices;
+	const int32 NumFrames = VertexAnimationData.NumFrames;
+	if (NumFrames == 0)
+	{
+		AddError("BakeVertexAnimation()", "No animations to bake");
+		return false;
+	}
+
+	VertexAnimationData.TextureWidth = FMath::Min(NumVertices, FMath::Max(VertexAnimationConfig.MaxTextureWidth, 1));
+	VertexAnimationData.RowsPerFrame = FMath::DivideAndRoundUp(NumVertices, VertexAnimationData.TextureWidth);
+
+	VertexAnimationData.Positions.SetNumUninitialized(static_cast<int64>(NumFrames) * NumVertices);
+	if (VertexAnimationConfig.bBakeNormals)
+	{
+		VertexAnimationData.Normals.SetNumUninitialized(static_cast<int64>(NumFrames) * NumVertices);
+	}
+	else
+	{
+		VertexAnimationData.Normals.Empty();
+	}
+
+	// frame to clip mapping
+	TArray<int32> FramesClips;
+	FramesClips.Reserve(NumFrames);
+	TArray<TArray<int32>> ClipsBonesToTracks;
+	for (int32 ClipIndex = 0; ClipIndex < AnimationClips.Num(); ClipIndex++)
+	{
+		for (int32 FrameIndex = 0; FrameIndex < VertexAnimationData.Clips[ClipIndex].NumFrames; FrameIndex++)
+		{
+			FramesClips.Add(ClipIndex);
+		}
+
+		TArray<int32>& BonesToTracks = ClipsBonesToTracks.AddDefaulted_GetRef();
+		BonesToTracks.Init(INDEX_NONE, NumBones);
+		for (int32 TrackIndex = 0; TrackIndex < AnimationClips[ClipIndex].Tracks.Num(); TrackIndex++)
+		{
+			const int32 BoneIndex = AnimationClips[ClipIndex].Tracks.BoneIndices[TrackIndex];
+			if (BoneIndex > INDEX_NONE && BoneIndex < NumBones)
+			{
+				BonesToTracks[BoneIndex] = TrackIndex;
+			}
+		}
+	}
+
+	TArray<FBox> FramesBounds;
+	FramesBounds.AddUninitialized(NumFrames);
+
+	// every frame is an independent pose, so frames are skinned in parallel
+	ParallelFor(NumFrames, [&](const int32 FrameIndex)
+		{
+			const int32 ClipIndex = FramesClips[FrameIndex];
+			const int32 ClipFrame = FrameIndex - VertexAnimationData.Clips[ClipIndex].FirstFrame;
+			const FglTFRuntimeBoneTracks& Tracks = AnimationClips[ClipIndex].Tracks;
+			const TArray<int32>& BonesToTracks = ClipsBonesToTracks[ClipIndex];
+
+			TArray<FTransform> ComponentPose;
+			ComponentPose.AddUninitialized(NumBones);
+			TArray<FMatrix> SkinMatrices;
+			SkinMatrices.AddUninitialized(NumBones);
+
+			for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+			{
+				FTransform LocalTransform = RefBonePose[BoneIndex];
+				const int32 TrackIndex = BonesToTracks[BoneIndex];
+				if (TrackIndex > INDEX_NONE)
+				{
+					const FRawAnimSequenceTrack& Track = Tracks.Tracks[TrackIndex];
+					if (Track.PosKeys.IsValidIndex(ClipFrame) && Track.RotKeys.IsValidIndex(ClipFrame) && Track.ScaleKeys.IsValidIndex(ClipFrame))
+					{
+						LocalTransform = FTransform(FQuat(Track.RotKeys[ClipFrame]), FVector(Track.PosKeys[ClipFrame]), FVector(Track.ScaleKeys[ClipFrame]));
+					}
+				}
+
+				const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+				ComponentPose[BoneIndex] = ParentIndex > INDEX_NONE ? LocalTransform * ComponentPose[ParentIndex] : LocalTransform;
+				SkinMatrices[BoneIndex] = InvRefBasesMatrices[BoneIndex] * ComponentPose[BoneIndex].ToMatrixWithScale();
+			}
+
+			FVector* FramePositions = VertexAnimationData.Positions.GetData() + static_cast<int64>(FrameIndex) * NumVertices;
+			FVector* FrameNormals = VertexAnimationConfig.bBakeNormals ? VertexAnimationData.Normals.GetData() + static_cast<int64>(FrameIndex) * NumVertices : nullptr;
+			FBox& FrameBounds = FramesBounds[FrameIndex];
+			FrameBounds.Init();
+
+			for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+			{
+				const int32 FirstInfluence = Influences.VertexInfluencesOffsets[VertexIndex];
+				const int32 LastInfluence = Influences.VertexInfluencesOffsets[VertexIndex + 1];
+
+				const FVector& RestPosition = VertexAnimationData.RestPositions[VertexIndex];
+				const FVector& RestNormal = RestNormals[VertexIndex];
+
+				// unskinned vertices stay in the rest pose
+				FVector Position = FirstInfluence < LastInfluence ? FVector::ZeroVector : RestPosition;
+				FVector Normal = FirstInfluence < LastInfluence ? FVector::ZeroVector : RestNormal;
+				for (int32 InfluenceIndex = FirstInfluence; InfluenceIndex < LastInfluence; InfluenceIndex++)
+				{
+					const FMatrix& SkinMatrix = SkinMatrices[Influences.Bones[InfluenceIndex]];
+					const float Weight = Influences.Weights[InfluenceIndex];
+					Position += FVector(SkinMatrix.TransformPosition(RestPosition)) * Weight;
+					Normal += FVector(SkinMatrix.TransformVector(RestNormal)) * Weight;
+				}
+
+				FramePositions[VertexIndex] = Position;
+				FrameBounds += Position;
+				if (FrameNormals)
+				{
+					FrameNormals[VertexIndex] = Normal.GetSafeNormal();
+				}
+			}
+		});
+
+	VertexAnimationData.AnimatedBounds = VertexAnimationData.RestBounds;
+	for (const FBox& FrameBounds : FramesBounds)
+	{
+		VertexAnimationData.AnimatedBounds += FrameBounds;
+	}
+
+	return true;
+}
+
+bool FglTFRuntimeParser::LoadVertexAnimation(const int32 MeshIndex, const int32 SkinIndex, const TArray<int32>& AnimationIndices, const FglTFRuntimeVertexAnimationConfig& VertexAnimationConfig, FglTFRuntimeVertexAnimation& VertexAnimation)
+{
+	SCOPED_NAMED_EVENT(FglTFRuntimeParser_LoadVertexAnimation, FColor::Magenta);
+
+	FglTFRuntimeVertexAnimationData VertexAnimationData;
+	if (!BakeVertexAnimation(MeshIndex, SkinIndex, AnimationIndices, VertexAnimationConfig, VertexAnimationData))
+	{
+		return false;
+	}
+
+	const int32 NumVertices = VertexAnimationData.NumVertices;
+	const int32 NumFrames = VertexAnimationData.NumFrames;
+	const int32 TextureWidth = VertexAnimationData.TextureWidth;
+	const int32 RowsPerFrame = VertexAnimationData.RowsPerFrame;
+	const int64 TextureHeight = static_cast<int64>(NumFrames) * RowsPerFrame;
+
+	if (TextureHeight > 16384)
+	{
+		AddError("LoadVertexAnimation()", FString::Printf(TEXT("Vertex animation texture is too big (%dx%lld), reduce the number of frames or increase MaxTextureWidth"), TextureWidth, TextureHeight));
+		return false;
+	}
+
+	// the vertex id is stored in an additional (high precision) UV channel, shared by all of the primitives
+	int32 VertexIdUVChannel = 0;
+	for (const FglTFRuntimePrimitive& Primitive : VertexAnimationData.RuntimeLOD.Primitives)
+	{
+		VertexIdUVChannel = FMath::Max(VertexIdUVChannel, Primitive.UVs.Num());
+	}
+
+	if (VertexIdUVChannel >= MAX_STATIC_TEXCOORDS)
+	{
+		AddError("LoadVertexAnimation()", "No free UV channel available for the vertex ids");
+		return false;
+	}
+
+	int32 BaseVertexIndex = 0;
+	for (FglTFRuntimePrimitive& Primitive : VertexAnimationData.RuntimeLOD.Primitives)
+	{
+		while (Primitive.UVs.Num() < VertexIdUVChannel)
+		{
+			Primitive.UVs.AddDefaulted_GetRef().SetNumZeroed(Primitive.Positions.Num());
+		}
+
+		TArray<FVector2D>& VertexIdUVs = Primitive.UVs.AddDefaulted_GetRef();
+		VertexIdUVs.AddUninitialized(Primitive.Positions.Num());
+		for (int32 VertexIndex = 0; VertexIndex < Primitive.Positions.Num(); VertexIndex++)
+		{
+			const int32 VertexId = BaseVertexIndex + VertexIndex;
+			VertexIdUVs[VertexIndex] = FVector2D((VertexId % TextureWidth + 0.5) / TextureWidth, VertexId / TextureWidth);
+		}
+
+		Primitive.bHighPrecisionUVs = true;
+		BaseVertexIndex += Primitive.Positions.Num();
+	}
+
+	TArray<FglTFRuntimeMipMap> PositionsMips;
+	FglTFRuntimeMipMap& PositionsMip = PositionsMips.Emplace_GetRef(INDEX_NONE, EPixelFormat::PF_A32B32G32R32F, TextureWidth, static_cast<int32>(TextureHeight));
+	PositionsMip.Pixels.SetNumZeroed(static_cast<int64>(TextureWidth) * TextureHeight * sizeof(FLinearColor));
+
+	TArray<FglTFRuntimeMipMap> NormalsMips;
+	if (VertexAnimationConfig.bBakeNormals)
+	{
+		FglTFRuntimeMipMap& NormalsMip = NormalsMips.Emplace_GetRef(INDEX_NONE, EPixelFormat::PF_B8G8R8A8, TextureWidth, static_cast<int32>(TextureHeight));
+		NormalsMip.Pixels.SetNumZeroed(static_cast<int64>(TextureWidth) * TextureHeight * sizeof(FColor));
+	}
+
+	ParallelFor(NumFrames, [&](const int32 FrameIndex)
+		{
+			FLinearColor* PositionsPixels = reinterpret_cast<FLinearColor*>(PositionsMips[0].Pixels.GetData()) + static_cast<int64>(FrameIndex) * RowsPerFrame * TextureWidth;
+			FColor* NormalsPixels = VertexAnimationConfig.bBakeNormals ? reinterpret_cast<FColor*>(NormalsMips[0].Pixels.GetData()) + static_cast<int64>(FrameIndex) * RowsPerFrame * TextureWidth : nullptr;
+			const int64 FrameOffset = static_cast<int64>(FrameIndex) * NumVertices;
+
+			for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+			{
+				const FVector Offset = VertexAnimationData.Positions[FrameOffset + VertexIndex] - VertexAnimationData.RestPositions[VertexIndex];
+				PositionsPixels[VertexIndex] = FLinearColor(Offset.X, Offset.Y, Offset.Z, 1);
+				if (NormalsPixels)
+				{
+					NormalsPixels[VertexIndex] = FLinearColor(VertexAnimationData.Normals[FrameOffset + VertexIndex] * 0.5 + FVector(0.5)).ToFColor(false);
+				}
+			}
+		});
+
+	FglTFRuntimeImagesConfig ImagesConfig;
+	ImagesConfig.Compression = TextureCompressionSettings::TC_HDR;
+	ImagesConfig.bSRGB = false;
+	ImagesConfig.bStreaming = false;
+
+	FglTFRuntimeTextureSampler Sampler;
+	Sampler.TileX = TextureAddress::TA_Clamp;
+	Sampler.TileY = TextureAddress::TA_Clamp;
+	Sampler.MinFilter = TextureFilter::TF_Nearest;
+	Sampler.MagFilter = TextureFilter::TF_Nearest;
+
+	UTexture2D* PositionsTexture = BuildTexture(GetTransientPackage(), PositionsMips, ImagesConfig, Sampler);
+	UTexture2D* NormalsTexture = nullptr;
+	if (VertexAnimationConfig.bBakeNormals)
+	{
+		ImagesConfig.Compression = TextureCompressionSettings::TC_VectorDisplacementmap;
+		NormalsTexture = BuildTexture(GetTransientPackage(), NormalsMips, ImagesConfig, Sampler);
+	}
+
+	UStaticMesh* StaticMesh = LoadStaticMeshFromRuntimeLODs({ VertexAnimationData.RuntimeLOD }, VertexAnimationConfig.StaticMeshConfig);
+	if (!StaticMesh || !PositionsTexture)
+	{
+		AddError("LoadVertexAnimation()", "Unable to build vertex animation assets");
+		return false;
+	}
+
+	// the rest pose bounds are extended to contain all of the baked frames
+	const FVector PositiveBoundsExtension = (VertexAnimationData.AnimatedBounds.Max - VertexAnimationData.RestBounds.Max).ComponentMax(FVector::ZeroVector);
+	const FVector NegativeBoundsExtension = (VertexAnimationData.RestBounds.Min - VertexAnimationData.AnimatedBounds.Min).ComponentMax(FVector::ZeroVector);
+#if ENGINE_MAJOR_VERSION > 4
+	StaticMesh->SetPositiveBoundsExtension(PositiveBoundsExtension);
+	StaticMesh->SetNegativeBoundsExtension(NegativeBoundsExtension);
+#else
+	StaticMesh->PositiveBoundsExtension = PositiveBoundsExtension;
+	StaticMesh->NegativeBoundsExtension = NegativeBoundsExtension;
+#endif
+	StaticMesh->CalculateExtendedBounds();
+
+	if (VertexAnimationConfig.VertexAnimationMaterial)
+	{
+		UMaterialInstanceDynamic* Material = UMaterialInstanceDynamic::Create(VertexAnimationConfig.VertexAnimationMaterial, StaticMesh);
+		Material->SetTextureParameterValue("PositionsTexture", PositionsTexture);
+		if (NormalsTexture)
+		{
+			Material->SetTextureParameterValue("NormalsTexture", NormalsTexture);
+		}
+		Material->SetScalarParameterValue("NumFrames", NumFrames);
+		Material->SetScalarParameterValue("RowsPerFrame", RowsPerFrame);
+		Material->SetScalarParameterValue("TextureHeight", static_cast<float>(TextureHeight));
+		Material->SetScalarParameterValue("FramesPerSecond", VertexAnimationConfig.SkeletalAnimationConfig.FramesPerSecond);
+
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 26
+		const int32 NumMaterials = StaticMesh->GetStaticMaterials().Num();
+#else
+		const int32 NumMaterials = StaticMesh->StaticMaterials.Num();
+#endif
+		for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; MaterialIndex++)
+		{
+			StaticMesh->SetMaterial(MaterialIndex, Material);
+		}
+	}
+
+	VertexAnimation.StaticMesh = StaticMesh;
+	VertexAnimation.PositionsTexture = PositionsTexture;
+	VertexAnimation.NormalsTexture = NormalsTexture;
+	VertexAnimation.Clips = VertexAnimationData.Clips;
+	VertexAnimation.NumVertices = NumVertices;
+	VertexAnimation.NumFrames = NumFrames;
+	VertexAnimation.RowsPerFrame = RowsPerFrame;
+	VertexAnimation.TextureWidth = TextureWidth;
+	VertexAnimation.TextureHeight = static_cast<int32>(TextureHeight);
+	VertexAnimation.VertexIdUVChannel = VertexIdUVChannel;
+	VertexAnimation.FramesPerSecond = VertexAnimationConfig.SkeletalAnimationConfig.FramesPerSecond;
+
+	return true;
+}
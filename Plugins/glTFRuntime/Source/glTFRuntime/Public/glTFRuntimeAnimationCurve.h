@@ -6,6 +6,24 @@
 #include "Curves/CurveBase.h"
 #include "glTFRuntimeAnimationCurve.generated.h"
 
+/**
+ * Per-caller evaluation state, keeps the last used keys for coherent time sampling
+ */
+USTRUCT(BlueprintType)
+struct FglTFRuntimeAnimationCurveCursor
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    int32 LocationKey = 0;
+
+    UPROPERTY()
+    int32 RotationKey = 0;
+
+    UPROPERTY()
+    int32 ScaleKey = 0;
+};
+
 /**
  * 
  */
@@ -26,9 +44,57 @@ class GLTFRUNTIME_API UglTFRuntimeAnimationCurve : public UCurveBase
     UPROPERTY()
     FRichCurve ScaleCurves[3];
 
-    TArray<TPair<float, FQuat>> ConvertedQuaternions;
+    UPROPERTY()
+    TArray<float> RotationTimes;
+
+    UPROPERTY()
+    TArray<FQuat> RotationValues;
+
+    UPROPERTY()
     bool bIsStepped;
 
+    // packed copies of the location/scale curves (all of the components share the same times)
+    UPROPERTY()
+    TArray<float> LocationTimes;
+
+    UPROPERTY()
+    TArray<FVector> LocationValues;
+
+    UPROPERTY()
+    bool bIsLocationStepped;
+
+    UPROPERTY()
+    TArray<float> ScaleTimes;
+
+    UPROPERTY()
+    TArray<FVector> ScaleValues;
+
+    UPROPERTY()
+    bool bIsScaleStepped;
+
+    UPROPERTY()
+    FVector DefaultLocation;
+
+    UPROPERTY()
+    FVector DefaultScale;
+
+    // set when the curves have been changed from the editor (or cannot be packed), the FRichCurves are used in such a case
+    UPROPERTY()
+    bool bPackedCurvesDirty;
+
+    UPROPERTY()
+    FMatrix BasisMatrix;
+
+    FMatrix InverseBasisMatrix;
+
+    FTransform EvaluateTransform(const float InTime, FglTFRuntimeAnimationCurveCursor& Cursor) const;
+
+    // glTF space rotation to the basis converted one
+    FQuat GetConvertedQuaternion(const FQuat& InQuat) const;
+
+    // rebuild the packed arrays from the FRichCurves (curves saved before they were serialized)
+    void RebuildPackedCurves();
+
     // Begin FCurveOwnerInterface
     virtual TArray<FRichCurveEditInfoConst> GetCurves() const override;
     virtual TArray<FRichCurveEditInfo> GetCurves() override;
@@ -38,9 +104,14 @@ class GLTFRUNTIME_API UglTFRuntimeAnimationCurve : public UCurveBase
 
     virtual bool IsValidCurve(FRichCurveEditInfo CurveInfo) override;
 
+    virtual void OnCurveChanged(const TArray<FRichCurveEditInfo>& ChangedCurveEditInfos) override;
+
 public:
     UglTFRuntimeAnimationCurve();
 
+    virtual void PostLoad() override;
+    virtual void PostDuplicate(bool bDuplicateForPIE) override;
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|Curves")
     FString glTFCurveAnimationName;
 
@@ -50,12 +121,16 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime|Curves")
     float glTFCurveAnimationDuration;
 
-    FMatrix BasisMatrix;
-
     /** Evaluate this float curve at the specified time */
     UFUNCTION(BlueprintCallable, Category = "glTFRuntime|Curves")
     FTransform GetTransformValue(float InTime) const;
 
+    /** Evaluate the curve at the specified time, reusing (and updating) the Cursor keys when sampling coherently */
+    UFUNCTION(BlueprintCallable, Category = "glTFRuntime|Curves")
+    FTransform GetTransformValueWithCursor(float InTime, UPARAM(ref) FglTFRuntimeAnimationCurveCursor& Cursor) const;
+
+    void SetBasisMatrix(const FMatrix& InBasisMatrix);
+
     void AddLocationValue(const float InTime, const FVector InLocation, const ERichCurveInterpMode InterpolationMode);
     void AddQuatValue(const float InTime, const FQuat InQuat, const ERichCurveInterpMode InterpolationMode);
     void AddRotatorValue(const float InTime, const FRotator InRotator, const ERichCurveInterpMode InterpolationMode);
@@ -24,6 +24,8 @@ protected:
 
 	TMap<USceneComponent*, float>  CurveBasedAnimationsTimeTracker;
 
+	TMap<USceneComponent*, FglTFRuntimeAnimationCurveCursor> CurveBasedAnimationsCursors;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
 	TSet<FString> DiscoveredCurveAnimationsNames;
 
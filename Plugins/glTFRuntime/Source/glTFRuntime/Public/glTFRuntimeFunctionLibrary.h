@@ -72,6 +72,9 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get an array of bytes containing the glTF Runtime LOD normals"), Category = "glTFRuntime")
 	static bool GetNormalsAsBytesFromglTFRuntimeLODPrimitive(const FglTFRuntimeMeshLOD& RuntimeLOD, const int32 PrimitiveIndex, TArray<uint8>& Bytes);
 
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get the per vertex deltas of a glTF Runtime LOD morph target"), Category = "glTFRuntime")
+	static bool GetMorphTargetDeltasFromglTFRuntimeLODPrimitive(const FglTFRuntimeMeshLOD& RuntimeLOD, const int32 PrimitiveIndex, const int32 MorphTargetIndex, TArray<FVector>& Positions, TArray<FVector>& Normals);
+
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "glTF Load Asset from Base64 String", AutoCreateRefTerm = "LoaderConfig"), Category = "glTFRuntime")
 	static UglTFRuntimeAsset* glTFLoadAssetFromBase64(const FString& Base64, const FglTFRuntimeConfig& LoaderConfig);
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Algo/BinarySearch.h"
 #include "Animation/AnimEnums.h"
 #include "Animation/PoseAsset.h"
 #include "Animation/Skeleton.h"
@@ -20,9 +21,11 @@
 #include "Engine/TextureCube.h"
 #include "Engine/TextureMipDataProviderFactory.h"
 #include "Engine/VolumeTexture.h"
+#include "Misc/ScopeRWLock.h"
 #include "Camera/CameraComponent.h"
 #include "Components/AudioComponent.h"
 #include "Components/LightComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "glTFRuntimeAnimationCurve.h"
 #include "ProceduralMeshComponent.h"
 #if WITH_EDITOR
@@ -60,6 +63,94 @@ struct FglTFRuntimeBlob
 	}
 };
 
+/*
+* Pre-indexed descriptors of the glTF root arrays (built once after parsing)
+* for avoiding DOM lookups and string comparisons in the hot paths.
+*/
+struct FglTFRuntimeBufferViewDesc
+{
+	int64 Buffer;
+	int64 ByteOffset;
+	int64 ByteLength;
+	int64 ByteStride;
+	bool bValid;
+	// EXT_meshopt_compression
+	bool bMeshoptCompressed;
+	int64 MeshoptCount;
+	FString MeshoptMode;
+	FString MeshoptFilter;
+
+	FglTFRuntimeBufferViewDesc()
+	{
+		Buffer = INDEX_NONE;
+		ByteOffset = 0;
+		ByteLength = 0;
+		ByteStride = 0;
+		bValid = false;
+		bMeshoptCompressed = false;
+		MeshoptCount = 0;
+	}
+};
+
+struct FglTFRuntimeAccessorDesc
+{
+	int64 BufferView;
+	int64 ByteOffset;
+	int64 ComponentType;
+	int64 Count;
+	int64 Elements;
+	int64 ElementSize;
+	bool bHasNormalized;
+	bool bNormalized;
+	bool bHasSparse;
+	bool bValid;
+
+	FglTFRuntimeAccessorDesc()
+	{
+		BufferView = INDEX_NONE;
+		ByteOffset = 0;
+		ComponentType = 0;
+		Count = 0;
+		Elements = 0;
+		ElementSize = 0;
+		bHasNormalized = false;
+		bNormalized = false;
+		bHasSparse = false;
+		bValid = false;
+	}
+};
+
+struct FglTFRuntimeNodeDesc
+{
+	bool bHasName;
+	FString Name;
+	int32 MeshIndex;
+	int32 SkinIndex;
+	int32 CameraIndex;
+	// local matrix (before scene scale and basis)
+	FMatrix Matrix;
+	bool bScaleNeedsToBeReapplied;
+	FVector ScaleToReapply;
+	// range in the parser NodesChildrenTable
+	int32 FirstChild;
+	int32 ChildrenNum;
+	bool bValid;
+
+	FglTFRuntimeNodeDesc()
+	{
+		bHasName = false;
+		MeshIndex = INDEX_NONE;
+		SkinIndex = INDEX_NONE;
+		CameraIndex = INDEX_NONE;
+		Matrix = FMatrix::Identity;
+		bScaleNeedsToBeReapplied = false;
+		ScaleToReapply = FVector::OneVector;
+		FirstChild = 0;
+		ChildrenNum = 0;
+		bValid = false;
+	}
+};
+
 UENUM()
 enum class EglTFRuntimeTransformBaseType : uint8
 {
@@ -260,6 +351,14 @@ struct FglTFRuntimeConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	FglTFRuntimeAESDecrypterHook AESDecrypterHook;
 
+	// directory for persisting generated static meshes render data across sessions (empty disables it, relative paths are based on the project Saved dir)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	FString DerivedDataCacheDirectory;
+
+	// reuse static meshes, materials and textures with the same content (and config) generated by other parsers
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bShareAssetsAcrossParsers;
+
 	FglTFRuntimeConfig()
 	{
 		TransformBaseType = EglTFRuntimeTransformBaseType::Default;
@@ -274,6 +373,7 @@ struct FglTFRuntimeConfig
 		bAsBlob = false;
 		PrefixForUnnamedNodes = "node";
 		bNoArchive = false;
+		bShareAssetsAcrossParsers = false;
 	}
 
 	FMatrix GetMatrix() const
@@ -452,6 +552,11 @@ struct FglTFRuntimeBone
 	}
 };
 
+/*
+* Morph targets can be dense (Positions/Normals indexed by vertex) or sparse (bSparse is true, Positions[i]/Normals[i] are
+* the deltas of the vertex Indices[i]). Loaded targets are always sparse: consumers indexing them by vertex must use
+* GetPositionDelta()/GetNormalDelta(), GetDensePositions()/GetDenseNormals() or Expand().
+*/
 USTRUCT(BlueprintType)
 struct FglTFRuntimeMorphTarget
 {
@@ -460,11 +565,161 @@ struct FglTFRuntimeMorphTarget
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	FString Name;
 
+	// NOTE: loaded targets are sparse (including the ones returned by LoadMeshAsRuntimeLOD), so this is no longer indexed by vertex:
+	// Positions[i] is the delta of vertex Indices[i] (use GetPositionDelta() or check bSparse before indexing it directly)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	TArray<FVector> Positions;
 
+	// same layout of Positions
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	TArray<FVector> Normals;
+
+	// sparse targets only store the deltas of the (sorted) vertices in Indices (a sparse target can have no deltas at all)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bSparse = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	TArray<int32> Indices;
+
+	bool IsSparse() const
+	{
+		return bSparse;
+	}
+
+	int32 FindDeltaIndex(const int32 VertexIndex) const
+	{
+		if (!IsSparse())
+		{
+			return VertexIndex;
+		}
+
+		const int32 DeltaIndex = Algo::LowerBound(Indices, VertexIndex);
+		return (DeltaIndex < Indices.Num() && Indices[DeltaIndex] == VertexIndex) ? DeltaIndex : INDEX_NONE;
+	}
+
+	FVector GetPositionDelta(const int32 VertexIndex) const
+	{
+		const int32 DeltaIndex = FindDeltaIndex(VertexIndex);
+		return Positions.IsValidIndex(DeltaIndex) ? Positions[DeltaIndex] : FVector::ZeroVector;
+	}
+
+	FVector GetNormalDelta(const int32 VertexIndex) const
+	{
+		const int32 DeltaIndex = FindDeltaIndex(VertexIndex);
+		return Normals.IsValidIndex(DeltaIndex) ? Normals[DeltaIndex] : FVector::ZeroVector;
+	}
+
+	// per vertex deltas (VerticesNum is the number of vertices of the primitive), an empty array if the target has no such deltas
+	TArray<FVector> GetDensePositions(const int32 VerticesNum) const
+	{
+		return GetDenseDeltas(Positions, VerticesNum);
+	}
+
+	TArray<FVector> GetDenseNormals(const int32 VerticesNum) const
+	{
+		return GetDenseDeltas(Normals, VerticesNum);
+	}
+
+	// convert a sparse target back to the dense form
+	void Expand(const int32 VerticesNum)
+	{
+		if (!IsSparse())
+		{
+			return;
+		}
+
+		Positions = GetDensePositions(VerticesNum);
+		Normals = GetDenseNormals(VerticesNum);
+		Indices.Empty();
+		bSparse = false;
+	}
+
+	// convert a dense target to the sparse form, dropping the vertices without deltas
+	void Compact()
+	{
+		if (IsSparse())
+		{
+			return;
+		}
+
+		const int32 VerticesNum = FMath::Max(Positions.Num(), Normals.Num());
+
+		TArray<int32> SparseIndices;
+		TArray<FVector> SparsePositions;
+		TArray<FVector> SparseNormals;
+
+		for (int32 VertexIndex = 0; VertexIndex < VerticesNum; VertexIndex++)
+		{
+			const FVector PositionDelta = Positions.IsValidIndex(VertexIndex) ? Positions[VertexIndex] : FVector::ZeroVector;
+			const FVector NormalDelta = Normals.IsValidIndex(VertexIndex) ? Normals[VertexIndex] : FVector::ZeroVector;
+			if (PositionDelta.IsZero() && NormalDelta.IsZero())
+			{
+				continue;
+			}
+
+			SparseIndices.Add(VertexIndex);
+			if (Positions.Num() > 0)
+			{
+				SparsePositions.Add(PositionDelta);
+			}
+			if (Normals.Num() > 0)
+			{
+				SparseNormals.Add(NormalDelta);
+			}
+		}
+
+		Indices = MoveTemp(SparseIndices);
+		Positions = MoveTemp(SparsePositions);
+		Normals = MoveTemp(SparseNormals);
+		bSparse = true;
+	}
+
+	TArray<FVector> GetDenseDeltas(const TArray<FVector>& Deltas, const int32 VerticesNum) const
+	{
+		if (!IsSparse() || Deltas.Num() == 0)
+		{
+			return Deltas;
+		}
+
+		TArray<FVector> DenseDeltas;
+		DenseDeltas.AddZeroed(VerticesNum);
+		for (int32 DeltaIndex = 0; DeltaIndex < Indices.Num() && DeltaIndex < Deltas.Num(); DeltaIndex++)
+		{
+			if (DenseDeltas.IsValidIndex(Indices[DeltaIndex]))
+			{
+				DenseDeltas[Indices[DeltaIndex]] = Deltas[DeltaIndex];
+			}
+		}
+		return DenseDeltas;
+	}
+
+	// append a sparse target whose vertices start at BaseIndex (both targets must be sparse)
+	void AppendSparse(const FglTFRuntimeMorphTarget& Other, const int32 BaseIndex)
+	{
+		const int32 DeltasNum = Indices.Num();
+		const int32 OtherDeltasNum = Other.Indices.Num();
+
+		// keep Positions and Normals aligned with Indices when only one of the two targets has them
+		if (Positions.Num() > 0 || Other.Positions.Num() > 0)
+		{
+			Positions.SetNumZeroed(DeltasNum);
+			Positions.Append(Other.Positions);
+			Positions.SetNumZeroed(DeltasNum + OtherDeltasNum);
+		}
+
+		if (Normals.Num() > 0 || Other.Normals.Num() > 0)
+		{
+			Normals.SetNumZeroed(DeltasNum);
+			Normals.Append(Other.Normals);
+			Normals.SetNumZeroed(DeltasNum + OtherDeltasNum);
+		}
+
+		Indices.Reserve(DeltasNum + OtherDeltasNum);
+		for (const int32 OtherIndex : Other.Indices)
+		{
+			Indices.Add(OtherIndex + BaseIndex);
+		}
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -508,6 +763,15 @@ struct FglTFRuntimeImagesConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	TEnumAsByte<EPixelFormat> ForcePixelFormat;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bGenerateCubeMapMips;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bCubeMapMipsGGX;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 CubeMapGGXSamples;
+
 	FglTFRuntimeImagesConfig()
 	{
 		Compression = TextureCompressionSettings::TC_Default;
@@ -522,6 +786,9 @@ struct FglTFRuntimeImagesConfig
 		LODBias = 0;
 		bForceAutoDetect = false;
 		ForcePixelFormat = EPixelFormat::PF_Unknown;
+		bGenerateCubeMapMips = false;
+		bCubeMapMipsGGX = false;
+		CubeMapGGXSamples = 64;
 	}
 };
 
@@ -721,6 +988,43 @@ struct FglTFRuntimeMaterialsConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	bool bForceEmptyMaterialNameToMaterialIndex;
 
+	// reorder triangles (vertex cache and overdraw) and vertices (fetch locality) of each loaded primitive
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bOptimizePrimitives;
+
+	// merge vertices with the same attributes (values are snapped to an epsilon-sized grid, 0 means exact match)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bWeldVertices;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float WeldPositionsEpsilon;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float WeldNormalsEpsilon;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float WeldUVsEpsilon;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float WeldColorsEpsilon;
+
+	// reuse a single material instance for glTF materials differing only by name (shared across parsers when bShareAssetsAcrossParsers is enabled)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bDeduplicateMaterials;
+
+	// pack the small textures of the materials of a mesh differing only by their textures into shared atlases (remapping the uvs of the primitives)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bAtlasTextures;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 AtlasMaxTextureSize;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 AtlasMaxSize;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 AtlasPadding;
+
 	FglTFRuntimeMaterialsConfig()
 	{
 		CacheMode = EglTFRuntimeCacheMode::ReadWrite;
@@ -743,6 +1047,17 @@ struct FglTFRuntimeMaterialsConfig
 		LinesScaleFactor = 1;
 		bAddEpicInterchangeParams = false;
 		bForceEmptyMaterialNameToMaterialIndex = false;
+		bOptimizePrimitives = false;
+		bWeldVertices = false;
+		WeldPositionsEpsilon = 0.001f;
+		WeldNormalsEpsilon = 0.001f;
+		WeldUVsEpsilon = 0.00001f;
+		WeldColorsEpsilon = 0.001f;
+		bDeduplicateMaterials = false;
+		bAtlasTextures = false;
+		AtlasMaxTextureSize = 256;
+		AtlasMaxSize = 2048;
+		AtlasPadding = 2;
 	}
 };
 
@@ -842,6 +1157,28 @@ struct FglTFRuntimeStaticMeshConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	bool bUseHighPrecisionTangentBasis;
 
+	// number of LODs to generate (via mesh simplification) when the asset provides only LOD0
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 AutoLODsNum;
+
+	// fraction of triangles retained by each generated LOD compared to the previous one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	float AutoLODsReductionFactor;
+
+	// cook the collision data in a worker thread (the physics state is recreated when the cooking is done)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bAsyncPhysicsCooking;
+
+	// approximate the LOD0 with a set of convex hulls to be used as simple collision
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bBuildConvexDecomposition;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 ConvexDecompositionMaxHulls;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 ConvexDecompositionMaxHullVertices;
+
 	FglTFRuntimeStaticMeshConfig()
 	{
 		CacheMode = EglTFRuntimeCacheMode::ReadWrite;
@@ -861,6 +1198,12 @@ struct FglTFRuntimeStaticMeshConfig
 		LODScreenSizeMultiplier = 2;
 		bBuildLumenCards = false;
 		bUseHighPrecisionTangentBasis = false;
+		AutoLODsNum = 0;
+		AutoLODsReductionFactor = 0.5f;
+		bAsyncPhysicsCooking = false;
+		bBuildConvexDecomposition = false;
+		ConvexDecompositionMaxHulls = 8;
+		ConvexDecompositionMaxHullVertices = 32;
 	}
 };
 
@@ -890,11 +1233,16 @@ struct FglTFRuntimeProceduralMeshConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
 	FglTFRuntimeMaterialsConfig MaterialsConfig;
 
+	// cook the collision data of the component in a worker thread
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bUseAsyncCooking;
+
 	FglTFRuntimeProceduralMeshConfig()
 	{
 		bReverseWinding = false;
 		bBuildSimpleCollision = false;
 		bUseComplexAsSimpleCollision = false;
+		bUseAsyncCooking = false;
 		PivotPosition = EglTFRuntimePivotPosition::Asset;
 	}
 };
@@ -1515,6 +1863,108 @@ struct FglTFRuntimeSkeletalAnimationConfig
 	}
 };
 
+USTRUCT(BlueprintType)
+struct FglTFRuntimeVertexAnimationConfig
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	FglTFRuntimeStaticMeshConfig StaticMeshConfig;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	FglTFRuntimeSkeletonConfig SkeletonConfig;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	FglTFRuntimeSkeletalAnimationConfig SkeletalAnimationConfig;
+
+	// vertices not fitting in a row are wrapped to the next ones (every frame uses RowsPerFrame rows)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	int32 MaxTextureWidth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bBakeNormals;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	bool bIgnoreMissingBones;
+
+	// when set, a dynamic instance of it (with the VAT parameters filled) is assigned to every material slot
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "glTFRuntime")
+	UMaterialInterface* VertexAnimationMaterial;
+
+	FglTFRuntimeVertexAnimationConfig()
+	{
+		MaxTextureWidth = 4096;
+		bBakeNormals = true;
+		bIgnoreMissingBones = false;
+		VertexAnimationMaterial = nullptr;
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FglTFRuntimeVertexAnimationClip
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 AnimationIndex = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	FString Name;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 FirstFrame = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 NumFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	float Duration = 0;
+};
+
+/*
+ * Vertex animation textures: every texel of PositionsTexture contains the offset (from the rest pose) of a vertex at a frame.
+ * The VertexIdUVChannel of the StaticMesh contains (U, RowInFrame) of every vertex, so the texel V coordinate is
+ * (Frame * RowsPerFrame + RowInFrame + 0.5) / TextureHeight
+ */
+USTRUCT(BlueprintType)
+struct FglTFRuntimeVertexAnimation
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	UStaticMesh* StaticMesh = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	UTexture2D* PositionsTexture = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	UTexture2D* NormalsTexture = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	TArray<FglTFRuntimeVertexAnimationClip> Clips;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 NumVertices = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 NumFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 RowsPerFrame = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 TextureWidth = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 TextureHeight = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	int32 VertexIdUVChannel = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "glTFRuntime")
+	float FramesPerSecond = 0;
+};
+
 struct FglTFRuntimeUInt16Vector4
 {
 	uint16 X;
@@ -1574,12 +2024,15 @@ struct FglTFRuntimePrimitive
 	TArray<uint32> Indices;
 	UMaterialInterface* Material;
 	TArray<TArray<FglTFRuntimeUInt16Vector4>> Joints;
-	TArray<TArray<FVector4>> Weights;
+	// normalized per vertex (across all of the sets) as 16 bit fixed point values (65535 = 1.0).
+	// NOTE: this used to be TArray<TArray<FVector4>>, hooks still working with float weights can use GetFloatWeights()/SetFloatWeights()
+	TArray<TArray<FglTFRuntimeUInt16Vector4>> Weights;
 	TArray<FVector4> Colors;
 	TArray<FglTFRuntimeMorphTarget> MorphTargets;
 	TMap<int32, FName> OverrideBoneMap;
 	TMap<int32, int32> BonesCache;
 	FString MaterialName;
+	int64 MaterialIndex;
 	int64 AdditionalBufferView;
 	int32 Mode;
 	bool bHasMaterial;
@@ -1591,6 +2044,7 @@ struct FglTFRuntimePrimitive
 
 	FglTFRuntimePrimitive()
 	{
+		MaterialIndex = INDEX_NONE;
 		AdditionalBufferView = INDEX_NONE;
 		bHasMaterial = false;
 		bHighPrecisionUVs = false;
@@ -1600,6 +2054,76 @@ struct FglTFRuntimePrimitive
 		bDisableShadows = false;
 		bHasIndices = false;
 	}
+
+	TArray<TArray<FVector4>> GetFloatWeights() const
+	{
+		TArray<TArray<FVector4>> FloatWeights;
+		FloatWeights.SetNum(Weights.Num());
+		for (int32 SetIndex = 0; SetIndex < Weights.Num(); SetIndex++)
+		{
+			FloatWeights[SetIndex].AddUninitialized(Weights[SetIndex].Num());
+			for (int32 VertexIndex = 0; VertexIndex < Weights[SetIndex].Num(); VertexIndex++)
+			{
+				const FglTFRuntimeUInt16Vector4& Weight = Weights[SetIndex][VertexIndex];
+				FloatWeights[SetIndex][VertexIndex] = FVector4(Weight.X / 65535.f, Weight.Y / 65535.f, Weight.Z / 65535.f, Weight.W / 65535.f);
+			}
+		}
+		return FloatWeights;
+	}
+
+	// the weights are normalized per vertex across all of the sets
+	void SetFloatWeights(const TArray<TArray<FVector4>>& FloatWeights)
+	{
+		Weights.SetNum(FloatWeights.Num());
+		int32 NumVertices = 0;
+		for (int32 SetIndex = 0; SetIndex < FloatWeights.Num(); SetIndex++)
+		{
+			Weights[SetIndex].SetNumZeroed(FloatWeights[SetIndex].Num());
+			NumVertices = FMath::Max(NumVertices, FloatWeights[SetIndex].Num());
+		}
+
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+		{
+			double TotalWeight = 0;
+			for (int32 SetIndex = 0; SetIndex < FloatWeights.Num(); SetIndex++)
+			{
+				if (FloatWeights[SetIndex].IsValidIndex(VertexIndex))
+				{
+					for (int32 Component = 0; Component < 4; Component++)
+					{
+						TotalWeight += FMath::Max<double>(FloatWeights[SetIndex][VertexIndex][Component], 0);
+					}
+				}
+			}
+
+			if (TotalWeight <= 0)
+			{
+				continue;
+			}
+
+			int32 QuantizedTotalWeight = 0;
+			uint16* BestWeight = nullptr;
+			for (int32 SetIndex = 0; SetIndex < FloatWeights.Num(); SetIndex++)
+			{
+				if (FloatWeights[SetIndex].IsValidIndex(VertexIndex))
+				{
+					for (int32 Component = 0; Component < 4; Component++)
+					{
+						uint16& Weight = Weights[SetIndex][VertexIndex][Component];
+						Weight = static_cast<uint16>(FMath::Clamp<int32>(FMath::RoundToInt(FMath::Max<double>(FloatWeights[SetIndex][VertexIndex][Component], 0) / TotalWeight * MAX_uint16), 0, MAX_uint16));
+						QuantizedTotalWeight += Weight;
+						if (!BestWeight || Weight > *BestWeight)
+						{
+							BestWeight = &Weight;
+						}
+					}
+				}
+			}
+
+			// rounding errors go to the most influent joint
+			*BestWeight = static_cast<uint16>(FMath::Clamp<int32>(*BestWeight + MAX_uint16 - QuantizedTotalWeight, 0, MAX_uint16));
+		}
+	}
 };
 
 struct FglTFRuntimeSkeletalMeshContext : public FGCObject
@@ -1793,6 +2317,7 @@ struct FglTFRuntimeSkeletalMeshContext : public FGCObject
 	}
 
 	const FBox& GetBoneBox(const int32 BoneIndex);
+	void BuildBoneBoxes();
 };
 
 USTRUCT(BlueprintType)
@@ -1825,6 +2350,62 @@ struct FglTFRuntimeMeshLOD
 	}
 };
 
+// CPU side result of a vertex animation bake (frame-major, skinned positions/normals in mesh space)
+struct FglTFRuntimeVertexAnimationData
+{
+	FglTFRuntimeMeshLOD RuntimeLOD;
+	TArray<FglTFRuntimeVertexAnimationClip> Clips;
+	TArray<FVector> RestPositions;
+	TArray64<FVector> Positions;
+	TArray64<FVector> Normals;
+	FBox RestBounds;
+	FBox AnimatedBounds;
+	int32 NumVertices = 0;
+	int32 NumFrames = 0;
+	int32 TextureWidth = 0;
+	int32 RowsPerFrame = 0;
+};
+
+struct FglTFRuntimeStaticMeshDerivedDataSection
+{
+	uint32 FirstIndex = 0;
+	uint32 NumTriangles = 0;
+	int32 MaterialIndex = 0;
+	bool bCastShadow = true;
+};
+
+struct FglTFRuntimeStaticMeshDerivedDataLOD
+{
+	// raw FStaticMeshBuildVertex array
+	TArray64<uint8> Vertices;
+	int32 VerticesNum = 0;
+	TArray<uint32> Indices;
+	TArray<FglTFRuntimeStaticMeshDerivedDataSection> Sections;
+	int32 NumUVs = 1;
+	bool bHighPrecisionUVs = false;
+	bool bHasVertexColors = false;
+};
+
+struct FglTFRuntimeStaticMeshDerivedDataMaterial
+{
+	FString SlotName;
+	int64 MaterialIndex = INDEX_NONE;
+	bool bUseVertexColors = false;
+	bool bVertexColorOnly = false;
+};
+
+struct FglTFRuntimeStaticMeshDerivedData
+{
+	TArray<FglTFRuntimeStaticMeshDerivedDataLOD> LODs;
+	TArray<FglTFRuntimeStaticMeshDerivedDataMaterial> Materials;
+	FBoxSphereBounds BoundingBoxAndSphere;
+	FVector LOD0PivotDelta = FVector::ZeroVector;
+	TMap<int32, float> LODScreenSize;
+	TMap<FString, FTransform> AdditionalSockets;
+	// set to false when the mesh references something that cannot be rebuilt from the cache (custom materials, generated base materials...)
+	bool bCacheable = true;
+};
+
 struct FglTFRuntimeStaticMeshContext : public FGCObject
 {
 	TSharedRef<class FglTFRuntimeParser> Parser;
@@ -1847,6 +2428,15 @@ struct FglTFRuntimeStaticMeshContext : public FGCObject
 	TArray<FglTFRuntimeMeshLOD> ContextLODs;
 	TMap<int32, int32> ContextLODsMap;
 
+	// screen sizes computed by the LOD generators (StaticMeshConfig.LODScreenSize still has the precedence)
+	TMap<int32, float> LODScreenSize;
+
+	// vertices of the convex hulls generated by the convex decomposition
+	TArray<TArray<FVector>> ConvexHulls;
+
+	// valid only when the static mesh render data is going to be stored in the derived data cache
+	TSharedPtr<FglTFRuntimeStaticMeshDerivedData> DerivedData;
+
 	const int32 MeshIndex;
 
 	FglTFRuntimeStaticMeshContext(TSharedRef<FglTFRuntimeParser> InParser, const int32 InMeshIndex, const FglTFRuntimeStaticMeshConfig& InStaticMeshConfig);
@@ -1922,6 +2512,17 @@ struct FglTFRuntimeMipMap
 	}
 };
 
+// uncompressed pixels of an image, shared by all of the textures referencing it
+struct FglTFRuntimeDecodedImage
+{
+	// decoding options the pixels have been generated with
+	FString DecodeKey;
+	TArray64<uint8> Pixels;
+	int32 Width = 0;
+	int32 Height = 0;
+	EPixelFormat PixelFormat = EPixelFormat::PF_B8G8R8A8;
+};
+
 class FglTFRuntimeTextureMipDataProvider : public FTextureMipDataProvider
 {
 public:
@@ -2305,11 +2906,126 @@ DECLARE_DYNAMIC_DELEGATE_TwoParams(FglTFRuntimeMeshLODAsync, const bool, bValid,
 DECLARE_DYNAMIC_DELEGATE_OneParam(FglTFRuntimeTextureCubeAsync, UTextureCube*, TextureCube);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FglTFRuntimeTexture2DAsync, UTexture2D*, Texture);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FglTFRuntimeTexture2DArrayAsync, UTexture2DArray*, TextureArray);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FglTFRuntimeSkeletalAnimationsAsync, const TArray<UAnimSequence*>&, AnimSequences);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FglTFRuntimeProceduralMeshComponentAsync, UProceduralMeshComponent*, ProceduralMeshComponent);
 
 using FglTFRuntimeStaticMeshContextRef = TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe>;
 using FglTFRuntimeSkeletalMeshContextRef = TSharedRef<FglTFRuntimeSkeletalMeshContext, ESPMode::ThreadSafe>;
 using FglTFRuntimePoseTracksMap = TMap<FString, FRawAnimSequenceTrack>;
 
+// animation tracks keyed by skeleton bone index (structure of arrays, one entry for each track)
+struct FglTFRuntimeBoneTracks
+{
+	TArray<int32> BoneIndices;
+	TArray<FString> Names;
+	TArray<FRawAnimSequenceTrack> Tracks;
+
+	// track index of each bone of the skeleton (INDEX_NONE if the bone has no track)
+	TArray<int32> BoneToTrack;
+	// tracks not mapped to a bone (unknown skeleton or missing bone) are keyed by name
+	TMap<FString, int32> UnmappedTracks;
+
+	int32 Num() const
+	{
+		return Tracks.Num();
+	}
+
+	int32 Find(const int32 BoneIndex, const FString& Name) const
+	{
+		if (BoneIndex > INDEX_NONE)
+		{
+			return BoneToTrack.IsValidIndex(BoneIndex) ? BoneToTrack[BoneIndex] : INDEX_NONE;
+		}
+
+		const int32* TrackIndex = UnmappedTracks.Find(Name);
+		return TrackIndex ? *TrackIndex : INDEX_NONE;
+	}
+
+	int32 FindOrAdd(const int32 BoneIndex, const FString& Name)
+	{
+		const int32 FoundTrackIndex = Find(BoneIndex, Name);
+		if (FoundTrackIndex > INDEX_NONE)
+		{
+			return FoundTrackIndex;
+		}
+
+		const int32 TrackIndex = Tracks.AddDefaulted();
+		BoneIndices.Add(BoneIndex);
+		Names.Add(Name);
+
+		if (BoneIndex > INDEX_NONE)
+		{
+			while (BoneToTrack.Num() <= BoneIndex)
+			{
+				BoneToTrack.Add(INDEX_NONE);
+			}
+			BoneToTrack[BoneIndex] = TrackIndex;
+		}
+		else
+		{
+			UnmappedTracks.Add(Name, TrackIndex);
+		}
+
+		return TrackIndex;
+	}
+
+	FglTFRuntimePoseTracksMap ToTracksMap() const
+	{
+		FglTFRuntimePoseTracksMap TracksMap;
+		for (int32 TrackIndex = 0; TrackIndex < Tracks.Num(); TrackIndex++)
+		{
+			TracksMap.Add(Names[TrackIndex], Tracks[TrackIndex]);
+		}
+		return TracksMap;
+	}
+};
+
+// a decoded (and resampled) skeletal animation, ready to be turned into an UAnimSequence
+struct FglTFRuntimeSkeletalAnimationClip
+{
+	int32 AnimationIndex = INDEX_NONE;
+	bool bValid = false;
+	float Duration = 0;
+	FglTFRuntimeBoneTracks Tracks;
+	TMap<FName, TArray<TPair<float, float>>> MorphTargetCurves;
+};
+
+// glTF node to track name/bone index resolution, shared by all of the clips loaded for the same skeleton
+struct FglTFRuntimeAnimationBoneMap
+{
+	const FReferenceSkeleton* RefSkeleton = nullptr;
+
+	// per node (SoA), filled on first use
+	TArray<FString> NodeTrackNames;
+	TArray<int32> NodeBoneIndices;
+	TBitArray<> NodeResolved;
+	TBitArray<> NodeDiscarded;
+
+	FglTFRuntimeAnimationBoneMap() = default;
+
+	FglTFRuntimeAnimationBoneMap(const FReferenceSkeleton* InRefSkeleton) : RefSkeleton(InRefSkeleton)
+	{
+	}
+
+	void Init(const int32 NodesNum)
+	{
+		NodeTrackNames.SetNum(NodesNum);
+		NodeBoneIndices.Init(INDEX_NONE, NodesNum);
+		NodeResolved.Init(false, NodesNum);
+		NodeDiscarded.Init(false, NodesNum);
+	}
+};
+
+// placement of the materials packed in a textures atlas (an empty layout marks a group that cannot be atlased)
+struct FglTFRuntimeAtlasLayout
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	FString MaterialName;
+	// pixels region of each material inside the atlas
+	TMap<int64, FIntRect> Regions;
+};
+
 #if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
 DECLARE_TS_MULTICAST_DELEGATE_ThreeParams(FglTFRuntimeOnPreLoadedPrimitive, TSharedRef<FglTFRuntimeParser>, TSharedRef<FJsonObject>, FglTFRuntimePrimitive&);
 DECLARE_TS_MULTICAST_DELEGATE_ThreeParams(FglTFRuntimeOnLoadedPrimitive, TSharedRef<FglTFRuntimeParser>, TSharedRef<FJsonObject>, FglTFRuntimePrimitive&);
@@ -2351,11 +3067,16 @@ public:
 	static TSharedPtr<FglTFRuntimeParser> FromFilename(const FString& Filename, const FglTFRuntimeConfig& LoaderConfig);
 	static TSharedPtr<FglTFRuntimeParser> FromBinary(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive = nullptr);
 	static TSharedPtr<FglTFRuntimeParser> FromString(const FString& JsonData, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive = nullptr);
+	static TSharedPtr<FglTFRuntimeParser> FromUTF8(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive = nullptr);
+	static TSharedPtr<FglTFRuntimeParser> FromJsonObject(TSharedRef<FJsonObject> JsonObject, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive = nullptr);
 	static TSharedPtr<FglTFRuntimeParser> FromData(const uint8* DataPtr, int64 DataNum, const FglTFRuntimeConfig& LoaderConfig);
 	static TSharedPtr<FglTFRuntimeParser> FromMap(const TMap<FString, TArray64<uint8>> Map, const FglTFRuntimeConfig& LoaderConfig);
 
 	static TSharedPtr<FglTFRuntimeParser> FromRawDataAndArchive(const uint8* DataPtr, int64 DataNum, TSharedPtr<FglTFRuntimeArchive> InArchive, const FglTFRuntimeConfig& LoaderConfig);
 
+	// fast UTF-8 JSON parsing (returns nullptr on invalid/unsupported data)
+	static TSharedPtr<FJsonObject> ParseJsonUTF8(const uint8* DataPtr, const int64 DataNum);
+
 	static FORCEINLINE TSharedPtr<FglTFRuntimeParser> FromBinary(const TArray<uint8> Data, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive = nullptr) { return FromBinary(Data.GetData(), Data.Num(), LoaderConfig, InArchive); }
 	static FORCEINLINE TSharedPtr<FglTFRuntimeParser> FromBinary(const TArray64<uint8> Data, const FglTFRuntimeConfig& LoaderConfig, TSharedPtr<FglTFRuntimeArchive> InArchive = nullptr) { return FromBinary(Data.GetData(), Data.Num(), LoaderConfig, InArchive); }
 	static FORCEINLINE TSharedPtr<FglTFRuntimeParser> FromData(const TArray<uint8> Data, const FglTFRuntimeConfig& LoaderConfig) { return FromData(Data.GetData(), Data.Num(), LoaderConfig); }
@@ -2407,6 +3128,16 @@ public:
 
 	UAnimSequence* LoadAndMergeSkeletalAnimations(USkeletalMesh* SkeletalMesh, const TArray<int32> AnimationIndices, const bool bRandomize, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
 
+	// batch loading: clips are decoded in parallel, then all of the UAnimSequences are created in a single game thread step (an empty AnimationIndices array means all of the animations)
+	TArray<UAnimSequence*> LoadSkeletalAnimations(USkeletalMesh* SkeletalMesh, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	void LoadSkeletalAnimationsAsync(USkeletalMesh* SkeletalMesh, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationsAsync& AsyncCallback, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	bool LoadSkeletalAnimationClips(const FReferenceSkeleton& RefSkeleton, const TArray<int32>& AnimationIndices, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TArray<FglTFRuntimeSkeletalAnimationClip>& Clips);
+	TArray<UAnimSequence*> CreateSkeletalAnimationsFromClips(USkeletalMesh* SkeletalMesh, TArray<FglTFRuntimeSkeletalAnimationClip>& Clips, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+
+	// vertex animation textures: BakeVertexAnimation only does the CPU work (skinning of the selected animations), LoadVertexAnimation builds the assets
+	bool BakeVertexAnimation(const int32 MeshIndex, const int32 SkinIndex, const TArray<int32>& AnimationIndices, const FglTFRuntimeVertexAnimationConfig& VertexAnimationConfig, FglTFRuntimeVertexAnimationData& VertexAnimationData);
+	bool LoadVertexAnimation(const int32 MeshIndex, const int32 SkinIndex, const TArray<int32>& AnimationIndices, const FglTFRuntimeVertexAnimationConfig& VertexAnimationConfig, FglTFRuntimeVertexAnimation& VertexAnimation);
+
 	UAnimSequence* LoadAndMergeSkeletalAnimationsByName(USkeletalMesh* SkeletalMesh, const TArray<FString> AnimationNames, const bool bIgnoreNonExistent, const bool bRandomize, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
 
 	int32 GetAnimationIndexByName(const FString& AnimationName, const bool bCaseSensitive) const;
@@ -2418,6 +3149,7 @@ public:
 	bool LoadAnimationByNameAsTracksAndMorphTargets(const FString& AnimationName, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, const bool bCaseSensitive);
 
 	bool SanitizeBoneTrack(const FReferenceSkeleton& RefSkeleton, const FString& BoneName, const int32 NumFrames, FRawAnimSequenceTrack& Track, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	bool SanitizeBoneTrack(const FReferenceSkeleton& RefSkeleton, const int32 BoneIndex, const int32 NumFrames, FRawAnimSequenceTrack& Track, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
 
 	FglTFRuntimePoseTracksMap FixupAnimationTracks(const FglTFRuntimePoseTracksMap& Tracks, const TMap<FString, FTransform>& RestTransforms, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
 
@@ -2438,6 +3170,7 @@ public:
 
 	bool GetBuffer(const int32 BufferIndex, FglTFRuntimeBlob& Blob);
 	bool GetBufferView(const int32 BufferViewIndex, FglTFRuntimeBlob& Blob, int64& Stride);
+	bool BuildSkinWeightsFromAccessorField(TSharedRef<FJsonObject> JsonObject, const FString& Name, TArray<FglTFRuntimeUInt16Vector4>& Weights, const int64 AdditionalBufferView, int64* ComponentTypePtr);
 	bool GetAccessor(const int32 AccessorIndex, int64& ComponentType, int64& Stride, int64& Elements, int64& ElementSize, int64& Count, bool& bNormalized, FglTFRuntimeBlob& Blob, const FglTFRuntimeBlob* AdditionalBufferView);
 
 	bool GetAllNodes(TArray<FglTFRuntimeNode>& Nodes);
@@ -2490,11 +3223,16 @@ public:
 	}
 
 	bool LoadStaticMeshIntoProceduralMeshComponent(const int32 MeshIndex, UProceduralMeshComponent* ProceduralMeshComponent, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig);
+	void LoadStaticMeshIntoProceduralMeshComponentAsync(const int32 MeshIndex, UProceduralMeshComponent* ProceduralMeshComponent, const FglTFRuntimeProceduralMeshComponentAsync& AsyncCallback, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig);
+	bool LoadMeshIntoProceduralMeshSections(const int32 MeshIndex, TArray<FProcMeshSection>& Sections, TArray<UMaterialInterface*>& SectionsMaterials, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig);
+	void CommitProceduralMeshSections(UProceduralMeshComponent* ProceduralMeshComponent, TArray<FProcMeshSection>& Sections, const TArray<UMaterialInterface*>& SectionsMaterials, const FglTFRuntimeProceduralMeshConfig& ProceduralMeshConfig);
 
 	USkeletalMesh* FinalizeSkeletalMeshWithLODs(TSharedRef<FglTFRuntimeSkeletalMeshContext, ESPMode::ThreadSafe> SkeletalMeshContext);
 
 	UStaticMesh* FinalizeStaticMesh(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
 
+	void BuildStaticMeshConvexDecomposition(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
+
 	static TSharedPtr<FJsonValue> GetJSONObjectFromRelativePath(TSharedRef<FJsonObject> JsonObject, const TArray<FglTFRuntimePathItem>& Path);
 	TSharedPtr<FJsonValue> GetJSONObjectFromPath(const TArray<FglTFRuntimePathItem>& Path) const;
 
@@ -2526,6 +3264,7 @@ public:
 	bool LoadImageBytes(const int32 ImageIndex, TSharedPtr<FJsonObject>& JsonImageObject, TArray64<uint8>& Bytes);
 	bool LoadImage(const int32 ImageIndex, TArray64<uint8>& UncompressedBytes, int32& Width, int32& Height, EPixelFormat& PixelFormat, const FglTFRuntimeImagesConfig& ImagesConfig);
 	bool LoadImageFromBlob(const TArray64<uint8>& Blob, TSharedRef<FJsonObject> JsonImageObject, TArray64<uint8>& UncompressedBytes, int32& Width, int32& Height, EPixelFormat& PixelFormat, const FglTFRuntimeImagesConfig& ImagesConfig);
+	bool LoadImageFromBlobCached(const int32 ImageIndex, const TArray64<uint8>& Blob, TSharedRef<FJsonObject> JsonImageObject, TArray64<uint8>& UncompressedBytes, int32& Width, int32& Height, EPixelFormat& PixelFormat, const FglTFRuntimeImagesConfig& ImagesConfig);
 	UTexture2D* BuildTexture(UObject* Outer, const TArray<FglTFRuntimeMipMap>& Mips, const FglTFRuntimeImagesConfig& ImagesConfig, const FglTFRuntimeTextureSampler& Sampler);
 	UTextureCube* BuildTextureCube(UObject* Outer, const TArray<FglTFRuntimeMipMap>& MipsXP, const TArray<FglTFRuntimeMipMap>& MipsXN, const TArray<FglTFRuntimeMipMap>& MipsYP, const TArray<FglTFRuntimeMipMap>& MipsYN, const TArray<FglTFRuntimeMipMap>& MipsZP, const TArray<FglTFRuntimeMipMap>& MipsZN, const bool bAutoRotate, const FglTFRuntimeImagesConfig& ImagesConfig, const FglTFRuntimeTextureSampler& Sampler);
 	UTexture2DArray* BuildTextureArray(UObject* Outer, const TArray<FglTFRuntimeMipMap>& Mips, const FglTFRuntimeImagesConfig& ImagesConfig, const FglTFRuntimeTextureSampler& Sampler);
@@ -2554,6 +3293,13 @@ public:
 
 	TArray<TSharedRef<FJsonObject>> GetAnimations() const;
 
+	// decoders of compressed primitives (their output depends only on the asset data, so unlike
+	// the other primitive hooks they do not disable the derived data cache)
+	static FglTFRuntimeOnPreLoadedPrimitive OnDecodePrimitive;
+	// extensions (like KHR_draco_mesh_compression) that a registered decoder is able to process
+	static void RegisterDecodableExtension(const FString& Extension);
+	static void UnregisterDecodableExtension(const FString& Extension);
+	static bool CanDecodeExtension(const FString& Extension);
 	static FglTFRuntimeOnLoadedPrimitive OnPreLoadedPrimitive;
 	static FglTFRuntimeOnLoadedPrimitive OnLoadedPrimitive;
 	static FglTFRuntimeOnLoadedRefSkeleton OnLoadedRefSkeleton;
@@ -2578,13 +3324,7 @@ public:
 		TArray64<uint8> NewArray;
 		NewArray.Append(reinterpret_cast<const uint8*>(Data), Num);
 
-		int32 NewIndex = AdditionalBufferViewsData.Add(MoveTemp(NewArray));
-
-		FglTFRuntimeBlob Blob;
-		Blob.Data = AdditionalBufferViewsData[NewIndex].GetData();
-		Blob.Num = Num;
-
-		AddAdditionalBufferView(Index, Name, Blob);
+		AddAdditionalBufferViewData(Index, Name, MoveTemp(NewArray));
 	}
 
 	template<typename T>
@@ -2593,6 +3333,21 @@ public:
 		AddAdditionalBufferViewData(Index, Name, Array.GetData(), Array.Num() * Array.GetTypeSize());
 	}
 
+	// takes ownership of the data (no copies)
+	void AddAdditionalBufferViewData(const int64 Index, const FString& Name, TArray64<uint8>&& Data)
+	{
+		FglTFRuntimeBlob Blob;
+		Blob.Num = Data.Num();
+
+		{
+			// the moved heap allocation stays valid even when the array of arrays is reallocated
+			FWriteScopeLock Lock(AdditionalBufferViewsLock);
+			Blob.Data = AdditionalBufferViewsData.Add_GetRef(MoveTemp(Data)).GetData();
+		}
+
+		AddAdditionalBufferView(Index, Name, Blob);
+	}
+
 
 	template<typename Callback, typename... Args>
 	void ForEachJsonField(TSharedRef<FJsonObject> JsonObject, Callback InCallback, Args... InArgs)
@@ -2639,6 +3394,12 @@ public:
 	void ClearCache();
 
 	void MergePrimitivesByMaterial(TArray<FglTFRuntimePrimitive>& Primitives);
+	bool AtlasPrimitivesTextures(TArray<FglTFRuntimePrimitive>& Primitives, const int32 FirstPrimitive, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	bool IsAtlasMaterialCandidate(const int64 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, FString& MaterialName);
+
+	static bool SimplifyPrimitive(const FglTFRuntimePrimitive& Primitive, const float TrianglesRatio, FglTFRuntimePrimitive& SimplifiedPrimitive);
+	void OptimizePrimitive(FglTFRuntimePrimitive& Primitive);
+	void WeldPrimitiveVertices(FglTFRuntimePrimitive& Primitive, const float PositionsEpsilon, const float NormalsEpsilon, const float UVsEpsilon, const float ColorsEpsilon);
 
 	bool MeshHasMorphTargets(const int32 MeshIndex) const;
 
@@ -2657,40 +3418,84 @@ protected:
 	TMap<int32, TObjectPtr<USkeleton>> SkeletonsCache;
 	TMap<int32, TObjectPtr<USkeletalMesh>> SkeletalMeshesCache;
 	TMap<int32, TObjectPtr<UTexture2D>> TexturesCache;
+	TMap<FString, TObjectPtr<UMaterialInterface>> CanonicalMaterialsCache;
+	TMap<FString, TObjectPtr<UMaterialInterface>> AtlasMaterialsCache;
+	TMap<FString, TObjectPtr<UTexture2D>> AtlasTexturesCache;
 #else
 	TMap<int32, UStaticMesh*> StaticMeshesCache;
 	TMap<int32, UMaterialInterface*> MaterialsCache;
 	TMap<int32, USkeleton*> SkeletonsCache;
 	TMap<int32, USkeletalMesh*> SkeletalMeshesCache;
 	TMap<int32, UTexture2D*> TexturesCache;
+	TMap<FString, UMaterialInterface*> CanonicalMaterialsCache;
+	TMap<FString, UMaterialInterface*> AtlasMaterialsCache;
+	TMap<FString, UTexture2D*> AtlasTexturesCache;
 #endif
 
 	TMap<int32, TArray64<uint8>> BuffersCache;
 	TMap<int32, TArray64<uint8>> CompressedBufferViewsCache;
 	TMap<int32, int64> CompressedBufferViewsStridesCache;
 
-#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
-	TMap<TObjectPtr<UMaterialInterface>, FString> MaterialsNameCache;
-#else
-	TMap<UMaterialInterface*, FString> MaterialsNameCache;
-#endif
+	// the glTF name of each cached material (deduplicated materials are shared by differently named glTF materials)
+	TMap<int32, FString> MaterialsNameCache;
+
+	// atlases are keyed by the materials group, the atlased materials and the materials config
+	TMap<FString, FglTFRuntimeAtlasLayout> AtlasLayoutsCache;
 
 	TArray<FglTFRuntimeNode> AllNodesCache;
 	bool bAllNodesCached;
 
-	TMap<TSharedRef<FJsonObject>, FglTFRuntimeMeshLOD> LODsCache;
+	// flattened scene graph (one entry per node of AllNodesCache), rebuilt whenever the hierarchy changes
+	TArray<int32> SceneGraphParents;
+	TArray<int32> SceneGraphDepths;
+	TArray<int32> SceneGraphTopRoots;
+	TArray<int32> SceneGraphTourBegin;
+	TArray<int32> SceneGraphTourEnd;
+	TArray<FTransform> SceneGraphLocalTransforms;
+	TArray<FTransform> SceneGraphWorldTransforms;
+
+	void BuildSceneGraph();
+	bool SceneGraphIsAncestor(const int32 AncestorIndex, const int32 NodeIndex) const;
+
+	// immutable after construction, safe to read from any thread
+	TArray<FglTFRuntimeBufferViewDesc> BufferViewsDescs;
+	TArray<FglTFRuntimeAccessorDesc> AccessorsDescs;
+	TArray<FglTFRuntimeNodeDesc> NodesDescs;
+	TArray<int32> NodesChildrenTable;
+
+	void BuildDescTables();
+
+	// LODs are heap allocated, so the pointers returned by LoadMeshIntoMeshLOD survive concurrent insertions
+	// (the key includes the materials config as it drives the primitives processing)
+	TMap<TPair<TSharedRef<FJsonObject>, FString>, TSharedPtr<FglTFRuntimeMeshLOD>> LODsCache;
 
 	TArray64<uint8> BinaryBuffer;
 
 	bool LoadMeshIntoMeshLOD(TSharedRef<FJsonObject> JsonMeshObject, FglTFRuntimeMeshLOD*& LOD, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
 
 	UStaticMesh* LoadStaticMesh_Internal(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
+	bool GenerateStaticMeshAutoLODs(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
+	UStaticMesh* LoadStaticMeshFromDerivedData_Internal(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext, const FglTFRuntimeStaticMeshDerivedData& DerivedData);
+	FString GetStaticMeshDerivedDataCacheFilename(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
+	UStaticMesh* LoadStaticMeshFromDerivedDataCache(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
+	void WriteStaticMeshToDerivedDataCache(TSharedRef<FglTFRuntimeStaticMeshContext, ESPMode::ThreadSafe> StaticMeshContext);
+	FString GetBufferViewContentKey(const int32 BufferViewIndex);
+	FString GetTextureContentKey(const int32 TextureIndex);
+	FString GetMaterialContentKey(const int32 MaterialIndex);
+	FString GetSharedStaticMeshKey(TSharedRef<FJsonObject> JsonMeshObject, const FglTFRuntimeStaticMeshConfig& StaticMeshConfig);
+	FString GetMaterialsConfigKey(const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	FString GetStaticMeshConfigKey(const FglTFRuntimeStaticMeshConfig& StaticMeshConfig);
+	FString GetSharedMaterialKey(const int32 MaterialIndex, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors, UMaterialInterface* ForceBaseMaterial);
+	FString GetCanonicalMaterialKey(const int32 MaterialIndex, const FString& MaterialName, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors, UMaterialInterface* ForceBaseMaterial);
+	FString GetSharedTextureKey(const int32 TextureIndex, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
 	UMaterialInterface* LoadMaterial_Internal(const int32 Index, const FString& MaterialName, TSharedRef<FJsonObject> JsonMaterialObject, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const bool bUseVertexColors, UMaterialInterface* ForceBaseMaterial);
-	bool LoadNode_Internal(int32 Index, TSharedRef<FJsonObject> JsonNodeObject, int32 NodesCount, FglTFRuntimeNode& Node);
+	bool LoadNode_Internal(int32 Index, const FglTFRuntimeNodeDesc& NodeDesc, FglTFRuntimeNode& Node);
 
-	bool LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, TMap<FString, FRawAnimSequenceTrack>& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter);
+	bool LoadSkeletalAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, FglTFRuntimeBoneTracks& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, float& Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, TFunctionRef<bool(const FglTFRuntimeNode& Node)> Filter, FglTFRuntimeAnimationBoneMap& BoneMap, const TMap<int64, TArray<float>>* SharedTimelines = nullptr);
+	UAnimSequence* LoadSkeletalAnimationFromBoneTracks(USkeleton* Skeleton, FglTFRuntimeBoneTracks& Tracks, TMap<FName, TArray<TPair<float, float>>>& MorphTargetCurves, const float Duration, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig);
+	bool ResolveAnimationTrack(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeSkeletalAnimationConfig& SkeletalAnimationConfig, FglTFRuntimeAnimationBoneMap& BoneMap, FString& TrackName, int32& BoneIndex);
 
-	bool LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension);
+	bool LoadAnimation_Internal(TSharedRef<FJsonObject> JsonAnimationObject, float& Duration, FString& Name, TFunctionRef<void(const FglTFRuntimeNode& Node, const FString& Path, const FglTFRuntimeAnimationCurve& Curve)> Callback, TFunctionRef<bool(const FglTFRuntimeNode& Node)> NodeFilter, const TArray<FglTFRuntimePathItem>& OverrideTrackNameFromExtension, const TMap<int64, TArray<float>>* SharedTimelines = nullptr);
 
 	USkeletalMesh* CreateSkeletalMeshFromLODs(TSharedRef<FglTFRuntimeSkeletalMeshContext, ESPMode::ThreadSafe> SkeletalMeshContext);
 
@@ -2767,6 +3572,8 @@ protected:
 	bool CanWriteToCache(const EglTFRuntimeCacheMode CacheMode) { return CacheMode == EglTFRuntimeCacheMode::Write || CacheMode == EglTFRuntimeCacheMode::ReadWrite; }
 
 	bool DecompressMeshOptimizer(const FglTFRuntimeBlob& Blob, const int64 Stride, const int64 Elements, const FString& Mode, const FString& Filter, TArray64<uint8>& UncompressedBytes);
+	void DecompressMeshOptimizerBufferViews();
+	bool bMeshoptBufferViewsDecompressed;
 
 	FMatrix SceneBasis;
 	float SceneScale;
@@ -2788,10 +3595,49 @@ protected:
 #endif
 
 	TArray<FString> Errors;
+	// errors can be reported by worker threads (async and batch loaders)
+	FCriticalSection ErrorsLock;
+	// OnError can have blueprint listeners, so the errors reported by worker threads are broadcasted on the game thread
+	TArray<TPair<FString, FString>> PendingErrors;
+	void BroadcastPendingErrors();
 
 	FString BaseDirectory;
 	FString BaseFilename;
 
+	FString DerivedDataCacheDirectory;
+	// hash of the source data, used as the base key for the derived data cache
+	FString DerivedDataCacheSourceHash;
+	// hash of the external buffers (lazily computed, the source data hash covers only the top-level blob)
+	FCriticalSection DerivedDataCacheBuffersLock;
+	FString DerivedDataCacheBuffersHash;
+	bool bDerivedDataCacheBuffersHashed = false;
+	bool bDerivedDataCacheBuffersValid = false;
+	bool GetDerivedDataCacheBuffersHash(FString& BuffersHash);
+
+	bool bShareAssets;
+	FCriticalSection SharedAssetsKeysLock;
+	TMap<FString, FString> SharedAssetsContentKeysCache;
+	TMap<int32, FString> SharedTexturesPendingKeys;
+
+	// images referenced by multiple texture slots of the materials being loaded are decoded only once and
+	// released as soon as the last material referencing them has been loaded
+	FCriticalSection DecodedImagesCacheLock;
+	TMap<int32, TSharedPtr<const FglTFRuntimeDecodedImage>> DecodedImagesCache;
+	TMap<int32, int32> ImagesRemainingReferences;
+	// textures sharing the same image, sampler and color space map to the first loaded one
+	TMap<FString, int32> TexturesVariantsCache;
+
+	void AcquireMaterialImagesReferences(TSharedRef<FJsonObject> JsonMaterialObject, TArray<int32>& ImagesIndices);
+	void ReleaseMaterialImagesReferences(const TArray<int32>& ImagesIndices);
+
+	static FCriticalSection SharedAssetsLock;
+	static TMap<FString, TWeakObjectPtr<UObject>> SharedAssets;
+
+	// shared static meshes whose collision is still cooking, with the components using them
+	static TMap<TWeakObjectPtr<UStaticMesh>, TArray<TWeakObjectPtr<UStaticMeshComponent>>> SharedStaticMeshesCookingComponents;
+	static void AddSharedStaticMeshCooking(UStaticMesh* StaticMesh);
+	static TArray<TWeakObjectPtr<UStaticMeshComponent>> PopSharedStaticMeshCookingComponents(UStaticMesh* StaticMesh);
+
 	TArray64<uint8> AsBlob;
 
 public:
@@ -3075,12 +3921,36 @@ protected:
 	FVector ComputeTangentY(const FVector Normal, const FVector TangetX);
 	FVector ComputeTangentYWithW(const FVector Normal, const FVector TangetX, const float W);
 
-	TArray64<uint8> ZeroBuffer;
+	// zero blocks are never resized (a bigger one is appended) as blobs could still point to the older ones
+	TArray<TArray64<uint8>> ZeroBuffers;
 	TMap<int32, TArray64<uint8>> SparseAccessorsCache;
 	TMap<int32, int64> SparseAccessorsStridesCache;
 
-	TMap<int64, TMap<FString, FglTFRuntimeBlob>> AdditionalBufferViewsCache;
+	TMap<int64, TMap<FString, TSharedPtr<FglTFRuntimeBlob>>> AdditionalBufferViewsCache;
 	TArray<TArray64<uint8>> AdditionalBufferViewsData;
+	TArray<TSharedPtr<FglTFRuntimeBlob>> AdditionalBufferViewsRetired;
+	// additional buffer views generated for processed primitives (above any real bufferView index)
+	int64 LastGeneratedAdditionalBufferView = MAX_int32;
+
+	void RemapAdditionalBufferView(FglTFRuntimePrimitive& Primitive, const int32 VerticesNum, const TArray<uint32>& NewToOld);
+
+	/*
+	* Caches shared between concurrent loaders of the same asset.
+	* The RW locks only protect the containers and are never held while loading,
+	* the Populate locks serialize the loading of each kind of entry (so every entry is built at most once).
+	* Locks are always taken in this order: Accessors -> BufferViews -> Buffers.
+	* UObject caches (textures and materials) are published with "first one wins" semantics
+	* as their loading may need to wait for the game thread.
+	*/
+	mutable FRWLock BuffersCacheLock;
+	FCriticalSection BuffersPopulateLock;
+	mutable FRWLock BufferViewsCacheLock;
+	FCriticalSection BufferViewsPopulateLock;
+	mutable FRWLock AccessorsCacheLock;
+	FCriticalSection AccessorsPopulateLock;
+	mutable FRWLock AdditionalBufferViewsLock;
+	mutable FRWLock LODsCacheLock;
+	mutable FRWLock ObjectsCacheLock;
 
 	FString DefaultPrefixForUnnamedNodes;
 
@@ -3116,9 +3986,21 @@ public:
 
 	void SetBaseDirectory(const FString& NewBaseDirectory) { BaseDirectory = NewBaseDirectory; }
 
+	void SetDerivedDataCache(const FString& Directory, const uint8* SourceDataPtr, const int64 SourceDataNum);
+
+	// process-wide registry of the assets shared between parsers (weak references, entries die with the last user)
+	static UObject* FindSharedAsset(const FString& Key);
+	static void AddSharedAsset(const FString& Key, UObject* Asset);
+
+	// shared static meshes live in the transient package (complex collision requires a per-component Outer, so those are never shared)
+	bool CanShareStaticMesh(const FglTFRuntimeStaticMeshConfig& StaticMeshConfig) const;
+
+	// components receiving a shared static mesh must be registered here for getting their physics state recreated when its async collision cooking is done
+	static void AddSharedStaticMeshComponent(UStaticMeshComponent* StaticMeshComponent);
+
 	bool LoadPathToBlob(const FString& Path, TArray64<uint8>& Blob);
 
-	bool LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJsonObject> JsonTextureObject, TSharedRef<FJsonObject> JsonImageObject, const TArray64<uint8>& Blob, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
+	bool LoadBlobToMips(const int32 TextureIndex, TSharedRef<FJsonObject> JsonTextureObject, TSharedRef<FJsonObject> JsonImageObject, const TArray64<uint8>& Blob, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig, const int32 ImageIndex = INDEX_NONE);
 	bool LoadBlobToMips(const TArray64<uint8>& Blob, TArray<FglTFRuntimeMipMap>& Mips, const bool sRGB, const FglTFRuntimeMaterialsConfig& MaterialsConfig);
 
 	void SetDownloadTime(const float Value);
@@ -0,0 +1,449 @@
+// Copyright 2023, Roberto De Ioris.
+
+#include "glTFRuntimeDracoDecoder.h"
+#include "Async/ParallelFor.h"
+#include "glTFRuntimeParser.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_GLTFRUNTIME_DRACO
+THIRD_PARTY_INCLUDES_START
+#include "draco/compression/decode.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+#define LOCTEXT_NAMESPACE "FglTFRuntimeDracoDecoderModule"
+
+namespace glTFRuntimeDraco
+{
+	// used for marking a Draco bufferView as already processed
+	const FString ProcessedMarker = "KHR_draco_mesh_compression";
+
+	struct FDracoStream
+	{
+		FString Name;
+		// INDEX_NONE for the indices stream
+		int64 UniqueId;
+		int64 ComponentType;
+		int64 Elements;
+		TArray64<uint8> Data;
+	};
+
+	struct FDracoPrimitive
+	{
+		int64 BufferViewIndex;
+		FglTFRuntimeBlob Blob;
+		TArray<FDracoStream> Streams;
+		bool bSuccess;
+	};
+
+	int64 GetComponentTypeSize(const int64 ComponentType)
+	{
+		switch (ComponentType)
+		{
+		case 5120:
+		case 5121:
+			return 1;
+		case 5122:
+		case 5123:
+			return 2;
+		case 5125:
+		case 5126:
+			return 4;
+		default:
+			break;
+		}
+		return 0;
+	}
+
+	int64 GetTypeSize(const FString& Type)
+	{
+		if (Type == "SCALAR")
+			return 1;
+		else if (Type == "VEC2")
+			return 2;
+		else if (Type == "VEC3")
+			return 3;
+		else if (Type == "VEC4" || Type == "MAT2")
+			return 4;
+		else if (Type == "MAT3")
+			return 9;
+		else if (Type == "MAT4")
+			return 16;
+
+		return 0;
+	}
+
+	bool GetAccessorLayout(TSharedRef<FJsonObject> JsonRoot, const int64 AccessorIndex, int64& ComponentType, int64& Elements)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* JsonAccessors;
+		if (!JsonRoot->TryGetArrayField(TEXT("accessors"), JsonAccessors) || AccessorIndex < 0 || AccessorIndex >= JsonAccessors->Num())
+		{
+			return false;
+		}
+
+		const TSharedPtr<FJsonObject>* JsonAccessorObject = nullptr;
+		if (!(*JsonAccessors)[AccessorIndex]->TryGetObject(JsonAccessorObject))
+		{
+			return false;
+		}
+
+		FString Type;
+		if (!(*JsonAccessorObject)->TryGetNumberField(TEXT("componentType"), ComponentType) || !(*JsonAccessorObject)->TryGetStringField(TEXT("type"), Type))
+		{
+			return false;
+		}
+
+		Elements = GetTypeSize(Type);
+
+		return Elements > 0 && GetComponentTypeSize(ComponentType) > 0;
+	}
+
+#if WITH_GLTFRUNTIME_DRACO
+	template<typename T>
+	bool ConvertAttribute(const draco::PointAttribute* Attribute, const int64 PointsNum, const int64 Elements, uint8* Output)
+	{
+		T* Destination = reinterpret_cast<T*>(Output);
+		for (int64 PointIndex = 0; PointIndex < PointsNum; PointIndex++)
+		{
+			const draco::AttributeValueIndex ValueIndex = Attribute->mapped_index(draco::PointIndex(static_cast<uint32>(PointIndex)));
+			if (!Attribute->ConvertValue<T>(ValueIndex, static_cast<int8>(Elements), Destination))
+			{
+				return false;
+			}
+			Destination += Elements;
+		}
+		return true;
+	}
+
+	template<typename T>
+	void ConvertIndices(const draco::Mesh& Mesh, uint8* Output)
+	{
+		T* Destination = reinterpret_cast<T*>(Output);
+		for (uint32 FaceIndex = 0; FaceIndex < Mesh.num_faces(); FaceIndex++)
+		{
+			const draco::Mesh::Face& Face = Mesh.face(draco::FaceIndex(FaceIndex));
+			*Destination++ = static_cast<T>(Face[0].value());
+			*Destination++ = static_cast<T>(Face[1].value());
+			*Destination++ = static_cast<T>(Face[2].value());
+		}
+	}
+
+	// decodes the Draco bitstream directly in the layout expected by the glTF accessors
+	bool DecodePrimitive(FDracoPrimitive& DracoPrimitive)
+	{
+		draco::DecoderBuffer DecoderBuffer;
+		DecoderBuffer.Init(reinterpret_cast<const char*>(DracoPrimitive.Blob.Data), DracoPrimitive.Blob.Num);
+
+		draco::Decoder Decoder;
+		draco::StatusOr<std::unique_ptr<draco::Mesh>> StatusOrMesh = Decoder.DecodeMeshFromBuffer(&DecoderBuffer);
+		if (!StatusOrMesh.ok())
+		{
+			return false;
+		}
+
+		std::unique_ptr<draco::Mesh> Mesh = std::move(StatusOrMesh).value();
+		if (!Mesh)
+		{
+			return false;
+		}
+
+		const int64 PointsNum = Mesh->num_points();
+
+		for (FDracoStream& Stream : DracoPrimitive.Streams)
+		{
+			const int64 ComponentSize = GetComponentTypeSize(Stream.ComponentType);
+
+			if (Stream.UniqueId == INDEX_NONE)
+			{
+				Stream.Data.SetNumUninitialized(static_cast<int64>(Mesh->num_faces()) * 3 * ComponentSize);
+				if (Stream.ComponentType == 5121)
+				{
+					ConvertIndices<uint8>(*Mesh, Stream.Data.GetData());
+				}
+				else if (Stream.ComponentType == 5123)
+				{
+					ConvertIndices<uint16>(*Mesh, Stream.Data.GetData());
+				}
+				else if (Stream.ComponentType == 5125)
+				{
+					ConvertIndices<uint32>(*Mesh, Stream.Data.GetData());
+				}
+				else
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const draco::PointAttribute* Attribute = Mesh->GetAttributeByUniqueId(static_cast<uint32>(Stream.UniqueId));
+			if (!Attribute)
+			{
+				return false;
+			}
+
+			Stream.Data.SetNumUninitialized(PointsNum * Stream.Elements * ComponentSize);
+
+			bool bConverted = false;
+			switch (Stream.ComponentType)
+			{
+			case 5120:
+				bConverted = ConvertAttribute<int8>(Attribute, PointsNum, Stream.Elements, Stream.Data.GetData());
+				break;
+			case 5121:
+				bConverted = ConvertAttribute<uint8>(Attribute, PointsNum, Stream.Elements, Stream.Data.GetData());
+				break;
+			case 5122:
+				bConverted = ConvertAttribute<int16>(Attribute, PointsNum, Stream.Elements, Stream.Data.GetData());
+				break;
+			case 5123:
+				bConverted = ConvertAttribute<uint16>(Attribute, PointsNum, Stream.Elements, Stream.Data.GetData());
+				break;
+			case 5125:
+				bConverted = ConvertAttribute<uint32>(Attribute, PointsNum, Stream.Elements, Stream.Data.GetData());
+				break;
+			case 5126:
+				bConverted = ConvertAttribute<float>(Attribute, PointsNum, Stream.Elements, Stream.Data.GetData());
+				break;
+			default:
+				break;
+			}
+
+			if (!bConverted)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	* Gathers every not yet processed Draco primitive of the asset (from all of the meshes)
+	* and decodes them in parallel, registering the results as additional bufferViews.
+	*/
+	void DecodeAllPrimitives(TSharedRef<FglTFRuntimeParser> Parser)
+	{
+		SCOPED_NAMED_EVENT(FglTFRuntimeDracoDecoder_DecodeAllPrimitives, FColor::Magenta);
+
+		TSharedPtr<FJsonObject> JsonRoot = Parser->GetJsonRoot();
+		if (!JsonRoot)
+		{
+			return;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* JsonMeshes;
+		if (!JsonRoot->TryGetArrayField(TEXT("meshes"), JsonMeshes))
+		{
+			return;
+		}
+
+		TArray<FDracoPrimitive> DracoPrimitives;
+		TSet<int64> BufferViews;
+
+		for (const TSharedPtr<FJsonValue>& JsonMesh : *JsonMeshes)
+		{
+			const TSharedPtr<FJsonObject>* JsonMeshObject = nullptr;
+			if (!JsonMesh->TryGetObject(JsonMeshObject))
+			{
+				continue;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* JsonPrimitives;
+			if (!(*JsonMeshObject)->TryGetArrayField(TEXT("primitives"), JsonPrimitives))
+			{
+				continue;
+			}
+
+			for (const TSharedPtr<FJsonValue>& JsonPrimitive : *JsonPrimitives)
+			{
+				const TSharedPtr<FJsonObject>* JsonPrimitiveObject = nullptr;
+				if (!JsonPrimitive->TryGetObject(JsonPrimitiveObject))
+				{
+					continue;
+				}
+
+				TSharedPtr<FJsonObject> JsonDracoObject = Parser->GetJsonObjectExtension(JsonPrimitiveObject->ToSharedRef(), "KHR_draco_mesh_compression");
+				if (!JsonDracoObject)
+				{
+					continue;
+				}
+
+				int64 BufferViewIndex;
+				if (!JsonDracoObject->TryGetNumberField(TEXT("bufferView"), BufferViewIndex) || BufferViews.Contains(BufferViewIndex) || Parser->GetAdditionalBufferView(BufferViewIndex, ProcessedMarker))
+				{
+					continue;
+				}
+
+				BufferViews.Add(BufferViewIndex);
+
+				FDracoPrimitive& DracoPrimitive = DracoPrimitives.AddDefaulted_GetRef();
+				DracoPrimitive.BufferViewIndex = BufferViewIndex;
+				DracoPrimitive.bSuccess = false;
+
+				// bufferViews are resolved on the current thread (they could require I/O or populate the parser caches)
+				int64 Stride = 0;
+				if (!Parser->GetBufferView(BufferViewIndex, DracoPrimitive.Blob, Stride))
+				{
+					continue;
+				}
+
+				const TSharedPtr<FJsonObject>* JsonDracoAttributesObject = nullptr;
+				const TSharedPtr<FJsonObject>* JsonAttributesObject = nullptr;
+				if (!JsonDracoObject->TryGetObjectField(TEXT("attributes"), JsonDracoAttributesObject) || !(*JsonPrimitiveObject)->TryGetObjectField(TEXT("attributes"), JsonAttributesObject))
+				{
+					continue;
+				}
+
+				bool bValidLayout = true;
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*JsonDracoAttributesObject)->Values)
+				{
+					FDracoStream Stream;
+					Stream.Name = Pair.Key;
+					int64 AccessorIndex;
+					if (!Pair.Value->TryGetNumber(Stream.UniqueId) || !(*JsonAttributesObject)->TryGetNumberField(Pair.Key, AccessorIndex) ||
+						!GetAccessorLayout(JsonRoot.ToSharedRef(), AccessorIndex, Stream.ComponentType, Stream.Elements))
+					{
+						bValidLayout = false;
+						break;
+					}
+					DracoPrimitive.Streams.Add(MoveTemp(Stream));
+				}
+
+				int64 IndicesAccessorIndex;
+				if (bValidLayout && (*JsonPrimitiveObject)->TryGetNumberField(TEXT("indices"), IndicesAccessorIndex))
+				{
+					FDracoStream Stream;
+					Stream.Name = "indices";
+					Stream.UniqueId = INDEX_NONE;
+					bValidLayout = GetAccessorLayout(JsonRoot.ToSharedRef(), IndicesAccessorIndex, Stream.ComponentType, Stream.Elements);
+					DracoPrimitive.Streams.Add(MoveTemp(Stream));
+				}
+
+				// mark it as ready for decoding
+				DracoPrimitive.bSuccess = bValidLayout;
+			}
+		}
+
+		ParallelFor(DracoPrimitives.Num(), [&](const int32 DracoPrimitiveIndex)
+			{
+				FDracoPrimitive& DracoPrimitive = DracoPrimitives[DracoPrimitiveIndex];
+				if (DracoPrimitive.bSuccess)
+				{
+					DracoPrimitive.bSuccess = DecodePrimitive(DracoPrimitive);
+				}
+			});
+
+		for (FDracoPrimitive& DracoPrimitive : DracoPrimitives)
+		{
+			if (DracoPrimitive.bSuccess)
+			{
+				for (FDracoStream& Stream : DracoPrimitive.Streams)
+				{
+					Parser->AddAdditionalBufferViewData(DracoPrimitive.BufferViewIndex, Stream.Name, MoveTemp(Stream.Data));
+				}
+			}
+			else
+			{
+				UE_LOG(LogGLTFRuntime, Error, TEXT("Unable to decode Draco bufferView %lld"), DracoPrimitive.BufferViewIndex);
+			}
+
+			Parser->AddAdditionalBufferView(DracoPrimitive.BufferViewIndex, ProcessedMarker, FglTFRuntimeBlob());
+		}
+	}
+
+	// the primitives of a parser are decoded only once, but different parsers can decode in parallel
+	FCriticalSection ParsersDecodeLocksLock;
+	TMap<const FglTFRuntimeParser*, TPair<TWeakPtr<FglTFRuntimeParser>, TSharedRef<FCriticalSection, ESPMode::ThreadSafe>>> ParsersDecodeLocks;
+
+	TSharedRef<FCriticalSection, ESPMode::ThreadSafe> GetParserDecodeLock(TSharedRef<FglTFRuntimeParser> Parser)
+	{
+		FScopeLock Lock(&ParsersDecodeLocksLock);
+
+		// the address could have been reused by a new parser
+		TPair<TWeakPtr<FglTFRuntimeParser>, TSharedRef<FCriticalSection, ESPMode::ThreadSafe>>* ParserDecodeLock = ParsersDecodeLocks.Find(&Parser.Get());
+		if (ParserDecodeLock && ParserDecodeLock->Key.Pin() == Parser)
+		{
+			return ParserDecodeLock->Value;
+		}
+
+		for (auto It = ParsersDecodeLocks.CreateIterator(); It; ++It)
+		{
+			if (!It->Value.Key.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		TSharedRef<FCriticalSection, ESPMode::ThreadSafe> DecodeLock = MakeShared<FCriticalSection, ESPMode::ThreadSafe>();
+		ParsersDecodeLocks.Add(&Parser.Get(), TPair<TWeakPtr<FglTFRuntimeParser>, TSharedRef<FCriticalSection, ESPMode::ThreadSafe>>(Parser, DecodeLock));
+		return DecodeLock;
+	}
+#endif
+
+	void OnDecodePrimitive(TSharedRef<FglTFRuntimeParser> Parser, TSharedRef<FJsonObject> JsonPrimitiveObject, FglTFRuntimePrimitive& Primitive)
+	{
+		// already managed by another handler
+		if (Primitive.AdditionalBufferView > INDEX_NONE)
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> JsonDracoObject = Parser->GetJsonObjectExtension(JsonPrimitiveObject, "KHR_draco_mesh_compression");
+		if (!JsonDracoObject)
+		{
+			return;
+		}
+
+		int64 BufferViewIndex;
+		if (!JsonDracoObject->TryGetNumberField(TEXT("bufferView"), BufferViewIndex))
+		{
+			return;
+		}
+
+#if WITH_GLTFRUNTIME_DRACO
+		{
+			TSharedRef<FCriticalSection, ESPMode::ThreadSafe> DecodeLock = GetParserDecodeLock(Parser);
+			FScopeLock Lock(&DecodeLock.Get());
+			if (!Parser->GetAdditionalBufferView(BufferViewIndex, ProcessedMarker))
+			{
+				DecodeAllPrimitives(Parser);
+			}
+		}
+
+		if (Parser->GetAdditionalBufferView(BufferViewIndex, "POSITION"))
+		{
+			Primitive.AdditionalBufferView = BufferViewIndex;
+		}
+#else
+		UE_LOG(LogGLTFRuntime, Error, TEXT("KHR_draco_mesh_compression primitive found but glTFRuntimeDracoDecoder has been built without the Draco library"));
+#endif
+	}
+}
+
+bool FglTFRuntimeDracoDecoderModule::CanDecode()
+{
+#if WITH_GLTFRUNTIME_DRACO
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FglTFRuntimeDracoDecoderModule::StartupModule()
+{
+	OnDecodePrimitiveHandle = FglTFRuntimeParser::OnDecodePrimitive.AddStatic(&glTFRuntimeDraco::OnDecodePrimitive);
+	if (CanDecode())
+	{
+		FglTFRuntimeParser::RegisterDecodableExtension(glTFRuntimeDraco::ProcessedMarker);
+	}
+}
+
+void FglTFRuntimeDracoDecoderModule::ShutdownModule()
+{
+	FglTFRuntimeParser::OnDecodePrimitive.Remove(OnDecodePrimitiveHandle);
+	FglTFRuntimeParser::UnregisterDecodableExtension(glTFRuntimeDraco::ProcessedMarker);
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FglTFRuntimeDracoDecoderModule, glTFRuntimeDracoDecoder)
@@ -0,0 +1,21 @@
+// Copyright 2023, Roberto De Ioris.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+class FglTFRuntimeDracoDecoderModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+	/** true when the module has been built with the Draco library (otherwise compressed primitives are skipped) */
+	static bool CanDecode();
+
+private:
+	FDelegateHandle OnDecodePrimitiveHandle;
+};
@@ -0,0 +1,47 @@
+// Copyright 2023, Roberto De Ioris.
+
+using System.IO;
+using UnrealBuildTool;
+
+public class glTFRuntimeDracoDecoder : ModuleRules
+{
+    public glTFRuntimeDracoDecoder(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+        bUseUnity = false;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core"
+            }
+            );
+
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Engine",
+                "Json",
+                "glTFRuntime"
+            }
+            );
+
+        // the Draco decoder (https://github.com/google/draco) is linked statically:
+        // headers are expected in ThirdParty/draco/include and the library in ThirdParty/draco/lib/<Platform>
+        // (the module is not listed in glTFRuntime.uplugin by default, as the library is not distributed with the plugin)
+        string DracoPath = Path.Combine(ModuleDirectory, "ThirdParty", "draco");
+        string DracoLibrary = Path.Combine(DracoPath, "lib", Target.Platform.ToString(), Target.Platform == UnrealTargetPlatform.Win64 ? "draco.lib" : "libdraco.a");
+
+        // a module unable to decode would only hide the missing Draco support
+        if (!File.Exists(DracoLibrary))
+        {
+            throw new BuildException("glTFRuntimeDracoDecoder requires the Draco library in {0}", DracoLibrary);
+        }
+
+        PrivateIncludePaths.Add(Path.Combine(DracoPath, "include"));
+        PublicAdditionalLibraries.Add(DracoLibrary);
+        PrivateDefinitions.Add("WITH_GLTFRUNTIME_DRACO=1");
+    }
+}